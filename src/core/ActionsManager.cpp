@@ -23,6 +23,7 @@
 #include "JsonSettings.h"
 #include "SessionsManager.h"
 #include "ThemesManager.h"
+#include "TraceRecorder.h"
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
@@ -217,6 +218,8 @@ bool KeyboardProfile::isModified() const
 
 bool KeyboardProfile::save()
 {
+	const TraceRecorder::Span span("KeyboardProfile::save");
+
 	JsonSettings settings(SessionsManager::getWritableDataPath(QLatin1String("keyboard/") + m_identifier + QLatin1String(".json")));
 	QString comment;
 	QTextStream stream(&comment);
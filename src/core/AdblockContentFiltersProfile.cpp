@@ -50,6 +50,7 @@ AdblockContentFiltersProfile::AdblockContentFiltersProfile(const QString &name,
 	m_category(category),
 	m_error(NoError),
 	m_flags(flags),
+	m_parsedProfile(-1),
 	m_updateInterval(updateInterval),
 	m_isUpdating(false),
 	m_isEmpty(true),
@@ -70,6 +71,38 @@ AdblockContentFiltersProfile::AdblockContentFiltersProfile(const QString &name,
 	loadHeader();
 }
 
+AdblockContentFiltersProfile::AdblockContentFiltersProfile(const QVector<AdblockContentFiltersProfile*> &profiles, const QVector<int> &identifiers, QObject *parent) : ContentFiltersProfile(parent),
+	m_root(nullptr),
+	m_networkReply(nullptr),
+	m_languages({QLocale::AnyLanguage}),
+	m_sourcesIdentifiers(identifiers),
+	m_category(OtherCategory),
+	m_error(NoError),
+	m_flags(NoFlags),
+	m_parsedProfile(-1),
+	m_updateInterval(0),
+	m_isUpdating(false),
+	m_isEmpty(false),
+	m_wasLoaded(false)
+{
+	QStringList names;
+	names.reserve(profiles.count());
+
+	m_sources.reserve(profiles.count());
+
+	for (int i = 0; i < profiles.count(); ++i)
+	{
+		m_sources.append(profiles.at(i));
+
+		names.append(profiles.at(i)->getName());
+	}
+
+	m_name = names.join(QLatin1Char('+'));
+
+// sets are looked up from the network thread as well, so these are never loaded lazily
+	loadRules();
+}
+
 void AdblockContentFiltersProfile::clear()
 {
 	if (!m_wasLoaded)
@@ -145,6 +178,16 @@ void AdblockContentFiltersProfile::parseRuleLine(const QString &rule)
 		return;
 	}
 
+	if (!m_sources.isEmpty())
+	{
+		if (m_parsedRules.contains(rule))
+		{
+			return;
+		}
+
+		m_parsedRules.insert(rule);
+	}
+
 	if (rule.startsWith(QLatin1String("##")))
 	{
 		if (ContentFiltersManager::getCosmeticFiltersMode() == ContentFiltersManager::AllFilters)
@@ -276,7 +319,10 @@ void AdblockContentFiltersProfile::parseRuleLine(const QString &rule)
 		}
 	}
 
-	addRule(new ContentBlockingRule(rule, blockedDomains, allowedDomains, ruleOptions, ruleMatch, isException, needsDomainCheck), line);
+	ContentBlockingRule *contentBlockingRule(new ContentBlockingRule(rule, blockedDomains, allowedDomains, ruleOptions, ruleMatch, isException, needsDomainCheck));
+	contentBlockingRule->profile = m_parsedProfile;
+
+	addRule(contentBlockingRule, line);
 }
 
 void AdblockContentFiltersProfile::parseStyleSheetRule(const QStringList &line, QMultiHash<QString, QString> &list) const
@@ -558,6 +604,7 @@ ContentFiltersManager::CheckResult AdblockContentFiltersProfile::checkRuleMatch(
 	{
 		ContentFiltersManager::CheckResult result;
 		result.rule = rule->rule;
+		result.profile = rule->profile;
 
 		if (rule->isException)
 		{
@@ -851,20 +898,63 @@ bool AdblockContentFiltersProfile::loadRules()
 		m_domainExpression.optimize();
 	}
 
-	QFile file(getPath());
-	file.open(QIODevice::ReadOnly | QIODevice::Text);
+	m_root = new Node();
 
-	QTextStream stream(&file);
-	stream.readLine(); // header
+	if (m_sources.isEmpty())
+	{
+		QFile file(getPath());
+		file.open(QIODevice::ReadOnly | QIODevice::Text);
 
-	m_root = new Node();
+		QTextStream stream(&file);
+		stream.readLine(); // header
 
-	while (!stream.atEnd())
+		while (!stream.atEnd())
+		{
+			parseRuleLine(stream.readLine());
+		}
+
+		file.close();
+
+		return true;
+	}
+
+	for (int i = 0; i < m_sources.count(); ++i)
 	{
-		parseRuleLine(stream.readLine());
+		AdblockContentFiltersProfile *profile(m_sources.at(i));
+
+		if (!profile)
+		{
+			continue;
+		}
+
+		if (profile->m_isEmpty && !profile->m_updateUrl.isEmpty())
+		{
+			if (!profile->m_isUpdating)
+			{
+				profile->update();
+			}
+
+			continue;
+		}
+
+		QFile file(profile->getPath());
+		file.open(QIODevice::ReadOnly | QIODevice::Text);
+
+		QTextStream stream(&file);
+		stream.readLine(); // header
+
+		m_parsedProfile = m_sourcesIdentifiers.value(i, -1);
+
+		while (!stream.atEnd())
+		{
+			parseRuleLine(stream.readLine());
+		}
+
+		file.close();
 	}
 
-	file.close();
+	m_parsedProfile = -1;
+	m_parsedRules.clear();
 
 	return true;
 }
@@ -24,7 +24,9 @@
 
 #include "ContentFiltersManager.h"
 
+#include <QtCore/QPointer>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QSet>
 
 namespace Otter
 {
@@ -35,6 +37,7 @@ class AdblockContentFiltersProfile final : public ContentFiltersProfile
 
 public:
 	explicit AdblockContentFiltersProfile(const QString &name, const QString &title, const QUrl &updateUrl, const QDateTime &lastUpdate, const QStringList &languages, int updateInterval, const ProfileCategory &category, const ProfileFlags &flags, QObject *parent = nullptr);
+	explicit AdblockContentFiltersProfile(const QVector<AdblockContentFiltersProfile*> &profiles, const QVector<int> &identifiers, QObject *parent = nullptr);
 
 	void clear() override;
 	void setCategory(ProfileCategory category) override;
@@ -99,6 +102,7 @@ protected:
 		QStringList allowedDomains;
 		RuleOptions ruleOptions = NoOption;
 		RuleMatch ruleMatch = ContainsMatch;
+		int profile = -1;
 		bool isException = false;
 		bool needsDomainCheck = false;
 
@@ -142,11 +146,15 @@ private:
 	QRegularExpression m_domainExpression;
 	QStringList m_cosmeticFiltersRules;
 	QVector<QLocale::Language> m_languages;
+	QVector<QPointer<AdblockContentFiltersProfile> > m_sources;
+	QVector<int> m_sourcesIdentifiers;
+	QSet<QString> m_parsedRules;
 	QMultiHash<QString, QString> m_cosmeticFiltersDomainRules;
 	QMultiHash<QString, QString> m_cosmeticFiltersDomainExceptions;
 	ProfileCategory m_category;
 	ProfileError m_error;
 	ProfileFlags m_flags;
+	int m_parsedProfile;
 	int m_updateInterval;
 	bool m_isUpdating;
 	bool m_isEmpty;
@@ -96,7 +96,13 @@ AddonsManager* AddonsManager::m_instance(nullptr);
 QMap<QString, UserScript*> AddonsManager::m_userScripts;
 QMap<QString, WebBackend*> AddonsManager::m_webBackends;
 QMap<QString, AddonsManager::SpecialPageInformation> AddonsManager::m_specialPages;
+QVector<UserScript*> AddonsManager::m_indexedUserScripts;
+QVector<AddonsManager::UserScriptRule> AddonsManager::m_userScriptRules;
+QHash<QString, QVector<int> > AddonsManager::m_userScriptRulesIndex;
+QVector<int> AddonsManager::m_genericUserScriptRules;
+QVector<bool> AddonsManager::m_unrestrictedUserScripts;
 bool AddonsManager::m_areUserScripsInitialized(false);
+bool AddonsManager::m_areUserScriptRulesCompiled(false);
 
 AddonsManager::AddonsManager(QObject *parent) : QObject(parent)
 {
@@ -131,6 +137,7 @@ AddonsManager::AddonsManager(QObject *parent) : QObject(parent)
 	registerSpecialPage(SpecialPageInformation(QT_TRANSLATE_NOOP("addons", "Notes"), {}, QUrl(QLatin1String("about:notes")), ThemesManager::createIcon(QLatin1String("notes"), false), SpecialPageInformation::UniversalType), QLatin1String("notes"));
 	registerSpecialPage(SpecialPageInformation(QT_TRANSLATE_NOOP("addons", "Page Information"), {}, {}, ThemesManager::createIcon(QLatin1String("view-information"), false), SpecialPageInformation::SidebarPanelType), QLatin1String("pageInformation"));
 	registerSpecialPage(SpecialPageInformation(QT_TRANSLATE_NOOP("addons", "Passwords"), {}, QUrl(QLatin1String("about:passwords")), ThemesManager::createIcon(QLatin1String("dialog-password"), false), SpecialPageInformation::UniversalType), QLatin1String("passwords"));
+	registerSpecialPage(SpecialPageInformation(QT_TRANSLATE_NOOP("addons", "Performance"), {}, QUrl(QLatin1String("about:performance")), ThemesManager::createIcon(QLatin1String("task-ongoing"), false), SpecialPageInformation::StandaloneType), QLatin1String("performance"));
 	registerSpecialPage(SpecialPageInformation(QT_TRANSLATE_NOOP("addons", "Preferences"), {}, QUrl(QLatin1String("about:preferences")), ThemesManager::createIcon(QLatin1String("configuration"), false), SpecialPageInformation::StandaloneType), QLatin1String("preferences"));
 	registerSpecialPage(SpecialPageInformation(QT_TRANSLATE_NOOP("addons", "Tab History"), {}, {}, ThemesManager::createIcon(QLatin1String("tab-history"), false), SpecialPageInformation::SidebarPanelType), QLatin1String("tabHistory"));
 	registerSpecialPage(SpecialPageInformation(QT_TRANSLATE_NOOP("addons", "Downloads"), {}, QUrl(QLatin1String("about:transfers")), ThemesManager::createIcon(QLatin1String("transfers"), false), SpecialPageInformation::UniversalType), QLatin1String("transfers"));
@@ -160,6 +167,9 @@ void AddonsManager::loadUserScripts()
 	qDeleteAll(m_userScripts.values());
 
 	m_userScripts.clear();
+	m_indexedUserScripts.clear();
+
+	m_areUserScriptRulesCompiled = false;
 
 	QHash<QString, QJsonObject> metaData;
 	QFile file(SessionsManager::getWritableDataPath(QLatin1String("scripts/scripts.json")));
@@ -193,6 +203,8 @@ void AddonsManager::loadUserScripts()
 
 			connect(script, &UserScript::metaDataChanged, m_instance, [=]()
 			{
+				m_areUserScriptRulesCompiled = false;
+
 				emit m_instance->userScriptModified(script->getName());
 			});
 		}
@@ -205,6 +217,124 @@ void AddonsManager::loadUserScripts()
 	m_areUserScripsInitialized = true;
 }
 
+void AddonsManager::compileUserScriptRules()
+{
+	m_indexedUserScripts = m_userScripts.values().toVector();
+	m_userScriptRules.clear();
+	m_userScriptRulesIndex.clear();
+	m_genericUserScriptRules.clear();
+	m_unrestrictedUserScripts.fill(false, m_indexedUserScripts.count());
+
+	for (int i = 0; i < m_indexedUserScripts.count(); ++i)
+	{
+		const UserScript *script(m_indexedUserScripts.at(i));
+		const QStringList matchRules(script->getMatchRules());
+		const QStringList includeRules(script->getIncludeRules());
+		const QStringList excludeRules(script->getExcludeRules());
+
+		m_unrestrictedUserScripts[i] = (matchRules.isEmpty() && includeRules.isEmpty());
+
+		for (int j = 0; j < matchRules.count(); ++j)
+		{
+			addUserScriptRule(matchRules.at(j), i, true, false);
+		}
+
+		for (int j = 0; j < includeRules.count(); ++j)
+		{
+			addUserScriptRule(includeRules.at(j), i, false, false);
+		}
+
+		for (int j = 0; j < excludeRules.count(); ++j)
+		{
+			addUserScriptRule(excludeRules.at(j), i, false, true);
+		}
+	}
+
+	m_areUserScriptRulesCompiled = true;
+}
+
+void AddonsManager::addUserScriptRule(const QString &rule, int script, bool isMatchRule, bool isExclusion)
+{
+	UserScriptRule compiledRule;
+	compiledRule.script = script;
+	compiledRule.isExclusion = isExclusion;
+
+	QString key;
+
+	const int separatorPosition(rule.indexOf(QLatin1String("://")));
+	const int pathPosition((separatorPosition > 0) ? rule.indexOf(QLatin1Char('/'), (separatorPosition + 3)) : -1);
+
+	if (isMatchRule && pathPosition > 0)
+	{
+		const QString hostAndPath(rule.mid(separatorPosition + 3));
+		const int hostLength(pathPosition - separatorPosition - 3);
+
+		compiledRule.type = UserScriptRule::MatchRule;
+		compiledRule.scheme = rule.left(separatorPosition);
+		compiledRule.host = hostAndPath.left(hostLength).toLower();
+		compiledRule.parts = hostAndPath.mid(hostLength).split(QLatin1Char('*'));
+
+		if (compiledRule.host.startsWith(QLatin1String("*.")))
+		{
+			compiledRule.host = compiledRule.host.mid(2);
+			compiledRule.isSubdomainWildcard = true;
+		}
+
+		if (compiledRule.host != QLatin1String("*"))
+		{
+			key = compiledRule.host;
+		}
+	}
+	else if (rule.length() > 1 && rule.startsWith(QLatin1Char('/')) && rule.endsWith(QLatin1Char('/')))
+	{
+		compiledRule.type = UserScriptRule::RegularExpressionRule;
+		compiledRule.expression = QRegularExpression(rule.mid(1, (rule.length() - 2)));
+
+		if (!compiledRule.expression.isValid())
+		{
+			return;
+		}
+
+		compiledRule.expression.optimize();
+	}
+	else
+	{
+		compiledRule.type = UserScriptRule::GlobRule;
+		compiledRule.hasTopLevelDomain = rule.contains(QLatin1String(".tld"), Qt::CaseInsensitive);
+
+		if (compiledRule.hasTopLevelDomain)
+		{
+			compiledRule.pattern = rule;
+		}
+		else
+		{
+			compiledRule.parts = rule.split(QLatin1Char('*'));
+
+			if (pathPosition > (separatorPosition + 3) && compiledRule.parts.first().length() > pathPosition)
+			{
+				const QString authority(rule.mid((separatorPosition + 3), (pathPosition - separatorPosition - 3)).toLower());
+
+// index is looked up by host only, so rules with user information or port have to be checked against every URL
+				if (!authority.contains(QLatin1Char('@')) && !authority.contains(QLatin1Char(':')))
+				{
+					key = authority;
+				}
+			}
+		}
+	}
+
+	m_userScriptRules.append(compiledRule);
+
+	if (key.isEmpty())
+	{
+		m_genericUserScriptRules.append(m_userScriptRules.count() - 1);
+	}
+	else
+	{
+		m_userScriptRulesIndex[key].append(m_userScriptRules.count() - 1);
+	}
+}
+
 AddonsManager* AddonsManager::getInstance()
 {
 	return m_instance;
@@ -267,6 +397,173 @@ QStringList AddonsManager::getUserScripts()
 	return m_userScripts.keys();
 }
 
+QVector<UserScript*> AddonsManager::getUserScriptsForUrl(const QUrl &url)
+{
+	const QString scheme(url.scheme());
+
+	if (scheme != QLatin1String("http") && scheme != QLatin1String("https") && scheme != QLatin1String("file") && scheme != QLatin1String("ftp") && scheme != QLatin1String("about"))
+	{
+		return {};
+	}
+
+	if (!m_areUserScripsInitialized)
+	{
+		loadUserScripts();
+	}
+
+	if (!m_areUserScriptRulesCompiled)
+	{
+		compileUserScriptRules();
+	}
+
+	enum RuleState
+	{
+		NoState = 0,
+		IncludedState = 1,
+		ExcludedState = 2
+	};
+
+	const QString host(url.host().toLower());
+	QString path(url.toString(QUrl::RemoveScheme | QUrl::RemoveAuthority | QUrl::RemoveFragment));
+
+// bare origin has empty path, but match patterns treat it as root
+	if (!path.startsWith(QLatin1Char('/')))
+	{
+		path.prepend(QLatin1Char('/'));
+	}
+
+	QVector<int> rules(m_genericUserScriptRules);
+	QVector<int> states(m_indexedUserScripts.count(), NoState);
+	int position(host.isEmpty() ? -1 : 0);
+
+	while (position >= 0)
+	{
+		const QHash<QString, QVector<int> >::const_iterator iterator(m_userScriptRulesIndex.constFind(host.mid(position)));
+
+		if (iterator != m_userScriptRulesIndex.constEnd())
+		{
+			rules.append(iterator.value());
+		}
+
+		position = host.indexOf(QLatin1Char('.'), position);
+
+		if (position >= 0)
+		{
+			++position;
+		}
+	}
+
+	for (int i = 0; i < rules.count(); ++i)
+	{
+		const UserScriptRule &rule(m_userScriptRules.at(rules.at(i)));
+		const int state(states.at(rule.script));
+
+		if ((state & ExcludedState) || (!rule.isExclusion && (state & IncludedState)) || !m_indexedUserScripts.at(rule.script)->isEnabled())
+		{
+			continue;
+		}
+
+		if (matchesUserScriptRule(rule, url, path))
+		{
+			states[rule.script] = (state | (rule.isExclusion ? ExcludedState : IncludedState));
+		}
+	}
+
+	QVector<UserScript*> scripts;
+
+	for (int i = 0; i < m_indexedUserScripts.count(); ++i)
+	{
+		if (m_indexedUserScripts.at(i)->isEnabled() && !(states.at(i) & ExcludedState) && (m_unrestrictedUserScripts.at(i) || (states.at(i) & IncludedState)))
+		{
+			scripts.append(m_indexedUserScripts.at(i));
+		}
+	}
+
+	return scripts;
+}
+
+bool AddonsManager::matchesUserScriptRule(const UserScriptRule &rule, const QUrl &url, const QString &path)
+{
+	switch (rule.type)
+	{
+		case UserScriptRule::MatchRule:
+			{
+				const QString scheme(url.scheme());
+
+				if ((rule.scheme == QLatin1String("*")) ? (scheme != QLatin1String("http") && scheme != QLatin1String("https")) : (scheme != rule.scheme))
+				{
+					return false;
+				}
+
+				if (rule.host != QLatin1String("*"))
+				{
+					const QString host(url.host().toLower());
+
+					if (host != rule.host && (!rule.isSubdomainWildcard || !host.endsWith(QLatin1Char('.') + rule.host)))
+					{
+						return false;
+					}
+				}
+
+				return matchesGlob(rule.parts, path);
+			}
+		case UserScriptRule::RegularExpressionRule:
+			return rule.expression.match(url.url()).hasMatch();
+		default:
+			break;
+	}
+
+	if (rule.hasTopLevelDomain)
+	{
+		QString pattern(rule.pattern);
+		pattern.replace(QLatin1String(".tld"), url.topLevelDomain(), Qt::CaseInsensitive);
+
+		return matchesGlob(pattern.split(QLatin1Char('*')), url.url());
+	}
+
+	return matchesGlob(rule.parts, url.url());
+}
+
+bool AddonsManager::matchesGlob(const QStringList &parts, const QString &text)
+{
+	if (parts.count() == 1)
+	{
+		return (text == parts.first());
+	}
+
+	const QString &prefix(parts.first());
+	const QString &suffix(parts.last());
+
+	if (text.length() < (prefix.length() + suffix.length()) || !text.startsWith(prefix) || !text.endsWith(suffix))
+	{
+		return false;
+	}
+
+	const int end(text.length() - suffix.length());
+	int position(prefix.length());
+
+	for (int i = 1; i < (parts.count() - 1); ++i)
+	{
+		const QString &part(parts.at(i));
+
+		if (part.isEmpty())
+		{
+			continue;
+		}
+
+		const int index(text.indexOf(part, position));
+
+		if (index < 0 || (index + part.length()) > end)
+		{
+			return false;
+		}
+
+		position = (index + part.length());
+	}
+
+	return true;
+}
+
 QStringList AddonsManager::getWebBackends()
 {
 	return m_webBackends.keys();
@@ -21,6 +21,8 @@
 #define OTTER_ADDONSMANAGER_H
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QHash>
+#include <QtCore/QRegularExpression>
 #include <QtCore/QUrl>
 #include <QtGui/QIcon>
 
@@ -137,16 +139,49 @@ public:
 	static QStringList getUserScripts();
 	static QStringList getWebBackends();
 	static QStringList getSpecialPages(SpecialPageInformation::PageTypes types = SpecialPageInformation::StandaloneType);
+	static QVector<UserScript*> getUserScriptsForUrl(const QUrl &url);
 
 protected:
+	struct UserScriptRule final
+	{
+		enum RuleType
+		{
+			GlobRule = 0,
+			MatchRule,
+			RegularExpressionRule
+		};
+
+		QRegularExpression expression;
+		QString pattern;
+		QString scheme;
+		QString host;
+		QStringList parts;
+		RuleType type = GlobRule;
+		int script = -1;
+		bool isExclusion = false;
+		bool isSubdomainWildcard = false;
+		bool hasTopLevelDomain = false;
+	};
+
 	explicit AddonsManager(QObject *parent);
 
+	static void compileUserScriptRules();
+	static void addUserScriptRule(const QString &rule, int script, bool isMatchRule, bool isExclusion);
+	static bool matchesUserScriptRule(const UserScriptRule &rule, const QUrl &url, const QString &path);
+	static bool matchesGlob(const QStringList &parts, const QString &text);
+
 private:
 	static AddonsManager *m_instance;
 	static QMap<QString, UserScript*> m_userScripts;
 	static QMap<QString, WebBackend*> m_webBackends;
 	static QMap<QString, SpecialPageInformation> m_specialPages;
+	static QVector<UserScript*> m_indexedUserScripts;
+	static QVector<UserScriptRule> m_userScriptRules;
+	static QHash<QString, QVector<int> > m_userScriptRulesIndex;
+	static QVector<int> m_genericUserScriptRules;
+	static QVector<bool> m_unrestrictedUserScripts;
 	static bool m_areUserScripsInitialized;
+	static bool m_areUserScriptRulesCompiled;
 
 signals:
 	void userScriptModified(const QString &name);
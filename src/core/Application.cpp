@@ -27,6 +27,7 @@
 #include "HandlersManager.h"
 #include "HistoryManager.h"
 #include "LongTermTimer.h"
+#include "MemoryPressureManager.h"
 #include "Migrator.h"
 #include "NetworkManagerFactory.h"
 #include "NotesManager.h"
@@ -38,6 +39,7 @@
 #include "SpellCheckManager.h"
 #include "ToolBarsManager.h"
 #include "ThemesManager.h"
+#include "TraceRecorder.h"
 #include "TransfersManager.h"
 #include "Utils.h"
 #include "Updater.h"
@@ -69,6 +71,7 @@
 #include <QtCore/QRegularExpression>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QStorageInfo>
+#include <QtCore/QTimer>
 #include <QtCore/QTranslator>
 #include <QtGui/QDesktopServices>
 #include <QtNetwork/QLocalSocket>
@@ -135,6 +138,7 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv), Act
 	m_commandLineParser.addOption(QCommandLineOption(QLatin1String("new-private-window"), translate("main", "Loads URL in new private window")));
 	m_commandLineParser.addOption(QCommandLineOption(QLatin1String("readonly"), translate("main", "Tells application to avoid writing data to disk")));
 	m_commandLineParser.addOption(QCommandLineOption(QLatin1String("report"), translate("main", "Prints out diagnostic report and exits application")));
+	m_commandLineParser.addOption(QCommandLineOption(QLatin1String("trace"), translate("main", "Records duration of startup and runtime operations and saves it to <path> as Chrome trace event file on exit"), QLatin1String("path"), {}));
 
 	QStringList arguments(this->arguments());
 	QString argumentsPath(QDir::current().filePath(QLatin1String("arguments.txt")));
@@ -177,6 +181,13 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv), Act
 
 	m_commandLineParser.process(arguments);
 
+	if (m_commandLineParser.isSet(QLatin1String("trace")))
+	{
+		TraceRecorder::setEnabled(true);
+	}
+
+	const TraceRecorder::Span span("Application::Application");
+
 	const bool isPortable(m_commandLineParser.isSet(QLatin1String("portable")));
 	const bool isPrivate(m_commandLineParser.isSet(QLatin1String("private-session")));
 	bool isReadOnly(m_commandLineParser.isSet(QLatin1String("readonly")));
@@ -400,48 +411,43 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv), Act
 		return;
 	}
 
-	ThemesManager::createInstance();
+	{
+		const TraceRecorder::Span managersSpan("Application::createManagers");
 
-	ActionsManager::createInstance();
+		ThemesManager::createInstance();
 
-	AddonsManager::createInstance();
+		ActionsManager::createInstance();
 
-	BookmarksManager::createInstance();
+		AddonsManager::createInstance();
 
-	FeedsManager::createInstance();
+		BookmarksManager::createInstance();
 
-	GesturesManager::createInstance();
+		GesturesManager::createInstance();
 
-	HandlersManager::createInstance();
+		HandlersManager::createInstance();
 
-	HistoryManager::createInstance();
+		HistoryManager::createInstance();
 
-	NetworkManagerFactory::createInstance();
+		MemoryPressureManager::createInstance();
 
-	NotesManager::createInstance();
+		NetworkManagerFactory::createInstance();
 
-	NotificationsManager::createInstance();
+		NotificationsManager::createInstance();
 
-	PasswordsManager::createInstance();
+		PasswordsManager::createInstance();
 
-	SearchEnginesManager::createInstance();
+		SearchEnginesManager::createInstance();
 
-	SpellCheckManager::createInstance();
+		SpellCheckManager::createInstance();
 
-	ToolBarsManager::createInstance();
+		ToolBarsManager::createInstance();
 
-	TransfersManager::createInstance();
+		TransfersManager::createInstance();
+	}
 
 	setLocale(SettingsManager::getOption(SettingsManager::Browser_LocaleOption).toString());
 	setQuitOnLastWindowClosed(true);
 
-	const WebBackend *webBackend(AddonsManager::getWebBackend());
-
-	if (!QSslSocket::supportsSsl() || (webBackend && webBackend->getSslVersion().isEmpty()))
-	{
-		QMessageBox::warning(nullptr, tr("Warning"), tr("SSL support is not available or incomplete.\nSome websites may work incorrectly or do not work at all."), QMessageBox::Close);
-	}
-
 	if (SettingsManager::getOption(SettingsManager::Browser_EnableTrayIconOption).toBool())
 	{
 		m_trayIcon = new TrayIcon(this);
@@ -481,24 +487,28 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv), Act
 		}
 	}
 
-	Style *style(ThemesManager::createStyle(SettingsManager::getOption(SettingsManager::Interface_WidgetStyleOption).toString()));
-	QString styleSheet(style->getStyleSheet());
-	const QString styleSheetPath(SettingsManager::getOption(SettingsManager::Interface_StyleSheetOption).toString());
-
-	if (!styleSheetPath.isEmpty())
 	{
-		QFile file(styleSheetPath);
+		const TraceRecorder::Span styleSpan("Application::loadStyle");
 
-		if (file.open(QIODevice::ReadOnly))
+		Style *style(ThemesManager::createStyle(SettingsManager::getOption(SettingsManager::Interface_WidgetStyleOption).toString()));
+		QString styleSheet(style->getStyleSheet());
+		const QString styleSheetPath(SettingsManager::getOption(SettingsManager::Interface_StyleSheetOption).toString());
+
+		if (!styleSheetPath.isEmpty())
 		{
-			styleSheet += file.readAll();
+			QFile file(styleSheetPath);
 
-			file.close();
+			if (file.open(QIODevice::ReadOnly))
+			{
+				styleSheet += file.readAll();
+
+				file.close();
+			}
 		}
-	}
 
-	setStyle(style);
-	setStyleSheet(styleSheet);
+		setStyle(style);
+		setStyleSheet(styleSheet);
+	}
 
 	QDesktopServices::setUrlHandler(QLatin1String("ftp"), this, "openUrl");
 	QDesktopServices::setUrlHandler(QLatin1String("http"), this, "openUrl");
@@ -507,6 +517,22 @@ Application::Application(int &argc, char **argv) : QApplication(argc, argv), Act
 	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &Application::handleOptionChanged);
 	connect(this, &Application::aboutToQuit, this, &Application::handleAboutToQuit);
 	connect(this, &Application::focusObjectChanged, this, &Application::handleFocusObjectChanged);
+
+	QTimer::singleShot(0, this, [&]()
+	{
+		const TraceRecorder::Span deferredSpan("Application::initializeDeferred");
+
+		FeedsManager::createInstance();
+
+		NotesManager::createInstance();
+
+		const WebBackend *webBackend(AddonsManager::getWebBackend());
+
+		if (!QSslSocket::supportsSsl() || (webBackend && webBackend->getSslVersion().isEmpty()))
+		{
+			QMessageBox::warning(nullptr, tr("Warning"), tr("SSL support is not available or incomplete.\nSome websites may work incorrectly or do not work at all."), QMessageBox::Close);
+		}
+	});
 }
 
 Application::~Application()
@@ -515,6 +541,11 @@ Application::~Application()
 	{
 		m_windows.at(i)->deleteLater();
 	}
+
+	if (TraceRecorder::isEnabled())
+	{
+		TraceRecorder::save(m_commandLineParser.value(QLatin1String("trace")));
+	}
 }
 
 void Application::triggerAction(int identifier, const QVariantMap &parameters, ActionsManager::TriggerType trigger)
@@ -19,6 +19,7 @@
 **************************************************************************/
 
 #include "BookmarksManager.h"
+#include "PerformanceMonitor.h"
 #include "SessionsManager.h"
 #include "Utils.h"
 
@@ -46,6 +47,8 @@ void BookmarksManager::timerEvent(QTimerEvent *event)
 
 		if (m_model)
 		{
+			const PerformanceMonitor::FlushSpan flushSpan(PerformanceMonitor::BookmarksFlush);
+
 			m_model->save(SessionsManager::getWritableDataPath(QLatin1String("bookmarks.xbel")));
 		}
 	}
@@ -24,6 +24,7 @@
 #include "HistoryManager.h"
 #include "SessionsManager.h"
 #include "ThemesManager.h"
+#include "TraceRecorder.h"
 #include "Utils.h"
 
 #include <QtCore/QCoreApplication>
@@ -339,6 +340,8 @@ BookmarksModel::BookmarksModel(const QString &path, FormatMode mode, QObject *pa
 	m_importTargetItem(nullptr),
 	m_mode(mode)
 {
+	const TraceRecorder::Span span("BookmarksModel::BookmarksModel");
+
 	m_rootItem->setData(RootBookmark, TypeRole);
 	m_rootItem->setDragEnabled(false);
 	m_trashItem->setData(TrashBookmark, TypeRole);
@@ -1461,6 +1464,8 @@ bool BookmarksModel::dropMimeData(const QMimeData *data, Qt::DropAction action,
 
 bool BookmarksModel::save(const QString &path) const
 {
+	const TraceRecorder::Span span("BookmarksModel::save");
+
 	if (SessionsManager::isReadOnly())
 	{
 		return false;
@@ -21,15 +21,19 @@
 #include "ContentFiltersManager.h"
 #include "AdblockContentFiltersProfile.h"
 #include "Console.h"
+#include "HashPrefixContentFiltersProfile.h"
 #include "JsonSettings.h"
+#include "PerformanceMonitor.h"
 #include "SettingsManager.h"
 #include "SessionsManager.h"
 #include "Utils.h"
 #include "../ui/ItemViewWidget.h"
 
 #include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
+#include <QtCore/QThread>
 #include <QtGui/QStandardItemModel>
 
 namespace Otter
@@ -38,6 +42,8 @@ namespace Otter
 ContentFiltersManager* ContentFiltersManager::m_instance(nullptr);
 QVector<ContentFiltersProfile*> ContentFiltersManager::m_contentBlockingProfiles;
 QVector<ContentFiltersProfile*> ContentFiltersManager::m_fraudCheckingProfiles;
+QHash<QVector<int>, ContentFiltersProfile*> ContentFiltersManager::m_profileSets;
+QReadWriteLock ContentFiltersManager::m_profileSetsLock;
 ContentFiltersManager::CosmeticFiltersMode ContentFiltersManager::m_cosmeticFiltersMode(AllFilters);
 bool ContentFiltersManager::m_areWildcardsEnabled(true);
 
@@ -49,6 +55,7 @@ ContentFiltersManager::ContentFiltersManager(QObject *parent) : QObject(parent),
 	handleOptionChanged(SettingsManager::ContentBlocking_CosmeticFiltersModeOption, SettingsManager::getOption(SettingsManager::ContentBlocking_CosmeticFiltersModeOption).toString());
 
 	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &ContentFiltersManager::handleOptionChanged);
+	connect(this, &ContentFiltersManager::profileSetRequested, this, &ContentFiltersManager::createProfileSet, Qt::QueuedConnection);
 }
 
 void ContentFiltersManager::createInstance()
@@ -250,9 +257,70 @@ void ContentFiltersManager::ensureInitialized()
 
 		connect(profile, &ContentFiltersProfile::profileModified, m_instance, &ContentFiltersManager::profileModified);
 		connect(profile, &ContentFiltersProfile::profileModified, m_instance, &ContentFiltersManager::scheduleSave);
+		connect(profile, &ContentFiltersProfile::profileModified, m_instance, &ContentFiltersManager::clearProfileSets);
 	}
 
 	m_contentBlockingProfiles.squeeze();
+
+	const QUrl fraudCheckingUpdateUrl(SettingsManager::getOption(SettingsManager::Security_FraudCheckingUpdateUrlOption).toString());
+
+	if (m_fraudCheckingProfiles.isEmpty() && (fraudCheckingUpdateUrl.isValid() || QFile::exists(SessionsManager::getWritableDataPath(QLatin1String("contentBlocking/fraud.prefixes")))))
+	{
+		createFraudCheckingProfile(fraudCheckingUpdateUrl);
+	}
+}
+
+void ContentFiltersManager::createFraudCheckingProfile(const QUrl &updateUrl)
+{
+	ContentFiltersProfile *profile(new HashPrefixContentFiltersProfile(QLatin1String("fraud"), tr("Fraud Protection"), updateUrl, 1, m_instance));
+
+	m_fraudCheckingProfiles.append(profile);
+
+	connect(profile, &ContentFiltersProfile::profileModified, m_instance, &ContentFiltersManager::profileModified);
+}
+
+void ContentFiltersManager::clearProfileSets()
+{
+// sets are rebuilt from modified sources when requested again, lookups never reload them
+	const QWriteLocker locker(&m_profileSetsLock);
+	QHash<QVector<int>, ContentFiltersProfile*>::iterator iterator;
+
+	for (iterator = m_profileSets.begin(); iterator != m_profileSets.end(); ++iterator)
+	{
+		iterator.value()->clear();
+		iterator.value()->deleteLater();
+	}
+
+	m_profileSets.clear();
+}
+
+void ContentFiltersManager::createProfileSet(const QVector<int> &profiles)
+{
+// sets are modified only in this thread, so reading them here does not need a lock
+	if (profiles.count() < 2 || m_profileSets.contains(profiles))
+	{
+		return;
+	}
+
+	QVector<AdblockContentFiltersProfile*> sources;
+	sources.reserve(profiles.count());
+
+	for (int i = 0; i < profiles.count(); ++i)
+	{
+		AdblockContentFiltersProfile *profile((profiles.at(i) >= 0 && profiles.at(i) < m_contentBlockingProfiles.count()) ? qobject_cast<AdblockContentFiltersProfile*>(m_contentBlockingProfiles.at(profiles.at(i))) : nullptr);
+
+		if (!profile)
+		{
+			return;
+		}
+
+		sources.append(profile);
+	}
+
+	ContentFiltersProfile *profileSet(new AdblockContentFiltersProfile(sources, profiles, m_instance));
+	const QWriteLocker locker(&m_profileSetsLock);
+
+	m_profileSets[profiles] = profileSet;
 }
 
 void ContentFiltersManager::scheduleSave()
@@ -272,6 +340,7 @@ void ContentFiltersManager::addProfile(ContentFiltersProfile *profile)
 		getInstance()->scheduleSave();
 
 		connect(profile, &ContentFiltersProfile::profileModified, m_instance, &ContentFiltersManager::scheduleSave);
+		connect(profile, &ContentFiltersProfile::profileModified, m_instance, &ContentFiltersManager::clearProfileSets);
 	}
 }
 
@@ -283,6 +352,26 @@ void ContentFiltersManager::handleOptionChanged(int identifier, const QVariant &
 			m_areWildcardsEnabled = value.toBool();
 
 			break;
+		case SettingsManager::Security_FraudCheckingUpdateUrlOption:
+			if (!m_contentBlockingProfiles.isEmpty())
+			{
+				const QUrl updateUrl(value.toString());
+
+				if (m_fraudCheckingProfiles.isEmpty())
+				{
+					if (updateUrl.isValid())
+					{
+						createFraudCheckingProfile(updateUrl);
+					}
+				}
+				else if (updateUrl.isValid() && updateUrl != m_fraudCheckingProfiles.at(0)->getUpdateUrl())
+				{
+					m_fraudCheckingProfiles.at(0)->setUpdateUrl(updateUrl);
+					m_fraudCheckingProfiles.at(0)->update();
+				}
+			}
+
+			return;
 		case SettingsManager::ContentBlocking_CosmeticFiltersModeOption:
 			{
 				const QString cosmeticFiltersMode(value.toString());
@@ -310,6 +399,8 @@ void ContentFiltersManager::handleOptionChanged(int identifier, const QVariant &
 	{
 		m_contentBlockingProfiles.at(i)->clear();
 	}
+
+	clearProfileSets();
 }
 
 void ContentFiltersManager::removeProfile(ContentFiltersProfile *profile)
@@ -342,6 +433,8 @@ void ContentFiltersManager::removeProfile(ContentFiltersProfile *profile)
 
 	m_contentBlockingProfiles.removeAll(profile);
 
+	clearProfileSets();
+
 	profile->deleteLater();
 }
 
@@ -482,14 +575,37 @@ ContentFiltersManager::CheckResult ContentFiltersManager::checkUrl(const QVector
 	CheckResult result;
 	result.isFraud = ((resourceType == NetworkManager::MainFrameType || resourceType == NetworkManager::SubFrameType) ? isFraud(requestUrl) : false);
 
+	const QReadLocker locker(&m_profileSetsLock);
+	ContentFiltersProfile *profileSet(getProfileSet(profiles));
+
+	QElapsedTimer timer;
+
+	if (profileSet)
+	{
+		timer.start();
+
+		CheckResult currentResult(profileSet->checkUrl(baseUrl, requestUrl, resourceType));
+		currentResult.isFraud = result.isFraud;
+
+		PerformanceMonitor::addContentFiltersCheck(profileSet->getName(), timer.nsecsElapsed());
+
+		return currentResult;
+	}
+
 	for (int i = 0; i < profiles.count(); ++i)
 	{
 		if (profiles.at(i) >= 0 && profiles.at(i) < m_contentBlockingProfiles.count())
 		{
-			CheckResult currentResult(m_contentBlockingProfiles.at(profiles.at(i))->checkUrl(baseUrl, requestUrl, resourceType));
+			ContentFiltersProfile *profile(m_contentBlockingProfiles.at(profiles.at(i)));
+
+			timer.start();
+
+			CheckResult currentResult(profile->checkUrl(baseUrl, requestUrl, resourceType));
 			currentResult.profile = profiles.at(i);
 			currentResult.isFraud = result.isFraud;
 
+			PerformanceMonitor::addContentFiltersCheck(profile->getName(), timer.nsecsElapsed());
+
 			if (currentResult.isBlocked)
 			{
 				result = currentResult;
@@ -518,8 +634,16 @@ ContentFiltersManager::CosmeticFiltersResult ContentFiltersManager::getCosmeticF
 		return {};
 	}
 
-	CosmeticFiltersResult result;
 	const QStringList domains(createSubdomainList(requestUrl.host()));
+	const QReadLocker locker(&m_profileSetsLock);
+	ContentFiltersProfile *profileSet(getProfileSet(profiles));
+
+	if (profileSet)
+	{
+		return profileSet->getCosmeticFilters(domains, (mode == DomainOnlyFilters));
+	}
+
+	CosmeticFiltersResult result;
 
 	for (int i = 0; i < profiles.count(); ++i)
 	{
@@ -570,6 +694,24 @@ QStringList ContentFiltersManager::getProfileNames()
 	return names;
 }
 
+ContentFiltersProfile* ContentFiltersManager::getProfileSet(const QVector<int> &profiles)
+{
+	if (profiles.count() < 2)
+	{
+		return nullptr;
+	}
+
+	ContentFiltersProfile *profileSet(m_profileSets.value(profiles, nullptr));
+
+// sets are created only in the thread of manager, callers from other threads check profiles one by one until it is ready
+	if (!profileSet)
+	{
+		emit m_instance->profileSetRequested(profiles);
+	}
+
+	return profileSet;
+}
+
 QVector<ContentFiltersProfile*> ContentFiltersManager::getContentBlockingProfiles()
 {
 	ensureInitialized();
@@ -599,6 +741,11 @@ QVector<int> ContentFiltersManager::getProfileIdentifiers(const QStringList &nam
 		}
 	}
 
+	if (m_instance && QThread::currentThread() == m_instance->thread())
+	{
+		m_instance->createProfileSet(identifiers);
+	}
+
 	return identifiers;
 }
 
@@ -614,6 +761,8 @@ bool ContentFiltersManager::areWildcardsEnabled()
 
 bool ContentFiltersManager::isFraud(const QUrl &url)
 {
+	ensureInitialized();
+
 	for (int i = 0; i < m_fraudCheckingProfiles.count(); ++i)
 	{
 		if (m_fraudCheckingProfiles.at(i)->isFraud(url))
@@ -23,6 +23,7 @@
 
 #include "NetworkManager.h"
 
+#include <QtCore/QReadWriteLock>
 #include <QtCore/QUrl>
 #include <QtGui/QStandardItemModel>
 
@@ -89,9 +90,13 @@ protected:
 
 	void timerEvent(QTimerEvent *event) override;
 	static void ensureInitialized();
+	static void createFraudCheckingProfile(const QUrl &updateUrl);
+	static void clearProfileSets();
+	static ContentFiltersProfile* getProfileSet(const QVector<int> &profiles);
 
 protected slots:
 	void scheduleSave();
+	void createProfileSet(const QVector<int> &profiles);
 	void handleOptionChanged(int identifier, const QVariant &value);
 
 private:
@@ -100,11 +105,14 @@ private:
 	static ContentFiltersManager *m_instance;
 	static QVector<ContentFiltersProfile*> m_contentBlockingProfiles;
 	static QVector<ContentFiltersProfile*> m_fraudCheckingProfiles;
+	static QHash<QVector<int>, ContentFiltersProfile*> m_profileSets;
+	static QReadWriteLock m_profileSetsLock;
 	static CosmeticFiltersMode m_cosmeticFiltersMode;
 	static bool m_areWildcardsEnabled;
 
 signals:
 	void profileModified(const QString &profile);
+	void profileSetRequested(const QVector<int> &profiles);
 };
 
 class ContentFiltersProfile : public QObject
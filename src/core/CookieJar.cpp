@@ -19,8 +19,10 @@
 
 #include "CookieJar.h"
 #include "Application.h"
+#include "PerformanceMonitor.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
+#include "TraceRecorder.h"
 
 #include <QtCore/QDataStream>
 #include <QtCore/QFile>
@@ -164,6 +166,9 @@ void CookieJar::handleOptionChanged(int identifier, const QVariant &value)
 
 void CookieJar::save()
 {
+	const TraceRecorder::Span span("CookieJar::save");
+	const PerformanceMonitor::FlushSpan flushSpan(PerformanceMonitor::CookiesFlush);
+
 	if (SessionsManager::isReadOnly())
 	{
 		return;
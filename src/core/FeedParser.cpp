@@ -18,7 +18,6 @@
 **************************************************************************/
 
 #include "FeedParser.h"
-#include "Console.h"
 #include "FeedsManager.h"
 #include "Job.h"
 
@@ -76,6 +75,17 @@ FeedParser* FeedParser::createParser(Feed *feed, DataFetchJob *data)
 	return nullptr;
 }
 
+void FeedParser::addMessage(FeedInformation *information, const QString &note, Console::MessageCategory category, int line)
+{
+	Console::Message message;
+	message.note = note;
+	message.category = category;
+	message.level = Console::ErrorLevel;
+	message.line = line;
+
+	information->messages.append(message);
+}
+
 QString FeedParser::createIdentifier(const Feed::Entry &entry)
 {
 	if (entry.publicationTime.isValid())
@@ -95,9 +105,9 @@ AtomFeedParser::AtomFeedParser() : FeedParser()
 	m_data.mimeType = QMimeDatabase().mimeTypeForName(QLatin1String("application/atom+xml"));
 }
 
-void AtomFeedParser::parse(DataFetchJob *data)
+bool AtomFeedParser::parse(const QByteArray &data)
 {
-	QXmlStreamReader reader(data->getData());
+	QXmlStreamReader reader(data);
 	bool isSuccess(true);
 
 	m_data.entries.reserve(10);
@@ -216,7 +226,7 @@ void AtomFeedParser::parse(DataFetchJob *data)
 
 			if (reader.hasError())
 			{
-				Console::addMessage(tr("Failed to parse feed file: %1").arg(reader.errorString()), Console::OtherCategory, Console::ErrorLevel, data->getUrl().toDisplayString());
+				addMessage(&m_data, tr("Failed to parse feed file: %1").arg(reader.errorString()), Console::OtherCategory);
 
 				isSuccess = false;
 			}
@@ -227,12 +237,12 @@ void AtomFeedParser::parse(DataFetchJob *data)
 
 	if (m_data.entries.isEmpty())
 	{
-		Console::addMessage(tr("Failed to parse feed: no valid entries found"), Console::NetworkCategory, Console::ErrorLevel, data->getUrl().toDisplayString());
+		addMessage(&m_data, tr("Failed to parse feed: no valid entries found"), Console::NetworkCategory);
 
 		isSuccess = false;
 	}
 
-	emit parsingFinished(isSuccess);
+	return isSuccess;
 }
 
 FeedParser::FeedInformation AtomFeedParser::getInformation() const
@@ -253,9 +263,9 @@ RssFeedParser::RssFeedParser() : FeedParser()
 	m_data.mimeType = QMimeDatabase().mimeTypeForName(QLatin1String("application/rss+xml"));
 }
 
-void RssFeedParser::parse(DataFetchJob *data)
+bool RssFeedParser::parse(const QByteArray &data)
 {
-	QXmlStreamReader reader(data->getData());
+	QXmlStreamReader reader(data);
 	bool isSuccess(true);
 
 	m_data.entries.reserve(10);
@@ -377,7 +387,7 @@ void RssFeedParser::parse(DataFetchJob *data)
 
 			if (reader.hasError())
 			{
-				Console::addMessage(tr("Failed to parse feed file: %1").arg(reader.errorString()), Console::OtherCategory, Console::ErrorLevel, data->getUrl().toDisplayString(), static_cast<int>(reader.lineNumber()));
+				addMessage(&m_data, tr("Failed to parse feed file: %1").arg(reader.errorString()), Console::OtherCategory, static_cast<int>(reader.lineNumber()));
 
 				isSuccess = false;
 			}
@@ -388,12 +398,12 @@ void RssFeedParser::parse(DataFetchJob *data)
 
 	if (m_data.entries.isEmpty())
 	{
-		Console::addMessage(tr("Failed to parse feed: no valid entries found"), Console::NetworkCategory, Console::ErrorLevel, data->getUrl().toDisplayString());
+		addMessage(&m_data, tr("Failed to parse feed: no valid entries found"), Console::NetworkCategory);
 
 		isSuccess = false;
 	}
 
-	emit parsingFinished(isSuccess);
+	return isSuccess;
 }
 
 FeedParser::FeedInformation RssFeedParser::getInformation() const
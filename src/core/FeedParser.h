@@ -20,6 +20,7 @@
 #ifndef OTTER_FEEDPARSER_H
 #define OTTER_FEEDPARSER_H
 
+#include "Console.h"
 #include "FeedsManager.h"
 
 #include <QtCore/QMimeType>
@@ -51,19 +52,18 @@ public:
 		QMimeType mimeType;
 		QMap<QString, QString> categories;
 		QVector<Feed::Entry> entries;
+		QVector<Console::Message> messages;
 	};
 
 	explicit FeedParser();
 
-	virtual void parse(DataFetchJob *data) = 0;
+	virtual bool parse(const QByteArray &data) = 0;
 	virtual FeedInformation getInformation() const = 0;
 	static FeedParser* createParser(Feed *feed, DataFetchJob *data);
 
 protected:
+	static void addMessage(FeedInformation *information, const QString &note, Console::MessageCategory category, int line = -1);
 	static QString createIdentifier(const Feed::Entry &entry);
-
-signals:
-	void parsingFinished(bool isSuccess);
 };
 
 class AtomFeedParser final : public FeedParser
@@ -71,7 +71,7 @@ class AtomFeedParser final : public FeedParser
 public:
 	explicit AtomFeedParser();
 
-	void parse(DataFetchJob *data) override;
+	bool parse(const QByteArray &data) override;
 	FeedInformation getInformation() const override;
 
 protected:
@@ -86,7 +86,7 @@ class RssFeedParser final : public FeedParser
 public:
 	explicit RssFeedParser();
 
-	void parse(DataFetchJob *data) override;
+	bool parse(const QByteArray &data) override;
 	FeedInformation getInformation() const override;
 
 protected:
@@ -28,7 +28,10 @@
 #include "SessionsManager.h"
 #include "Utils.h"
 
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QFile>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
@@ -39,7 +42,6 @@ namespace Otter
 
 Feed::Feed(const QString &title, const QUrl &url, const QIcon &icon, int updateInterval, QObject *parent) : QObject(parent),
 	m_updateTimer(nullptr),
-	m_parser(nullptr),
 	m_title(title),
 	m_url(url),
 	m_icon(icon),
@@ -149,6 +151,16 @@ void Feed::setEntries(const QVector<Feed::Entry> &entries)
 	m_entries = entries;
 }
 
+void Feed::setEntityTag(const QString &tag)
+{
+	m_entityTag = tag;
+}
+
+void Feed::setLastModified(const QString &time)
+{
+	m_lastModified = time;
+}
+
 void Feed::setUpdateInterval(int interval)
 {
 	if (interval != m_updateInterval)
@@ -166,10 +178,17 @@ void Feed::setUpdateInterval(int interval)
 			{
 				m_updateTimer = new LongTermTimer(this);
 
-				connect(m_updateTimer, &LongTermTimer::timeout, this, &Feed::update);
+				connect(m_updateTimer, &LongTermTimer::timeout, this, [&]()
+				{
+					FeedsManager::scheduleUpdate(this);
+				});
 			}
 
-			m_updateTimer->start(static_cast<quint64>(interval) * 60000);
+			const quint64 updateInterval(static_cast<quint64>(interval) * 60000);
+			const quint64 delay(QCryptographicHash::hash(m_url.toString().toUtf8(), QCryptographicHash::Md5).toHex().left(8).toULongLong(nullptr, 16));
+
+// delay is derived from URL with fixed hash, so it is the same in each run
+			m_updateTimer->start(updateInterval + (delay % ((updateInterval / 10) + 1)));
 		}
 
 		emit feedModified(this);
@@ -178,7 +197,7 @@ void Feed::setUpdateInterval(int interval)
 
 void Feed::update()
 {
-	if (m_parser)
+	if (m_isUpdating)
 	{
 		return;
 	}
@@ -190,156 +209,211 @@ void Feed::update()
 
 	DataFetchJob *dataJob(new DataFetchJob(m_url, this));
 
+	if (!m_entries.isEmpty())
+	{
+		if (!m_entityTag.isEmpty())
+		{
+			dataJob->setHeader(QByteArrayLiteral("If-None-Match"), m_entityTag.toLatin1());
+		}
+
+		if (!m_lastModified.isEmpty())
+		{
+			dataJob->setHeader(QByteArrayLiteral("If-Modified-Since"), m_lastModified.toLatin1());
+		}
+	}
+
 	connect(dataJob, &DataFetchJob::jobFinished, this, [=](bool isFetchSuccess)
 	{
-		if (isFetchSuccess)
+		if (!isFetchSuccess)
 		{
-			m_parser = FeedParser::createParser(this, dataJob);
+			m_error = DownloadError;
+			m_isUpdating = false;
 
-			if (m_parser)
-			{
-				m_parser->moveToThread(&m_parserThread);
+			Console::addMessage(tr("Failed to download feed"), Console::NetworkCategory, Console::ErrorLevel, m_url.toDisplayString());
 
-				connect(m_parser, &FeedParser::parsingFinished, [&](bool isParsingSuccess)
-				{
-					const FeedParser::FeedInformation information(m_parser->getInformation());
+			emit feedModified(this);
 
-					if (!isParsingSuccess)
-					{
-						m_error = ParseError;
-					}
+			return;
+		}
 
-					if (m_icon.isNull() && information.icon.isValid())
-					{
-						IconFetchJob *iconJob(new IconFetchJob(information.icon, this));
+		if (!dataJob->isModified())
+		{
+			m_lastSynchronizationTime = QDateTime::currentDateTimeUtc();
+			m_isUpdating = false;
 
-						connect(iconJob, &IconFetchJob::jobFinished, this, [=]()
-						{
-							setIcon(iconJob->getIcon());
-						});
+			emit feedModified(this);
 
-						iconJob->start();
-					}
+			return;
+		}
 
-					if (m_title.isEmpty())
-					{
-						m_title = information.title;
-					}
+		FeedParser *parser(FeedParser::createParser(this, dataJob));
 
-					if (m_description.isEmpty())
-					{
-						m_description = information.description;
-					}
+		if (!parser)
+		{
+			m_error = ParseError;
+			m_isUpdating = false;
 
-					if (!information.entries.isEmpty())
-					{
-						QStringList existingRemovedEntries;
-						int amount(0);
-
-						for (int i = (information.entries.count() - 1); i >= 0; --i)
-						{
-							Feed::Entry entry(information.entries.at(i));
-
-							if (m_removedEntries.contains(entry.identifier))
-							{
-								existingRemovedEntries.append(entry.identifier);
-							}
-							else
-							{
-								bool hasEntry(false);
-
-								for (int j = 0; j < m_entries.count(); ++j)
-								{
-									const Feed::Entry existingEntry(m_entries.at(j));
-
-									if (existingEntry.identifier == entry.identifier)
-									{
-										if (existingEntry.publicationTime != entry.publicationTime || existingEntry.updateTime != entry.updateTime)
-										{
-											++amount;
-										}
-
-										entry.publicationTime = normalizeTime(entry.publicationTime);
-
-										if (entry.updateTime.isValid())
-										{
-											entry.updateTime = normalizeTime(entry.updateTime);
-										}
-
-										m_entries[j] = entry;
-
-										hasEntry = true;
-
-										break;
-									}
-								}
-
-								if (!hasEntry)
-								{
-									++amount;
-
-									entry.publicationTime = normalizeTime(entry.publicationTime);
-									entry.updateTime = normalizeTime(entry.updateTime);
-
-									m_entries.prepend(entry);
-								}
-							}
-						}
-
-						m_removedEntries = existingRemovedEntries;
-
-						if (amount > 0)
-						{
-							connect(NotificationsManager::createNotification(NotificationsManager::FeedUpdatedEvent, tr("Feed updated:\n%1").arg(getTitle()), Notification::InformationLevel, this), &Notification::clicked, [&]()
-							{
-								Application::getInstance()->triggerAction(ActionsManager::OpenUrlAction, {{QLatin1String("url"), QUrl(QLatin1String("view-feed:") + getUrl().toDisplayString())}});
-							});
-						}
-
-						emit entriesModified(this);
-					}
+			Console::addMessage(tr("Failed to parse feed: invalid feed type"), Console::NetworkCategory, Console::ErrorLevel, m_url.toDisplayString());
 
-					m_mimeType = information.mimeType;
-					m_lastSynchronizationTime = QDateTime::currentDateTimeUtc();
-					m_lastUpdateTime = information.lastUpdateTime;
-					m_categories = information.categories;
+			emit feedModified(this);
 
-					m_parserThread.exit();
+			return;
+		}
 
-					m_parser->deleteLater();
-					m_parser = nullptr;
+		m_entityTag = QString::fromLatin1(dataJob->getHeader(QByteArrayLiteral("ETag")));
+		m_lastModified = QString::fromLatin1(dataJob->getHeader(QByteArrayLiteral("Last-Modified")));
 
-					m_isUpdating = false;
+		const QByteArray data(dataJob->getData()->readAll());
+		QFutureWatcher<bool> *watcher(new QFutureWatcher<bool>(this));
 
-					emit feedModified(this);
-				});
+		connect(watcher, &QFutureWatcher<bool>::finished, this, [=]()
+		{
+			handleParsingFinished(parser, watcher->result());
 
-				m_parserThread.start();
+			delete parser;
 
-				m_parser->parse(dataJob);
-			}
-			else
+			watcher->deleteLater();
+		});
+
+		watcher->setFuture(QtConcurrent::run(FeedsManager::getThreadPool(), [=]()
+		{
+			return parser->parse(data);
+		}));
+	});
+
+	dataJob->start();
+}
+
+void Feed::mergeEntries(const QVector<Feed::Entry> &entries)
+{
+	const QSet<QString> removedEntries(m_removedEntries.toSet());
+	QHash<QString, int> existingEntries;
+	QSet<QString> newIdentifiers;
+	QVector<Feed::Entry> newEntries;
+	QStringList existingRemovedEntries;
+	int amount(0);
+
+	existingEntries.reserve(m_entries.count());
+
+	for (int i = 0; i < m_entries.count(); ++i)
+	{
+		existingEntries.insert(m_entries.at(i).identifier, i);
+	}
+
+	for (int i = 0; i < entries.count(); ++i)
+	{
+		Feed::Entry entry(entries.at(i));
+
+		if (removedEntries.contains(entry.identifier))
+		{
+			existingRemovedEntries.append(entry.identifier);
+
+			continue;
+		}
+
+		const int index(existingEntries.value(entry.identifier, -1));
+
+		if (index >= 0)
+		{
+			const Feed::Entry &existingEntry(m_entries.at(index));
+
+			if (existingEntry.publicationTime != entry.publicationTime || existingEntry.updateTime != entry.updateTime)
 			{
-				m_error = ParseError;
-				m_isUpdating = false;
+				++amount;
+			}
 
-				Console::addMessage(tr("Failed to parse feed: invalid feed type"), Console::NetworkCategory, Console::ErrorLevel, m_url.toDisplayString());
+			entry.publicationTime = normalizeTime(entry.publicationTime);
 
-				emit feedModified(this);
+			if (entry.updateTime.isValid())
+			{
+				entry.updateTime = normalizeTime(entry.updateTime);
 			}
+
+			m_entries[index] = entry;
 		}
-		else
+		else if (!newIdentifiers.contains(entry.identifier))
 		{
-			m_error = DownloadError;
-			m_isUpdating = false;
+			++amount;
 
-			Console::addMessage(tr("Failed to download feed"), Console::NetworkCategory, Console::ErrorLevel, m_url.toDisplayString());
+			entry.publicationTime = normalizeTime(entry.publicationTime);
+			entry.updateTime = normalizeTime(entry.updateTime);
 
-			emit feedModified(this);
+			newIdentifiers.insert(entry.identifier);
+			newEntries.append(entry);
 		}
-	});
+	}
 
-	dataJob->start();
+	if (!newEntries.isEmpty())
+	{
+		newEntries.reserve(newEntries.count() + m_entries.count());
+		newEntries.append(m_entries);
+
+		m_entries = newEntries;
+	}
+
+	m_removedEntries = existingRemovedEntries;
+
+	if (amount > 0)
+	{
+		connect(NotificationsManager::createNotification(NotificationsManager::FeedUpdatedEvent, tr("Feed updated:\n%1").arg(getTitle()), Notification::InformationLevel, this), &Notification::clicked, [&]()
+		{
+			Application::getInstance()->triggerAction(ActionsManager::OpenUrlAction, {{QLatin1String("url"), QUrl(QLatin1String("view-feed:") + getUrl().toDisplayString())}});
+		});
+	}
+
+	emit entriesModified(this);
+}
+
+void Feed::handleParsingFinished(FeedParser *parser, bool isSuccess)
+{
+	const FeedParser::FeedInformation information(parser->getInformation());
+
+	for (int i = 0; i < information.messages.count(); ++i)
+	{
+		const Console::Message message(information.messages.at(i));
+
+		Console::addMessage(message.note, message.category, message.level, m_url.toDisplayString(), message.line);
+	}
+
+	if (!isSuccess)
+	{
+		m_error = ParseError;
+	}
+
+	if (m_icon.isNull() && information.icon.isValid())
+	{
+		IconFetchJob *iconJob(new IconFetchJob(information.icon, this));
+
+		connect(iconJob, &IconFetchJob::jobFinished, this, [=]()
+		{
+			setIcon(iconJob->getIcon());
+		});
+
+		iconJob->start();
+	}
+
+	if (m_title.isEmpty())
+	{
+		m_title = information.title;
+	}
+
+	if (m_description.isEmpty())
+	{
+		m_description = information.description;
+	}
+
+	if (!information.entries.isEmpty())
+	{
+		mergeEntries(information.entries);
+	}
+
+	m_mimeType = information.mimeType;
+	m_lastSynchronizationTime = QDateTime::currentDateTimeUtc();
+	m_lastUpdateTime = information.lastUpdateTime;
+	m_categories = information.categories;
+	m_isUpdating = false;
+
+	emit feedModified(this);
 }
 
 QString Feed::getTitle() const
@@ -372,6 +446,16 @@ QDateTime Feed::getLastSynchronizationTime() const
 	return m_lastSynchronizationTime;
 }
 
+QString Feed::getEntityTag() const
+{
+	return m_entityTag;
+}
+
+QString Feed::getLastModified() const
+{
+	return m_lastModified;
+}
+
 QDateTime Feed::normalizeTime(const QDateTime &time) const
 {
 	return ((time.isValid() && time < QDateTime::currentDateTimeUtc()) ? time : QDateTime::currentDateTimeUtc());
@@ -442,12 +526,17 @@ bool Feed::isUpdating() const
 
 FeedsManager* FeedsManager::m_instance(nullptr);
 FeedsModel* FeedsManager::m_model(nullptr);
+QThreadPool* FeedsManager::m_threadPool(nullptr);
 QVector<Feed*> FeedsManager::m_feeds;
+QVector<QPointer<Feed> > FeedsManager::m_updateQueue;
 bool FeedsManager::m_isInitialized(false);
 
 FeedsManager::FeedsManager(QObject *parent) : QObject(parent),
 	m_saveTimer(0)
 {
+	m_threadPool = new QThreadPool(this);
+	m_threadPool->setMaxThreadCount(2);
+	m_threadPool->setExpiryTimeout(60000);
 }
 
 void FeedsManager::timerEvent(QTimerEvent *event)
@@ -512,6 +601,16 @@ void FeedsManager::timerEvent(QTimerEvent *event)
 				feedObject.insert(QLatin1String("categories"), categoriesObject);
 			}
 
+			if (!feed->getEntityTag().isEmpty())
+			{
+				feedObject.insert(QLatin1String("entityTag"), feed->getEntityTag());
+			}
+
+			if (!feed->getLastModified().isEmpty())
+			{
+				feedObject.insert(QLatin1String("lastModified"), feed->getLastModified());
+			}
+
 			if (!feed->getRemovedEntries().isEmpty())
 			{
 				feedObject.insert(QLatin1String("removedEntries"), QJsonArray::fromStringList(feed->getRemovedEntries()));
@@ -603,6 +702,8 @@ void FeedsManager::ensureInitialized()
 
 	m_isInitialized = true;
 
+	createInstance();
+
 	QFile file(SessionsManager::getWritableDataPath(QLatin1String("feeds.json")));
 
 	if (file.open(QIODevice::ReadOnly))
@@ -617,6 +718,8 @@ void FeedsManager::ensureInitialized()
 			feed->setLastUpdateTime(QDateTime::fromString(feedObject.value(QLatin1String("lastUpdateTime")).toString(), Qt::ISODate));
 			feed->setLastSynchronizationTime(QDateTime::fromString(feedObject.value(QLatin1String("lastSynchronizationTime")).toString(), Qt::ISODate));
 			feed->setRemovedEntries(feedObject.value(QLatin1String("removedEntries")).toVariant().toStringList());
+			feed->setEntityTag(feedObject.value(QLatin1String("entityTag")).toString());
+			feed->setLastModified(feedObject.value(QLatin1String("lastModified")).toString());
 
 			if (feedObject.contains(QLatin1String("categories")))
 			{
@@ -675,6 +778,31 @@ void FeedsManager::scheduleSave()
 	}
 }
 
+void FeedsManager::startUpdates()
+{
+	int amount(0);
+
+	for (int i = 0; i < m_feeds.count(); ++i)
+	{
+		if (m_feeds.at(i)->isUpdating())
+		{
+			++amount;
+		}
+	}
+
+	while (amount < 4 && !m_updateQueue.isEmpty())
+	{
+		Feed *feed(m_updateQueue.takeFirst());
+
+		if (feed && !feed->isUpdating())
+		{
+			feed->update();
+
+			++amount;
+		}
+	}
+}
+
 void FeedsManager::handleFeedModified(Feed *feed)
 {
 	if (feed)
@@ -682,11 +810,18 @@ void FeedsManager::handleFeedModified(Feed *feed)
 		emit feedModified(feed->getUrl());
 	}
 
+	if (!m_updateQueue.isEmpty() && feed && !feed->isUpdating())
+	{
+		startUpdates();
+	}
+
 	scheduleSave();
 }
 
 FeedsManager* FeedsManager::getInstance()
 {
+	createInstance();
+
 	return m_instance;
 }
 
@@ -743,4 +878,21 @@ QVector<Feed*> FeedsManager::getFeeds()
 	return m_feeds;
 }
 
+QThreadPool* FeedsManager::getThreadPool()
+{
+	return m_threadPool;
+}
+
+void FeedsManager::scheduleUpdate(Feed *feed)
+{
+	if (!feed || feed->isUpdating() || m_updateQueue.contains(feed))
+	{
+		return;
+	}
+
+	m_updateQueue.append(feed);
+
+	m_instance->startUpdates();
+}
+
 }
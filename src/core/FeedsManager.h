@@ -24,7 +24,8 @@
 
 #include <QtCore/QDateTime>
 #include <QtCore/QMimeType>
-#include <QtCore/QThread>
+#include <QtCore/QPointer>
+#include <QtCore/QThreadPool>
 
 namespace Otter
 {
@@ -92,16 +93,22 @@ protected:
 	void setCategories(const QMap<QString, QString> &categories);
 	void setRemovedEntries(const QStringList &removedEntries);
 	void setEntries(const QVector<Entry> &entries);
+	void setEntityTag(const QString &tag);
+	void setLastModified(const QString &time);
+	void mergeEntries(const QVector<Entry> &entries);
+	void handleParsingFinished(FeedParser *parser, bool isSuccess);
+	QString getEntityTag() const;
+	QString getLastModified() const;
 	QDateTime normalizeTime(const QDateTime &time) const;
 
 private:
 	LongTermTimer *m_updateTimer;
-	FeedParser *m_parser;
-	QThread m_parserThread;
 	QString m_title;
 	QString m_description;
 	QUrl m_url;
 	QIcon m_icon;
+	QString m_entityTag;
+	QString m_lastModified;
 	QDateTime m_lastUpdateTime;
 	QDateTime m_lastSynchronizationTime;
 	QMimeType m_mimeType;
@@ -130,11 +137,14 @@ public:
 	static Feed* createFeed(const QUrl &url, const QString &title = {}, const QIcon &icon = {}, int updateInterval = -1);
 	static Feed* getFeed(const QUrl &url);
 	static QVector<Feed*> getFeeds();
+	static QThreadPool* getThreadPool();
+	static void scheduleUpdate(Feed *feed);
 
 protected:
 	explicit FeedsManager(QObject *parent);
 
 	void timerEvent(QTimerEvent *event) override;
+	void startUpdates();
 	static void ensureInitialized();
 
 protected slots:
@@ -146,7 +156,9 @@ private:
 
 	static FeedsManager *m_instance;
 	static FeedsModel *m_model;
+	static QThreadPool *m_threadPool;
 	static QVector<Feed*> m_feeds;
+	static QVector<QPointer<Feed> > m_updateQueue;
 	static bool m_isInitialized;
 
 signals:
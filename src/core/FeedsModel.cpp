@@ -23,6 +23,7 @@
 #include "FeedsManager.h"
 #include "SessionsManager.h"
 #include "ThemesManager.h"
+#include "TraceRecorder.h"
 #include "Utils.h"
 
 #include <QtCore/QCoreApplication>
@@ -259,6 +260,8 @@ FeedsModel::FeedsModel(const QString &path, QObject *parent) : QStandardItemMode
 	m_trashEntry(new Entry()),
 	m_importTargetEntry(nullptr)
 {
+	const TraceRecorder::Span span("FeedsModel::FeedsModel");
+
 	m_rootEntry->setData(RootEntry, TypeRole);
 	m_rootEntry->setDragEnabled(false);
 	m_trashEntry->setData(TrashEntry, TypeRole);
@@ -904,6 +907,8 @@ bool FeedsModel::dropMimeData(const QMimeData *data, Qt::DropAction action, int
 
 bool FeedsModel::save(const QString &path) const
 {
+	const TraceRecorder::Span span("FeedsModel::save");
+
 	if (SessionsManager::isReadOnly())
 	{
 		return false;
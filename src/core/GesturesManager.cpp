@@ -24,6 +24,7 @@
 #include "JsonSettings.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
+#include "TraceRecorder.h"
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
@@ -525,6 +526,8 @@ bool MouseProfile::isModified() const
 
 bool MouseProfile::save()
 {
+	const TraceRecorder::Span span("MouseProfile::save");
+
 	JsonSettings settings(SessionsManager::getWritableDataPath(QLatin1String("mouse/") + m_identifier + QLatin1String(".json")));
 	QString comment;
 	QTextStream stream(&comment);
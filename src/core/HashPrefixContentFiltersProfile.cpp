@@ -0,0 +1,654 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2018 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "HashPrefixContentFiltersProfile.h"
+#include "Console.h"
+#include "NetworkManagerFactory.h"
+#include "SessionsManager.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTimer>
+#include <QtCore/QUrlQuery>
+#include <QtNetwork/QNetworkReply>
+
+#include <algorithm>
+
+namespace Otter
+{
+
+HashPrefixContentFiltersProfile::HashPrefixContentFiltersProfile(const QString &name, const QString &title, const QUrl &updateUrl, int updateInterval, QObject *parent) : ContentFiltersProfile(parent),
+	m_networkReply(nullptr),
+	m_name(name),
+	m_title(title),
+	m_updateUrl(updateUrl),
+	m_error(NoError),
+	m_version(0),
+	m_updateInterval(updateInterval),
+	m_isUpdating(false)
+{
+// lookups come from the network thread as well, so prefixes are never loaded lazily
+	loadPrefixes();
+
+	if (m_updateUrl.isValid())
+	{
+		const QDateTime lastUpdate(getLastUpdate());
+
+		if (!lastUpdate.isValid() || (m_updateInterval > 0 && lastUpdate.daysTo(QDateTime::currentDateTimeUtc()) > m_updateInterval))
+		{
+			update();
+		}
+	}
+}
+
+void HashPrefixContentFiltersProfile::clear()
+{
+	setPrefixes({});
+}
+
+void HashPrefixContentFiltersProfile::loadPrefixes()
+{
+	const QString path(getPath());
+
+	if (!QFile::exists(path))
+	{
+		setPrefixes({});
+
+		return;
+	}
+
+	QSharedPointer<PrefixesData> prefixes(new PrefixesData());
+	prefixes->file.setFileName(path);
+
+	if (!prefixes->file.open(QIODevice::ReadOnly))
+	{
+		m_error = ReadError;
+
+		Console::addMessage(QCoreApplication::translate("main", "Failed to open fraud checking profile file: %1").arg(prefixes->file.errorString()), Console::OtherCategory, Console::ErrorLevel, path);
+
+		setPrefixes({});
+
+		return;
+	}
+
+	const qint64 size(prefixes->file.size());
+	const uchar *data((size >= static_cast<qint64>(HeaderSize * sizeof(quint32))) ? prefixes->file.map(0, size) : nullptr);
+	const quint32 *header(reinterpret_cast<const quint32*>(data));
+
+	if (header && header[0] == FileSignature && header[1] != FileFormatVersion)
+	{
+		Console::addMessage(QCoreApplication::translate("main", "Fraud checking profile file uses outdated format, full update is required"), Console::OtherCategory, Console::WarningLevel, path);
+
+		setPrefixes({});
+
+		prefixes->file.close();
+		prefixes->file.remove();
+
+		m_version = 0;
+
+		if (m_updateUrl.isValid())
+		{
+			QTimer::singleShot(0, this, [&]()
+			{
+				update();
+			});
+		}
+
+		return;
+	}
+
+	if (!header || header[0] != FileSignature || ((size - static_cast<qint64>(HeaderSize * sizeof(quint32))) / static_cast<qint64>(sizeof(quint64))) < ((static_cast<qint64>(header[3]) * 2) + header[4]))
+	{
+		m_error = ReadError;
+
+		Console::addMessage(QCoreApplication::translate("main", "Failed to load fraud checking profile file: invalid data"), Console::OtherCategory, Console::ErrorLevel, path);
+
+		setPrefixes({});
+
+		return;
+	}
+
+	m_version = header[2];
+
+	prefixes->hashesAmount = header[3];
+	prefixes->hostHashesAmount = header[4];
+	prefixes->hashes = reinterpret_cast<const quint64*>(header + HeaderSize);
+	prefixes->entryHostHashes = (prefixes->hashes + prefixes->hashesAmount);
+	prefixes->hostHashes = (prefixes->entryHostHashes + prefixes->hashesAmount);
+
+	setPrefixes(prefixes);
+}
+
+void HashPrefixContentFiltersProfile::handleReplyFinished()
+{
+	m_isUpdating = false;
+
+	if (!m_networkReply)
+	{
+		return;
+	}
+
+	m_networkReply->deleteLater();
+
+	if (m_networkReply->error() != QNetworkReply::NoError)
+	{
+		m_error = DownloadError;
+
+		Console::addMessage(QCoreApplication::translate("main", "Failed to update fraud checking profile: %1").arg(m_networkReply->errorString()), Console::OtherCategory, Console::ErrorLevel, getPath());
+
+		m_networkReply = nullptr;
+
+		return;
+	}
+
+	QVector<HashEntry> entries;
+	QVector<quint64> removedHashes;
+	quint32 version(m_version);
+	bool isReset(false);
+
+	while (!m_networkReply->atEnd())
+	{
+		const QByteArray line(m_networkReply->readLine().trimmed());
+
+		if (line.isEmpty() || line.startsWith('#'))
+		{
+			continue;
+		}
+
+		if (line.startsWith("version "))
+		{
+			version = line.mid(8).trimmed().toUInt();
+		}
+		else if (line == "reset")
+		{
+			isReset = true;
+		}
+		else if (line.startsWith('+') && line.length() == 34 && line.at(17) == ' ')
+		{
+			bool isHashValid(false);
+			bool isHostHashValid(false);
+			HashEntry entry;
+			entry.hostHash = line.mid(1, 16).toULongLong(&isHostHashValid, 16);
+			entry.hash = line.mid(18).toULongLong(&isHashValid, 16);
+
+			if (isHashValid && isHostHashValid)
+			{
+				entries.append(entry);
+			}
+		}
+		else if (line.startsWith('-') && line.length() == 17)
+		{
+			bool isValid(false);
+			const quint64 hash(line.mid(1).toULongLong(&isValid, 16));
+
+			if (isValid)
+			{
+				removedHashes.append(hash);
+			}
+		}
+		else if (!line.startsWith('+') && !line.startsWith('-'))
+		{
+			QString expression(QString::fromLatin1(line));
+			int hostLength(expression.indexOf(QLatin1Char('/')));
+
+			if (hostLength < 0)
+			{
+				hostLength = expression.length();
+
+				expression.append(QLatin1Char('/'));
+			}
+
+			HashEntry entry;
+			entry.hostHash = hashRange(14695981039346656037ull, expression, 0, hostLength);
+			entry.hash = hashRange(entry.hostHash, expression, hostLength, expression.length());
+
+			entries.append(entry);
+		}
+	}
+
+	m_networkReply = nullptr;
+
+	if (!isReset)
+	{
+		const QSharedPointer<PrefixesData> prefixes(getPrefixes());
+
+		if (prefixes)
+		{
+			entries.reserve(static_cast<int>(prefixes->hashesAmount) + entries.count());
+
+			for (quint32 i = 0; i < prefixes->hashesAmount; ++i)
+			{
+				HashEntry entry;
+				entry.hash = prefixes->hashes[i];
+				entry.hostHash = prefixes->entryHostHashes[i];
+
+				entries.append(entry);
+			}
+		}
+	}
+
+	std::stable_sort(entries.begin(), entries.end(), [&](const HashEntry &first, const HashEntry &second)
+	{
+		return (first.hash < second.hash);
+	});
+
+	entries.erase(std::unique(entries.begin(), entries.end(), [&](const HashEntry &first, const HashEntry &second)
+	{
+		return (first.hash == second.hash);
+	}), entries.end());
+
+	if (!removedHashes.isEmpty())
+	{
+		std::sort(removedHashes.begin(), removedHashes.end());
+
+		entries.erase(std::remove_if(entries.begin(), entries.end(), [&](const HashEntry &entry)
+		{
+			return std::binary_search(removedHashes.constBegin(), removedHashes.constEnd(), entry.hash);
+		}), entries.end());
+	}
+
+	QVector<quint64> hashes;
+	hashes.reserve(entries.count() * 2);
+
+	QVector<quint64> hostHashes;
+	hostHashes.reserve(entries.count());
+
+	for (int i = 0; i < entries.count(); ++i)
+	{
+		hashes.append(entries.at(i).hash);
+		hostHashes.append(entries.at(i).hostHash);
+	}
+
+	for (int i = 0; i < entries.count(); ++i)
+	{
+		hashes.append(entries.at(i).hostHash);
+	}
+
+	std::sort(hostHashes.begin(), hostHashes.end());
+
+	hostHashes.erase(std::unique(hostHashes.begin(), hostHashes.end()), hostHashes.end());
+
+	QDir().mkpath(SessionsManager::getWritableDataPath(QLatin1String("contentBlocking")));
+
+	QSaveFile file(getPath());
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		m_error = DownloadError;
+
+		Console::addMessage(QCoreApplication::translate("main", "Failed to update fraud checking profile: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+
+		return;
+	}
+
+	const quint32 header[HeaderSize] = {FileSignature, FileFormatVersion, version, static_cast<quint32>(entries.count()), static_cast<quint32>(hostHashes.count()), 0};
+
+	file.write(reinterpret_cast<const char*>(header), sizeof(header));
+	file.write(reinterpret_cast<const char*>(hashes.constData()), (hashes.count() * static_cast<int>(sizeof(quint64))));
+	file.write(reinterpret_cast<const char*>(hostHashes.constData()), (hostHashes.count() * static_cast<int>(sizeof(quint64))));
+
+#ifdef Q_OS_WIN
+// open file cannot be replaced there, so lookups are suspended until the new one is mapped
+	clear();
+#endif
+
+	if (!file.commit())
+	{
+		m_error = DownloadError;
+
+		Console::addMessage(QCoreApplication::translate("main", "Failed to update fraud checking profile: %1").arg(file.errorString()), Console::OtherCategory, Console::ErrorLevel, file.fileName());
+	}
+	else
+	{
+		m_error = NoError;
+	}
+
+	loadPrefixes();
+
+	emit profileModified(m_name);
+}
+
+void HashPrefixContentFiltersProfile::setCategory(ProfileCategory category)
+{
+	Q_UNUSED(category)
+}
+
+void HashPrefixContentFiltersProfile::setTitle(const QString &title)
+{
+	if (title != m_title)
+	{
+		m_title = title;
+
+		emit profileModified(m_name);
+	}
+}
+
+void HashPrefixContentFiltersProfile::setUpdateInterval(int interval)
+{
+	if (interval != m_updateInterval)
+	{
+		m_updateInterval = interval;
+
+		emit profileModified(m_name);
+	}
+}
+
+void HashPrefixContentFiltersProfile::setUpdateUrl(const QUrl &url)
+{
+	if (url.isValid() && url != m_updateUrl)
+	{
+		m_updateUrl = url;
+
+		emit profileModified(m_name);
+	}
+}
+
+QString HashPrefixContentFiltersProfile::getName() const
+{
+	return m_name;
+}
+
+QString HashPrefixContentFiltersProfile::getTitle() const
+{
+	return (m_title.isEmpty() ? tr("(Unknown)") : m_title);
+}
+
+QString HashPrefixContentFiltersProfile::getPath() const
+{
+	return SessionsManager::getWritableDataPath(QLatin1String("contentBlocking/%1.prefixes")).arg(m_name);
+}
+
+QDateTime HashPrefixContentFiltersProfile::getLastUpdate() const
+{
+	const QFileInfo information(getPath());
+
+	return (information.exists() ? information.lastModified().toUTC() : QDateTime());
+}
+
+QUrl HashPrefixContentFiltersProfile::getUpdateUrl() const
+{
+	return m_updateUrl;
+}
+
+ContentFiltersManager::CheckResult HashPrefixContentFiltersProfile::checkUrl(const QUrl &baseUrl, const QUrl &requestUrl, NetworkManager::ResourceType resourceType)
+{
+	Q_UNUSED(baseUrl)
+	Q_UNUSED(requestUrl)
+	Q_UNUSED(resourceType)
+
+	return {};
+}
+
+ContentFiltersProfile::ProfileError HashPrefixContentFiltersProfile::getError() const
+{
+	return m_error;
+}
+
+ContentFiltersProfile::ProfileFlags HashPrefixContentFiltersProfile::getFlags() const
+{
+	return NoFlags;
+}
+
+quint64 HashPrefixContentFiltersProfile::hashRange(quint64 hash, const QString &string, int from, int to)
+{
+	for (int i = from; i < to; ++i)
+	{
+		hash = ((hash ^ static_cast<quint64>(string.at(i).unicode())) * 1099511628211ull);
+	}
+
+	return hash;
+}
+
+int HashPrefixContentFiltersProfile::getUpdateInterval() const
+{
+	return m_updateInterval;
+}
+
+bool HashPrefixContentFiltersProfile::update()
+{
+	if (m_isUpdating)
+	{
+		return false;
+	}
+
+	if (!m_updateUrl.isValid())
+	{
+		const QString path(getPath());
+
+		m_error = DownloadError;
+
+		if (m_updateUrl.isEmpty())
+		{
+			Console::addMessage(QCoreApplication::translate("main", "Failed to update fraud checking profile, update URL is empty"), Console::OtherCategory, Console::ErrorLevel, path);
+		}
+		else
+		{
+			Console::addMessage(QCoreApplication::translate("main", "Failed to update fraud checking profile, update URL (%1) is invalid").arg(m_updateUrl.toString()), Console::OtherCategory, Console::ErrorLevel, path);
+		}
+
+		return false;
+	}
+
+	QUrl url(m_updateUrl);
+	QUrlQuery query(url);
+	query.addQueryItem(QLatin1String("version"), QString::number(m_version));
+
+	url.setQuery(query);
+
+	m_networkReply = NetworkManagerFactory::createRequest(url);
+
+	connect(m_networkReply, &QNetworkReply::finished, this, &HashPrefixContentFiltersProfile::handleReplyFinished);
+
+	m_isUpdating = true;
+
+	return true;
+}
+
+bool HashPrefixContentFiltersProfile::remove()
+{
+	if (m_networkReply)
+	{
+		m_networkReply->abort();
+		m_networkReply->deleteLater();
+		m_networkReply = nullptr;
+	}
+
+	clear();
+
+	const QString path(getPath());
+
+	if (QFile::exists(path))
+	{
+		return QFile::remove(path);
+	}
+
+	return true;
+}
+
+void HashPrefixContentFiltersProfile::setPrefixes(const QSharedPointer<PrefixesData> &prefixes)
+{
+// declared before the locker, so the previous mapping is released after unlocking, once the last lookup still using it is done
+	QSharedPointer<PrefixesData> previousPrefixes(prefixes);
+	const QWriteLocker locker(&m_prefixesLock);
+
+	m_prefixes.swap(previousPrefixes);
+}
+
+QSharedPointer<HashPrefixContentFiltersProfile::PrefixesData> HashPrefixContentFiltersProfile::getPrefixes()
+{
+	const QReadLocker locker(&m_prefixesLock);
+
+	return m_prefixes;
+}
+
+bool HashPrefixContentFiltersProfile::PrefixesData::hasHash(quint64 hash) const
+{
+	return std::binary_search(hashes, (hashes + hashesAmount), hash);
+}
+
+bool HashPrefixContentFiltersProfile::PrefixesData::hasHostHash(quint64 hash) const
+{
+	return std::binary_search(hostHashes, (hostHashes + hostHashesAmount), hash);
+}
+
+bool HashPrefixContentFiltersProfile::isUpdating() const
+{
+	return m_isUpdating;
+}
+
+bool HashPrefixContentFiltersProfile::isFraud(const QUrl &url)
+{
+	const QSharedPointer<PrefixesData> prefixes(getPrefixes());
+
+	if (!prefixes || prefixes->hashesAmount == 0)
+	{
+		return false;
+	}
+
+// host is stored decoded, so for ASCII hosts this shares its data instead of encoding it again
+	QString host(url.host());
+
+	for (int i = 0; i < host.length(); ++i)
+	{
+		if (host.at(i).unicode() > 127)
+		{
+			host = url.host(QUrl::FullyEncoded);
+
+			break;
+		}
+	}
+
+	int hostLength(host.length());
+
+	while (hostLength > 0 && host.at(hostLength - 1) == QLatin1Char('.'))
+	{
+		--hostLength;
+	}
+
+	if (hostLength == 0)
+	{
+		return false;
+	}
+
+	int hostStarts[5] = {0, 0, 0, 0, 0};
+	int hostStartsAmount(1);
+	bool isAddress(true);
+
+	for (int i = 0; i < hostLength; ++i)
+	{
+		if (!host.at(i).isDigit() && host.at(i) != QLatin1Char('.'))
+		{
+			isAddress = false;
+
+			break;
+		}
+	}
+
+	if (!isAddress)
+	{
+		int dotsAmount(0);
+
+		for (int i = (hostLength - 1); i > 0; --i)
+		{
+			if (host.at(i) == QLatin1Char('.'))
+			{
+				++dotsAmount;
+
+				if (dotsAmount >= 2)
+				{
+					hostStarts[hostStartsAmount] = (i + 1);
+
+					++hostStartsAmount;
+				}
+
+				if (dotsAmount == 5)
+				{
+					break;
+				}
+			}
+		}
+	}
+
+	quint64 hostHashes[5] = {0, 0, 0, 0, 0};
+	int hostHashesAmount(0);
+
+	for (int i = 0; i < hostStartsAmount; ++i)
+	{
+		const quint64 hostHash(hashRange(14695981039346656037ull, host, hostStarts[i], hostLength));
+
+		if (prefixes->hasHostHash(hostHash))
+		{
+			hostHashes[hostHashesAmount] = hostHash;
+
+			++hostHashesAmount;
+		}
+	}
+
+	if (hostHashesAmount == 0)
+	{
+		return false;
+	}
+
+	const QString path(url.path(QUrl::FullyEncoded));
+	const QString query(url.query(QUrl::FullyEncoded));
+	const int pathLength(path.length());
+	int pathEnds[5] = {0, 0, 0, 0, 0};
+	int pathEndsAmount(0);
+
+	for (int i = 0; i < pathLength && pathEndsAmount < 4; ++i)
+	{
+		if (path.at(i) == QLatin1Char('/'))
+		{
+			pathEnds[pathEndsAmount] = (i + 1);
+
+			++pathEndsAmount;
+		}
+	}
+
+	if (pathEndsAmount == 0 || pathEnds[pathEndsAmount - 1] != pathLength)
+	{
+		pathEnds[pathEndsAmount] = pathLength;
+
+		++pathEndsAmount;
+	}
+
+	for (int i = 0; i < hostHashesAmount; ++i)
+	{
+		for (int j = 0; j < pathEndsAmount; ++j)
+		{
+			const quint64 pathHash((pathEnds[j] == 0) ? ((hostHashes[i] ^ static_cast<quint64>('/')) * 1099511628211ull) : hashRange(hostHashes[i], path, 0, pathEnds[j]));
+
+			if (prefixes->hasHash(pathHash))
+			{
+				return true;
+			}
+
+			if (pathEnds[j] == pathLength && !query.isEmpty() && prefixes->hasHash(hashRange(((pathHash ^ static_cast<quint64>('?')) * 1099511628211ull), query, 0, query.length())))
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+}
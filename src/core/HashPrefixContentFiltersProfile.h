@@ -0,0 +1,108 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2018 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_HASHPREFIXCONTENTFILTERSPROFILE_H
+#define OTTER_HASHPREFIXCONTENTFILTERSPROFILE_H
+
+#include "ContentFiltersManager.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QReadWriteLock>
+#include <QtCore/QSharedPointer>
+
+namespace Otter
+{
+
+class HashPrefixContentFiltersProfile final : public ContentFiltersProfile
+{
+	Q_OBJECT
+
+public:
+	explicit HashPrefixContentFiltersProfile(const QString &name, const QString &title, const QUrl &updateUrl, int updateInterval, QObject *parent = nullptr);
+
+	void clear() override;
+	void setCategory(ProfileCategory category) override;
+	void setTitle(const QString &title) override;
+	void setUpdateInterval(int interval) override;
+	void setUpdateUrl(const QUrl &url) override;
+	QString getName() const override;
+	QString getTitle() const override;
+	QUrl getUpdateUrl() const override;
+	QDateTime getLastUpdate() const override;
+	ContentFiltersManager::CheckResult checkUrl(const QUrl &baseUrl, const QUrl &requestUrl, NetworkManager::ResourceType resourceType) override;
+	ProfileError getError() const override;
+	ProfileFlags getFlags() const override;
+	int getUpdateInterval() const override;
+	bool update() override;
+	bool remove() override;
+	bool isUpdating() const override;
+	bool isFraud(const QUrl &url) override;
+
+protected:
+	enum
+	{
+		FileSignature = 0x4F544650,
+		FileFormatVersion = 2,
+		HeaderSize = 6
+	};
+
+	struct HashEntry final
+	{
+		quint64 hash = 0;
+		quint64 hostHash = 0;
+	};
+
+	struct PrefixesData final
+	{
+		QFile file;
+		const quint64 *hashes = nullptr;
+		const quint64 *entryHostHashes = nullptr;
+		const quint64 *hostHashes = nullptr;
+		quint32 hashesAmount = 0;
+		quint32 hostHashesAmount = 0;
+
+		bool hasHash(quint64 hash) const;
+		bool hasHostHash(quint64 hash) const;
+	};
+
+	QString getPath() const;
+	void loadPrefixes();
+	void setPrefixes(const QSharedPointer<PrefixesData> &prefixes);
+	QSharedPointer<PrefixesData> getPrefixes();
+	static quint64 hashRange(quint64 hash, const QString &string, int from, int to);
+
+protected slots:
+	void handleReplyFinished();
+
+private:
+	QNetworkReply *m_networkReply;
+	QString m_name;
+	QString m_title;
+	QUrl m_updateUrl;
+	QSharedPointer<PrefixesData> m_prefixes;
+	QReadWriteLock m_prefixesLock;
+	ProfileError m_error;
+	quint32 m_version;
+	int m_updateInterval;
+	bool m_isUpdating;
+};
+
+}
+
+#endif
@@ -21,9 +21,11 @@
 #include "HistoryManager.h"
 #include "AddonsManager.h"
 #include "Application.h"
+#include "PerformanceMonitor.h"
 #include "SessionsManager.h"
 #include "SettingsManager.h"
 #include "ThemesManager.h"
+#include "TraceRecorder.h"
 
 #include <QtCore/QTimerEvent>
 
@@ -106,6 +108,9 @@ void HistoryManager::scheduleSave()
 
 void HistoryManager::save()
 {
+	const TraceRecorder::Span span("HistoryManager::save");
+	const PerformanceMonitor::FlushSpan flushSpan(PerformanceMonitor::HistoryFlush);
+
 	if (m_browsingHistoryModel)
 	{
 		m_browsingHistoryModel->save(SessionsManager::getWritableDataPath(QLatin1String("browsingHistory.json")));
@@ -23,6 +23,7 @@
 #include "JsonSettings.h"
 #include "SessionsManager.h"
 #include "ThemesManager.h"
+#include "TraceRecorder.h"
 #include "Utils.h"
 
 #include <QtCore/QFile>
@@ -83,6 +84,8 @@ quint64 HistoryModel::Entry::getIdentifier() const
 HistoryModel::HistoryModel(const QString &path, HistoryType type, QObject *parent) : QStandardItemModel(parent),
 	m_type(type)
 {
+	const TraceRecorder::Span span("HistoryModel::HistoryModel");
+
 	QFile file(path);
 
 	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
@@ -295,6 +298,8 @@ HistoryModel::HistoryType HistoryModel::getType() const
 
 bool HistoryModel::save(const QString &path) const
 {
+	const TraceRecorder::Span span("HistoryModel::save");
+
 	if (SessionsManager::isReadOnly())
 	{
 		return false;
@@ -18,6 +18,7 @@
 **************************************************************************/
 
 #include "IniSettings.h"
+#include "TraceRecorder.h"
 
 #include <QtCore/QFile>
 #include <QtCore/QSaveFile>
@@ -195,6 +196,8 @@ QStringList IniSettings::getKeys() const
 
 bool IniSettings::save(const QString &path, bool isAtomic)
 {
+	const TraceRecorder::Span span("IniSettings::save");
+
 	if (path.isEmpty() && m_path.isEmpty())
 	{
 		m_hasError = true;
@@ -62,7 +62,21 @@ void FetchJob::start()
 		return;
 	}
 
-	m_reply = NetworkManagerFactory::createRequest(m_url, QNetworkAccessManager::GetOperation, m_isPrivate);
+	QNetworkRequest request(m_url);
+
+	if (!m_headers.isEmpty())
+	{
+		request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+
+		QMap<QByteArray, QByteArray>::const_iterator iterator;
+
+		for (iterator = m_headers.begin(); iterator != m_headers.end(); ++iterator)
+		{
+			request.setRawHeader(iterator.key(), iterator.value());
+		}
+	}
+
+	m_reply = NetworkManagerFactory::createRequest(request, QNetworkAccessManager::GetOperation, m_isPrivate);
 
 	connect(m_reply, &QNetworkReply::downloadProgress, this, [&](qint64 bytesReceived, qint64 bytesTotal)
 	{
@@ -109,6 +123,11 @@ void FetchJob::markAsFinished()
 	m_isFinished = true;
 }
 
+void FetchJob::setHeader(const QByteArray &name, const QByteArray &value)
+{
+	m_headers[name] = value;
+}
+
 void FetchJob::setTimeout(int seconds)
 {
 	if (m_timeoutTimer != 0)
@@ -156,6 +175,11 @@ QIODevice* DataFetchJob::getData() const
 	return m_reply;
 }
 
+QByteArray DataFetchJob::getHeader(const QByteArray &name) const
+{
+	return m_reply->rawHeader(name);
+}
+
 QMap<QByteArray, QByteArray> DataFetchJob::getHeaders() const
 {
 	QMap<QByteArray, QByteArray> headers;
@@ -169,6 +193,11 @@ QMap<QByteArray, QByteArray> DataFetchJob::getHeaders() const
 	return headers;
 }
 
+bool DataFetchJob::isModified() const
+{
+	return (m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 304);
+}
+
 IconFetchJob::IconFetchJob(const QUrl &url, QObject *parent) : FetchJob(url, parent)
 {
 	setSizeLimit(20480);
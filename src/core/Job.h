@@ -51,6 +51,7 @@ public:
 	explicit FetchJob(const QUrl &url, QObject *parent = nullptr);
 	~FetchJob();
 
+	void setHeader(const QByteArray &name, const QByteArray &value);
 	void setTimeout(int seconds);
 	void setSizeLimit(qint64 limit);
 	void setPrivate(bool isPrivate);
@@ -70,6 +71,7 @@ protected:
 private:
 	QNetworkReply *m_reply;
 	QUrl m_url;
+	QMap<QByteArray, QByteArray> m_headers;
 	qint64 m_sizeLimit;
 	int m_timeoutTimer;
 	bool m_isFinished;
@@ -85,7 +87,9 @@ public:
 	explicit DataFetchJob(const QUrl &url, QObject *parent = nullptr);
 
 	QIODevice* getData() const;
+	QByteArray getHeader(const QByteArray &name) const;
 	QMap<QByteArray, QByteArray> getHeaders() const;
+	bool isModified() const;
 
 protected:
 	void handleSuccessfulReply(QNetworkReply *reply) override;
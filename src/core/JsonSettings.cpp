@@ -18,6 +18,7 @@
 **************************************************************************/
 
 #include "JsonSettings.h"
+#include "TraceRecorder.h"
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
@@ -209,6 +210,8 @@ QString JsonSettings::getComment() const
 
 bool JsonSettings::save(const QString &path, bool isAtomic)
 {
+	const TraceRecorder::Span span("JsonSettings::save");
+
 	if (path.isEmpty() && m_path.isEmpty())
 	{
 		m_hasError = true;
@@ -24,10 +24,9 @@
 #include "ThemesManager.h"
 #include "Utils.h"
 
+#include <QtConcurrent/QtConcurrentRun>
 #include <QtCore/QBuffer>
 #include <QtCore/QDir>
-#include <QtCore/QFileInfo>
-#include <QtCore/QMimeDatabase>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QTimer>
 #include <QtCore/QtMath>
@@ -38,7 +37,9 @@ namespace Otter
 {
 
 LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &request, QObject *parent) : QNetworkReply(parent),
-	m_offset(0)
+	m_watcher(nullptr),
+	m_offset(0),
+	m_isAborted(false)
 {
 	setRequest(request);
 	open(QIODevice::ReadOnly | QIODevice::Unbuffered);
@@ -75,6 +76,8 @@ LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &reques
 
 		QTimer::singleShot(0, this, [&]()
 		{
+			setFinished(true);
+
 			emit listingError();
 			emit readyRead();
 			emit finished();
@@ -83,8 +86,6 @@ LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &reques
 		return;
 	}
 
-	QString entriesHtml;
-	QString specialEntriesHtml;
 	const QRegularExpression entryExpression(QLatin1String("<!--entry:begin-->(.*)<!--entry:end-->"), (QRegularExpression::DotMatchesEverythingOption | QRegularExpression::MultilineOption));
 	QFile file(SessionsManager::getReadableDataPath(QLatin1String("files/listing.html")));
 	file.open(QIODevice::ReadOnly | QIODevice::Text);
@@ -92,18 +93,21 @@ LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &reques
 	QTextStream stream(&file);
 	stream.setCodec("UTF-8");
 
-	QString mainTemplate(stream.readAll());
-	const QString entryTemplate(entryExpression.match(mainTemplate).captured(1));
-	const QFileInfoList entries(directory.entryInfoList((QDir::AllEntries | QDir::Hidden), (QDir::Name | QDir::DirsFirst)));
+	const QString mainTemplate(stream.readAll());
+	const QRegularExpressionMatch match(entryExpression.match(mainTemplate));
+	const QString entryTemplate(match.captured(1));
+	const QString path(directory.path());
+	QString header(match.hasMatch() ? mainTemplate.left(match.capturedStart()) : mainTemplate);
 	QStringList navigation;
 
+	m_footer = (match.hasMatch() ? mainTemplate.mid(match.capturedEnd()) : QString());
+
 	do
 	{
 		navigation.prepend(QStringLiteral("<a href=\"%1\">%2</a>").arg(QUrl::fromUserInput(directory.canonicalPath()).toString()).arg((directory.isRoot() ? QLatin1String("file://") : QString()) + directory.dirName() + QLatin1Char('/')));
 	}
 	while (directory.cdUp());
 
-	QHash<QString, QString> icons;
 	QHash<QString, QString> variables;
 	variables[QLatin1String("title")] = QFileInfo(request.url().toLocalFile()).canonicalFilePath();
 	variables[QLatin1String("description")] = tr("Directory Contents");
@@ -114,85 +118,207 @@ LocalListingNetworkReply::LocalListingNetworkReply(const QNetworkRequest &reques
 	variables[QLatin1String("headerSize")] = tr("Size");
 	variables[QLatin1String("headerDate")] = tr("Date");
 
-	const int iconSize(16 * qCeil(Application::getInstance()->devicePixelRatio()));
-	const QFileIconProvider iconProvider;
+	QHash<QString, QString>::iterator iterator;
 
-	for (int i = 0; i < entries.count(); ++i)
+	for (iterator = variables.begin(); iterator != variables.end(); ++iterator)
 	{
-		const QMimeType mimeType(QMimeDatabase().mimeTypeForFile(entries.at(i).canonicalFilePath()));
-		QString entryHtml(entryTemplate);
+		header.replace(QLatin1Char('{') + iterator.key() + QLatin1Char('}'), iterator.value());
+		m_footer.replace(QLatin1Char('{') + iterator.key() + QLatin1Char('}'), iterator.value());
+	}
 
-		if (!icons.contains(mimeType.name()))
+	m_content = header.toUtf8();
+
+	setHeader(QNetworkRequest::ContentTypeHeader, QVariant(QLatin1String("text/html; charset=UTF-8")));
+
+	QTimer::singleShot(0, this, [&]()
+	{
+		if (!m_isAborted)
 		{
-			QByteArray byteArray;
-			QBuffer buffer(&byteArray);
-			QIcon icon(QIcon::fromTheme(mimeType.iconName(), iconProvider.icon(entries.at(i))));
+			emit readyRead();
+		}
+	});
 
-			if (icon.isNull())
-			{
-				icon = ThemesManager::createIcon((entries.at(i).isDir() ? QLatin1String("inode-directory") : QLatin1String("unknown")), false);
-			}
+	QFutureInterface<EntryInformation> futureInterface;
+	futureInterface.reportStarted();
 
-			icon.pixmap(iconSize, iconSize).save(&buffer, "PNG");
+	m_watcher = new QFutureWatcher<EntryInformation>(this);
+	m_watcher->setFuture(futureInterface.future());
 
-			icons[mimeType.name()] = QString(byteArray.toBase64());
-		}
+	connect(m_watcher, &QFutureWatcher<EntryInformation>::resultsReadyAt, this, &LocalListingNetworkReply::handleEntriesReady);
+	connect(m_watcher, &QFutureWatcher<EntryInformation>::finished, this, &LocalListingNetworkReply::handleListingFinished);
 
-		QHash<QString, QString> entryVariables;
-		entryVariables[QLatin1String("url")] = QUrl::fromUserInput(entries.at(i).filePath()).toString();
-		entryVariables[QLatin1String("icon")] = QStringLiteral("data:image/png;base64,%1").arg(icons[mimeType.name()]);
-		entryVariables[QLatin1String("mimeType")] = mimeType.name();
-		entryVariables[QLatin1String("name")] = entries.at(i).fileName();
-		entryVariables[QLatin1String("comment")] = mimeType.comment();
-		entryVariables[QLatin1String("size")] = (entries.at(i).isDir() ? QString() : Utils::formatUnit(entries.at(i).size(), false, 2));
-		entryVariables[QLatin1String("lastModified")] = Utils::formatDateTime(entries.at(i).lastModified());
+	QtConcurrent::run(&LocalListingNetworkReply::listEntries, futureInterface, path, entryTemplate);
+}
 
-		QHash<QString, QString>::iterator iterator;
+LocalListingNetworkReply::~LocalListingNetworkReply()
+{
+	if (m_watcher)
+	{
+		m_watcher->cancel();
+	}
+}
 
-		for (iterator = entryVariables.begin(); iterator != entryVariables.end(); ++iterator)
-		{
-			entryHtml.replace(QLatin1Char('{') + iterator.key() + QLatin1Char('}'), iterator.value());
-		}
+void LocalListingNetworkReply::appendContent(const QString &content)
+{
+	if (m_offset > 0 && m_offset >= m_content.size())
+	{
+		m_content.clear();
 
-		if (entries.at(i).fileName() == QLatin1String("."))
-		{
-			specialEntriesHtml.prepend(entryHtml);
-		}
-		else if (entries.at(i).fileName() == QLatin1String(".."))
-		{
-			specialEntriesHtml.append(entryHtml);
-		}
-		else
-		{
-			entriesHtml.append(entryHtml);
-		}
+		m_offset = 0;
 	}
 
-	entriesHtml.prepend(specialEntriesHtml);
+	m_content.append(content.toUtf8());
 
-	mainTemplate.replace(entryExpression, entriesHtml);
+	emit readyRead();
+}
 
-	QHash<QString, QString>::iterator iterator;
+void LocalListingNetworkReply::handleEntriesReady(int begin, int end)
+{
+	if (m_isAborted)
+	{
+		return;
+	}
 
-	for (iterator = variables.begin(); iterator != variables.end(); ++iterator)
+	QString entriesHtml;
+
+	for (int i = begin; i < end; ++i)
 	{
-		mainTemplate.replace(QLatin1Char('{') + iterator.key() + QLatin1Char('}'), iterator.value());
+		const EntryInformation entry(m_watcher->resultAt(i));
+		QString entryHtml(entry.html);
+		entryHtml.replace(QLatin1String("{icon}"), getIcon(entry));
+		entryHtml.replace(QLatin1String("{lastModified}"), Utils::formatDateTime(entry.lastModified));
+
+		entriesHtml.append(entryHtml);
 	}
 
-	m_content = mainTemplate.toUtf8();
+	appendContent(entriesHtml);
+}
 
-	setHeader(QNetworkRequest::ContentTypeHeader, QVariant(QLatin1String("text/html; charset=UTF-8")));
-	setHeader(QNetworkRequest::ContentLengthHeader, QVariant(m_content.size()));
+void LocalListingNetworkReply::handleListingFinished()
+{
+	m_watcher->deleteLater();
+	m_watcher = nullptr;
 
-	QTimer::singleShot(0, this, [&]()
+	if (m_isAborted)
 	{
-		emit readyRead();
-		emit finished();
-	});
+		return;
+	}
+
+	appendContent(m_footer);
+
+	m_footer.clear();
+
+	setFinished(true);
+
+	emit readyRead();
+	emit finished();
 }
 
 void LocalListingNetworkReply::abort()
 {
+	if (m_isAborted || isFinished())
+	{
+		return;
+	}
+
+	m_isAborted = true;
+
+	if (m_watcher)
+	{
+		m_watcher->cancel();
+	}
+
+	setError(QNetworkReply::OperationCanceledError, tr("Operation canceled"));
+	setFinished(true);
+
+	emit finished();
+}
+
+QString LocalListingNetworkReply::getIcon(const EntryInformation &entry)
+{
+	if (!m_icons.contains(entry.mimeType))
+	{
+		const int iconSize(16 * qCeil(Application::getInstance()->devicePixelRatio()));
+		const QFileIconProvider iconProvider;
+		QByteArray byteArray;
+		QBuffer buffer(&byteArray);
+		QIcon icon(QIcon::fromTheme(entry.iconName, iconProvider.icon(entry.isDirectory ? QFileIconProvider::Folder : QFileIconProvider::File)));
+
+		if (icon.isNull())
+		{
+			icon = ThemesManager::createIcon((entry.isDirectory ? QLatin1String("inode-directory") : QLatin1String("unknown")), false);
+		}
+
+		icon.pixmap(iconSize, iconSize).save(&buffer, "PNG");
+
+		m_icons[entry.mimeType] = QStringLiteral("data:image/png;base64,%1").arg(QString(byteArray.toBase64()));
+	}
+
+	return m_icons[entry.mimeType];
+}
+
+void LocalListingNetworkReply::listEntries(QFutureInterface<EntryInformation> futureInterface, const QString &path, const QString &entryTemplate)
+{
+	const QMimeDatabase mimeDatabase;
+	const QDir directory(path);
+	QVector<EntryInformation> entries;
+	entries.reserve(50);
+	entries.append(createEntry(QFileInfo(directory, QLatin1String(".")), QLatin1String("."), mimeDatabase, entryTemplate));
+	entries.append(createEntry(QFileInfo(directory, QLatin1String("..")), QLatin1String(".."), mimeDatabase, entryTemplate));
+
+// names are sorted up front, page does not sort entries arriving in batches
+	const QStringList names(directory.entryList((QDir::AllEntries | QDir::Hidden | QDir::NoDotAndDotDot), (QDir::Name | QDir::DirsFirst)));
+	int batchSize(50);
+
+	for (int i = 0; i < names.count() && !futureInterface.isCanceled(); ++i)
+	{
+		entries.append(createEntry(QFileInfo(directory, names.at(i)), names.at(i), mimeDatabase, entryTemplate));
+
+// first batch is kept small to show the beginning of listing quickly, next ones are larger to reduce overhead of updating page
+		if (entries.count() >= batchSize)
+		{
+			futureInterface.reportResults(entries);
+
+			entries.clear();
+
+			batchSize = 500;
+		}
+	}
+
+	if (!entries.isEmpty() && !futureInterface.isCanceled())
+	{
+		futureInterface.reportResults(entries);
+	}
+
+	futureInterface.reportFinished();
+}
+
+LocalListingNetworkReply::EntryInformation LocalListingNetworkReply::createEntry(const QFileInfo &fileInfo, const QString &name, const QMimeDatabase &mimeDatabase, const QString &entryTemplate)
+{
+	const bool isDirectory(fileInfo.isDir());
+	const QMimeType mimeType(isDirectory ? mimeDatabase.mimeTypeForName(QLatin1String("inode/directory")) : mimeDatabase.mimeTypeForFile(name, QMimeDatabase::MatchExtension));
+	QHash<QString, QString> entryVariables;
+	entryVariables[QLatin1String("url")] = QUrl::fromUserInput(fileInfo.filePath()).toString();
+	entryVariables[QLatin1String("mimeType")] = mimeType.name();
+	entryVariables[QLatin1String("name")] = name;
+	entryVariables[QLatin1String("comment")] = mimeType.comment();
+	entryVariables[QLatin1String("size")] = (isDirectory ? QString() : Utils::formatUnit(fileInfo.size(), false, 2));
+
+	EntryInformation entry;
+	entry.html = entryTemplate;
+	entry.mimeType = mimeType.name();
+	entry.iconName = mimeType.iconName();
+	entry.lastModified = fileInfo.lastModified();
+	entry.isDirectory = isDirectory;
+
+	QHash<QString, QString>::iterator iterator;
+
+	for (iterator = entryVariables.begin(); iterator != entryVariables.end(); ++iterator)
+	{
+		entry.html.replace(QLatin1Char('{') + iterator.key() + QLatin1Char('}'), iterator.value());
+	}
+
+	return entry;
 }
 
 qint64 LocalListingNetworkReply::bytesAvailable() const
@@ -213,7 +339,7 @@ qint64 LocalListingNetworkReply::readData(char *data, qint64 maxSize)
 		return number;
 	}
 
-	return -1;
+	return (isFinished() ? -1 : 0);
 }
 
 bool LocalListingNetworkReply::isSequential() const
@@ -21,6 +21,12 @@
 #ifndef OTTER_LOCALLISTINGNETWORKREPLY_H
 #define OTTER_LOCALLISTINGNETWORKREPLY_H
 
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+#include <QtCore/QFutureInterface>
+#include <QtCore/QFutureWatcher>
+#include <QtCore/QHash>
+#include <QtCore/QMimeDatabase>
 #include <QtCore/QUrl>
 #include <QtNetwork/QNetworkReply>
 
@@ -33,6 +39,7 @@ class LocalListingNetworkReply final : public QNetworkReply
 
 public:
 	explicit LocalListingNetworkReply(const QNetworkRequest &request, QObject *parent);
+	~LocalListingNetworkReply();
 
 	qint64 bytesAvailable() const override;
 	qint64 readData(char *data, qint64 maxSize) override;
@@ -41,9 +48,32 @@ public:
 public slots:
 	void abort() override;
 
+protected:
+	struct EntryInformation final
+	{
+		QString html;
+		QString mimeType;
+		QString iconName;
+		QDateTime lastModified;
+		bool isDirectory = false;
+	};
+
+	void appendContent(const QString &content);
+	static void listEntries(QFutureInterface<EntryInformation> futureInterface, const QString &path, const QString &entryTemplate);
+	static EntryInformation createEntry(const QFileInfo &fileInfo, const QString &name, const QMimeDatabase &mimeDatabase, const QString &entryTemplate);
+	QString getIcon(const EntryInformation &entry);
+
+protected slots:
+	void handleEntriesReady(int begin, int end);
+	void handleListingFinished();
+
 private:
+	QFutureWatcher<EntryInformation> *m_watcher;
+	QHash<QString, QString> m_icons;
+	QString m_footer;
 	QByteArray m_content;
 	qint64 m_offset;
+	bool m_isAborted;
 
 signals:
 	void listingError();
@@ -0,0 +1,316 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2018 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "MemoryPressureManager.h"
+#include "ActionsManager.h"
+#include "Application.h"
+#include "Console.h"
+#include "SettingsManager.h"
+#include "Utils.h"
+#include "../ui/MainWindow.h"
+#include "../ui/Window.h"
+
+#include <QtCore/QFile>
+#include <QtCore/QTimerEvent>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+namespace Otter
+{
+
+MemoryPressureManager* MemoryPressureManager::m_instance(nullptr);
+
+MemoryPressureManager::MemoryPressureManager(QObject *parent) : QObject(parent),
+	m_memoryLimit(0),
+	m_suspendedUsage(-1),
+	m_suspendedWindow(0),
+	m_controlGroupUsageLimit(0),
+	m_pressureLimit(0),
+	m_backOffChecks(0),
+	m_remainingChecks(0),
+	m_checkTimer(0),
+	m_isUnderPressure(false)
+{
+	handleOptionChanged(SettingsManager::Browser_MemoryControlGroupUsageLimitOption);
+	handleOptionChanged(SettingsManager::Browser_MemoryPressureLimitOption);
+	handleOptionChanged(SettingsManager::Browser_MemoryUsageLimitOption);
+
+	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &MemoryPressureManager::handleOptionChanged);
+}
+
+void MemoryPressureManager::createInstance()
+{
+	if (!m_instance)
+	{
+		m_instance = new MemoryPressureManager(QCoreApplication::instance());
+	}
+}
+
+void MemoryPressureManager::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() != m_checkTimer)
+	{
+		return;
+	}
+
+	const qint64 usage(getMemoryUsage());
+
+	if (m_suspendedWindow > 0)
+	{
+		const qint64 reclaimed((usage >= 0 && m_suspendedUsage >= 0) ? qMax(qint64(0), (m_suspendedUsage - usage)) : -1);
+
+		Console::addMessage(tr("Suspended tab \"%1\" due to memory pressure, reclaimed %2").arg(m_suspendedTitle).arg(Utils::formatUnit(reclaimed)), Console::OtherCategory, Console::LogLevel, m_suspendedUrl.toString(), -1, m_suspendedWindow);
+
+		m_suspendedTitle.clear();
+		m_suspendedUrl.clear();
+		m_suspendedUsage = -1;
+		m_suspendedWindow = 0;
+
+// memory is probably held elsewhere if suspending did not help, so wait longer before suspending another tab
+		m_backOffChecks = ((reclaimed >= 0 && reclaimed < 1048576) ? qMin(((m_backOffChecks * 2) + 1), 15) : 0);
+		m_remainingChecks = m_backOffChecks;
+
+		return;
+	}
+
+	if (m_remainingChecks > 0)
+	{
+		--m_remainingChecks;
+
+		return;
+	}
+
+	m_isUnderPressure = isUnderPressure(usage, m_isUnderPressure);
+
+	if (!m_isUnderPressure)
+	{
+		m_backOffChecks = 0;
+
+		return;
+	}
+
+	Window *window(findSuspendableWindow());
+
+	if (!window)
+	{
+		return;
+	}
+
+	const QString title(window->getTitle());
+	const QUrl url(window->getUrl());
+
+	window->triggerAction(ActionsManager::SuspendTabAction);
+
+	if (window->getLoadingState() == WebWidget::DeferredLoadingState)
+	{
+		m_suspendedTitle = title;
+		m_suspendedUrl = url;
+		m_suspendedUsage = usage;
+		m_suspendedWindow = window->getIdentifier();
+	}
+}
+
+void MemoryPressureManager::handleOptionChanged(int identifier)
+{
+	switch (identifier)
+	{
+		case SettingsManager::Browser_MemoryControlGroupUsageLimitOption:
+			m_controlGroupUsageLimit = SettingsManager::getOption(identifier).toInt();
+
+			break;
+		case SettingsManager::Browser_MemoryPressureLimitOption:
+			m_pressureLimit = SettingsManager::getOption(identifier).toInt();
+
+			break;
+		case SettingsManager::Browser_MemoryUsageLimitOption:
+			m_memoryLimit = (SettingsManager::getOption(identifier).toLongLong() * 1048576);
+
+			break;
+		default:
+			return;
+	}
+
+	const bool isEnabled(m_memoryLimit > 0 || m_controlGroupUsageLimit > 0 || m_pressureLimit > 0);
+
+	if (isEnabled && m_checkTimer == 0)
+	{
+		m_checkTimer = startTimer(5000);
+	}
+	else if (!isEnabled && m_checkTimer != 0)
+	{
+		killTimer(m_checkTimer);
+
+		m_checkTimer = 0;
+		m_isUnderPressure = false;
+	}
+}
+
+MemoryPressureManager* MemoryPressureManager::getInstance()
+{
+	return m_instance;
+}
+
+Window* MemoryPressureManager::findSuspendableWindow()
+{
+	const QVector<MainWindow*> mainWindows(Application::getWindows());
+	Window *suspendableWindow(nullptr);
+
+	for (int i = 0; i < mainWindows.count(); ++i)
+	{
+		const Window *activeWindow(mainWindows.at(i)->getActiveWindow());
+
+		for (int j = 0; j < mainWindows.at(i)->getWindowCount(); ++j)
+		{
+			Window *window(mainWindows.at(i)->getWindowByIndex(j));
+
+			if (!window || window == activeWindow || window->isAboutToClose() || window->isPinned() || window->isAudible() || window->getLoadingState() == WebWidget::DeferredLoadingState)
+			{
+				continue;
+			}
+
+			if (!suspendableWindow || window->getLastActivity() < suspendableWindow->getLastActivity())
+			{
+				suspendableWindow = window;
+			}
+		}
+	}
+
+	return suspendableWindow;
+}
+
+QString MemoryPressureManager::getControlGroupPath()
+{
+	QFile file(QLatin1String("/proc/self/cgroup"));
+
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		return {};
+	}
+
+	while (!file.atEnd())
+	{
+		const QString line(QString::fromLatin1(file.readLine()).trimmed());
+
+		if (line.startsWith(QLatin1String("0::")))
+		{
+			return QLatin1String("/sys/fs/cgroup") + line.mid(3);
+		}
+	}
+
+	return {};
+}
+
+qint64 MemoryPressureManager::readControlGroupValue(const QString &name)
+{
+	static const QString path(getControlGroupPath());
+
+	if (path.isEmpty())
+	{
+		return -1;
+	}
+
+	QFile file(path + QLatin1Char('/') + name);
+
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		return -1;
+	}
+
+	bool isValid(false);
+	const qint64 value(file.readAll().trimmed().toLongLong(&isValid));
+
+	return (isValid ? value : -1);
+}
+
+qint64 MemoryPressureManager::getMemoryUsage()
+{
+#ifdef Q_OS_LINUX
+	QFile file(QLatin1String("/proc/self/statm"));
+
+	if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		const QList<QByteArray> values(file.readAll().split(' '));
+
+		if (values.count() > 1)
+		{
+			bool isValid(false);
+			const qint64 pages(values.at(1).toLongLong(&isValid));
+
+			if (isValid)
+			{
+				return (pages * static_cast<qint64>(sysconf(_SC_PAGESIZE)));
+			}
+		}
+	}
+#endif
+
+	return -1;
+}
+
+qreal MemoryPressureManager::getMemoryPressure()
+{
+	QFile file(QLatin1String("/proc/pressure/memory"));
+
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text))
+	{
+		return -1;
+	}
+
+	const QList<QByteArray> values(file.readLine().trimmed().split(' '));
+
+	for (int i = 0; i < values.count(); ++i)
+	{
+		if (values.at(i).startsWith("avg10="))
+		{
+			bool isValid(false);
+			const qreal pressure(values.at(i).mid(6).toDouble(&isValid));
+
+			return (isValid ? pressure : -1);
+		}
+	}
+
+	return -1;
+}
+
+bool MemoryPressureManager::isUnderPressure(qint64 usage, bool isReleasing) const
+{
+// once the limit was crossed keep suspending tabs until usage falls noticeably below it, to avoid toggling around the limit
+	const qint64 percentage(isReleasing ? 90 : 100);
+
+	if (m_memoryLimit > 0 && usage > (m_memoryLimit / 100 * percentage))
+	{
+		return true;
+	}
+
+	if (m_controlGroupUsageLimit > 0)
+	{
+		const qint64 controlGroupLimit(readControlGroupValue(QLatin1String("memory.max")));
+
+		if (controlGroupLimit > 0 && readControlGroupValue(QLatin1String("memory.current")) > (controlGroupLimit / 100 * m_controlGroupUsageLimit / 100 * percentage))
+		{
+			return true;
+		}
+	}
+
+	return (m_pressureLimit > 0 && getMemoryPressure() >= (isReleasing ? (m_pressureLimit / 2.0) : m_pressureLimit));
+}
+
+}
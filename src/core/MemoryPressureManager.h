@@ -0,0 +1,71 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2018 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_MEMORYPRESSUREMANAGER_H
+#define OTTER_MEMORYPRESSUREMANAGER_H
+
+#include <QtCore/QObject>
+#include <QtCore/QUrl>
+
+namespace Otter
+{
+
+class Window;
+
+class MemoryPressureManager final : public QObject
+{
+	Q_OBJECT
+
+public:
+	static void createInstance();
+	static MemoryPressureManager* getInstance();
+	static qint64 getMemoryUsage();
+	static qreal getMemoryPressure();
+
+protected:
+	explicit MemoryPressureManager(QObject *parent);
+
+	void timerEvent(QTimerEvent *event) override;
+	static Window* findSuspendableWindow();
+	static QString getControlGroupPath();
+	static qint64 readControlGroupValue(const QString &name);
+	bool isUnderPressure(qint64 usage, bool isReleasing) const;
+
+protected slots:
+	void handleOptionChanged(int identifier);
+
+private:
+	QString m_suspendedTitle;
+	QUrl m_suspendedUrl;
+	qint64 m_memoryLimit;
+	qint64 m_suspendedUsage;
+	quint64 m_suspendedWindow;
+	int m_controlGroupUsageLimit;
+	int m_pressureLimit;
+	int m_backOffChecks;
+	int m_remainingChecks;
+	int m_checkTimer;
+	bool m_isUnderPressure;
+
+	static MemoryPressureManager *m_instance;
+};
+
+}
+
+#endif
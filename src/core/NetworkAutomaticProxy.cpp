@@ -25,8 +25,10 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDate>
+#include <QtCore/QEventLoop>
 #include <QtCore/QFile>
-#include <QtNetwork/QHostInfo>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QTimer>
 #include <QtNetwork/QNetworkInterface>
 
 namespace Otter
@@ -34,26 +36,42 @@ namespace Otter
 
 QStringList PacUtils::m_months = {QLatin1String("jan"), QLatin1String("feb"), QLatin1String("mar"), QLatin1String("apr"), QLatin1String("may"), QLatin1String("jun"), QLatin1String("jul"), QLatin1String("aug"), QLatin1String("sep"), QLatin1String("oct"), QLatin1String("nov"), QLatin1String("dec")};
 QStringList PacUtils::m_days = {QLatin1String("mon"), QLatin1String("tue"), QLatin1String("wed"), QLatin1String("thu"), QLatin1String("fri"), QLatin1String("sat"), QLatin1String("sun")};
+QHash<QString, PacUtils::HostInformation> PacUtils::m_hosts;
+QMutex PacUtils::m_hostsMutex;
 
 PacUtils::PacUtils(QObject *parent) : QObject(parent)
 {
 }
 
-void PacUtils::alert(const QString &message) const
+void PacUtils::alert(const QString &message)
 {
-	Console::addMessage(message, Console::NetworkCategory, Console::WarningLevel);
+	emit alertRequested(message);
 }
 
-QString PacUtils::dnsResolve(const QString &host) const
+void PacUtils::handleHostLookup(const QHostInfo &information)
 {
-	const QHostInfo hostInformation(QHostInfo::fromName(host));
+	HostInformation host;
+	host.expirationTime = (QDateTime::currentMSecsSinceEpoch() + 60000);
 
-	if (hostInformation.error() == QHostInfo::NoError && !hostInformation.addresses().isEmpty())
+	if (information.error() == QHostInfo::NoError && !information.addresses().isEmpty())
 	{
-		return hostInformation.addresses().first().toString();
+		host.address = information.addresses().first();
 	}
 
-	return {};
+	m_hostsMutex.lock();
+	m_hosts[information.hostName()] = host;
+	m_hostsMutex.unlock();
+
+	m_pendingLookups.remove(information.hostName());
+
+	emit hostLookupFinished(information.hostName());
+}
+
+QString PacUtils::dnsResolve(const QString &host)
+{
+	const QHostAddress address(resolveHost(host));
+
+	return (address.isNull() ? QString() : address.toString());
 }
 
 QString PacUtils::myIpAddress() const
@@ -95,9 +113,9 @@ bool PacUtils::isPlainHostName(const QString &host) const
 	return !host.contains(QLatin1Char('.'));
 }
 
-bool PacUtils::isResolvable(const QString &host) const
+bool PacUtils::isResolvable(const QString &host)
 {
-	return (QHostInfo::fromName(host).error() == QHostInfo::NoError);
+	return !resolveHost(host).isNull();
 }
 
 bool PacUtils::localHostOrDomainIs(const QString &host, QString domain) const
@@ -286,87 +304,191 @@ bool PacUtils::timeRange(const QVariant &arg1, const QVariant &arg2, const QVari
 	return false;
 }
 
-bool PacUtils::isInRange(const QVariant &valueOne, const QVariant &valueTwo, const QVariant &actualValue) const
+QHostAddress PacUtils::resolveHost(const QString &host)
 {
-	return (actualValue >= valueOne && actualValue <= valueTwo);
-}
+	const QHostAddress hostAddress(host);
 
-NetworkAutomaticProxy::NetworkAutomaticProxy(const QString &path, QObject *parent) : QObject(parent),
-	m_reply(nullptr),
-	m_path(path),
-	m_isValid(false)
-{
-	m_engine.globalObject().setProperty(QLatin1String("PacUtils"), m_engine.newQObject(new PacUtils(this)));
+	if (!hostAddress.isNull())
+	{
+		return hostAddress;
+	}
+
+	const QString normalizedHost(host.toLower());
+
+	m_hostsMutex.lock();
+
+	if (m_hosts.contains(normalizedHost) && m_hosts[normalizedHost].expirationTime > QDateTime::currentMSecsSinceEpoch())
+	{
+		const QHostAddress address(m_hosts[normalizedHost].address);
 
-	const QStringList functions({QLatin1String("alert"), QLatin1String("dnsResolve"), QLatin1String("myIpAddress"), QLatin1String("dnsDomainLevels"), QLatin1String("isInNet"), QLatin1String("isPlainHostName"), QLatin1String("isResolvable"), QLatin1String("localHostOrDomainIs"), QLatin1String("dnsDomainIs"), QLatin1String("shExpMatch"), QLatin1String("weekdayRange"), QLatin1String("dateRange"), QLatin1String("timeRange")});
+		m_hostsMutex.unlock();
 
-	for (int i = 0; i < functions.count(); ++i)
+		return address;
+	}
+
+	m_hostsMutex.unlock();
+
+	if (!m_pendingLookups.contains(normalizedHost))
 	{
-		m_engine.evaluate(QStringLiteral("function %1() { return PacUtils.%1.apply(null, arguments); }").arg(functions.at(i))).isError();
+		m_pendingLookups.insert(normalizedHost);
+
+		QHostInfo::lookupHost(normalizedHost, this, SLOT(handleHostLookup(QHostInfo)));
 	}
 
+	QEventLoop eventLoop;
+	QTimer timer;
+	timer.setSingleShot(true);
+
+	connect(&timer, &QTimer::timeout, &eventLoop, &QEventLoop::quit);
+	connect(this, &PacUtils::hostLookupFinished, &eventLoop, [&](const QString &lookedUpHost)
+	{
+		if (lookedUpHost == normalizedHost)
+		{
+			eventLoop.quit();
+		}
+	});
+
+	timer.start(2000);
+
+	if (m_pendingLookups.contains(normalizedHost))
+	{
+		eventLoop.exec();
+	}
+
+	QMutexLocker locker(&m_hostsMutex);
+
+	return m_hosts.value(normalizedHost).address;
+}
+
+bool PacUtils::isInRange(const QVariant &valueOne, const QVariant &valueTwo, const QVariant &actualValue) const
+{
+	return (actualValue >= valueOne && actualValue <= valueTwo);
+}
+
+PacEvaluator::PacEvaluator(NetworkAutomaticProxy *proxy) : QObject(),
+	m_proxy(proxy),
+	m_engine(nullptr),
+	m_isEvaluating(false),
+	m_hasPendingScript(false)
+{
 	m_proxies.insert(QLatin1String("ERROR"), QVector<QNetworkProxy>({QNetworkProxy(QNetworkProxy::DefaultProxy)}));
 	m_proxies.insert(QLatin1String("DIRECT"), QVector<QNetworkProxy>({QNetworkProxy(QNetworkProxy::NoProxy)}));
-
-	setPath(path);
 }
 
-void NetworkAutomaticProxy::handleReplyFinished()
+void PacEvaluator::evaluate(const QString &url, const QString &host, const QString &key)
 {
-	if (m_reply->error() == QNetworkReply::NoError && setup(m_reply->readAll()))
+	Query query;
+	query.url = url;
+	query.host = host;
+	query.key = key;
+
+	m_queries.append(query);
+
+// DNS helpers spin a local event loop while waiting for lookups, queries arriving meanwhile are handled by the outermost call
+	if (m_isEvaluating)
 	{
-		m_isValid = true;
+		return;
 	}
-	else
+
+	m_isEvaluating = true;
+
+	while (!m_queries.isEmpty())
 	{
-		Console::addMessage(tr("Failed to load proxy auto-config (PAC): %1").arg(m_reply->errorString()), Console::NetworkCategory, Console::ErrorLevel, m_reply->url().url());
+		if (m_hasPendingScript)
+		{
+			applyScript();
+		}
+
+		const Query currentQuery(m_queries.takeFirst());
+
+		m_proxy->setProxy(currentQuery.key, getProxy(currentQuery.url, currentQuery.host));
 	}
 
-	m_reply->deleteLater();
+	m_isEvaluating = false;
+
+	if (m_hasPendingScript)
+	{
+		applyScript();
+	}
 }
 
-void NetworkAutomaticProxy::setPath(const QString &path)
+void PacEvaluator::setup(const QString &script)
 {
-	if (QFile::exists(path))
+	m_pendingScript = script;
+	m_hasPendingScript = true;
+
+// do not replace script while FindProxyForURL() waits for DNS lookup in nested event loop, it will be applied once evaluation returns
+	if (!m_isEvaluating)
 	{
-		QFile file(path);
+		applyScript();
+	}
+}
 
-		if (file.open(QIODevice::ReadOnly | QIODevice::Text) && setup(file.readAll()))
-		{
-			m_isValid = true;
+void PacEvaluator::applyScript()
+{
+	const QString script(m_pendingScript);
 
-			file.close();
-		}
-		else
+	m_pendingScript.clear();
+	m_hasPendingScript = false;
+
+	if (!m_engine)
+	{
+		m_engine = new QJSEngine(this);
+
+		PacUtils *utils(new PacUtils(this));
+
+		m_engine->globalObject().setProperty(QLatin1String("PacUtils"), m_engine->newQObject(utils));
+
+		connect(utils, &PacUtils::alertRequested, this, &PacEvaluator::alertRequested);
+
+		const QStringList functions({QLatin1String("alert"), QLatin1String("dnsResolve"), QLatin1String("myIpAddress"), QLatin1String("dnsDomainLevels"), QLatin1String("isInNet"), QLatin1String("isPlainHostName"), QLatin1String("isResolvable"), QLatin1String("localHostOrDomainIs"), QLatin1String("dnsDomainIs"), QLatin1String("shExpMatch"), QLatin1String("weekdayRange"), QLatin1String("dateRange"), QLatin1String("timeRange")});
+
+		for (int i = 0; i < functions.count(); ++i)
 		{
-			Console::addMessage(tr("Failed to load proxy auto-config (PAC): %1").arg(file.errorString()), Console::NetworkCategory, Console::ErrorLevel, path);
+			m_engine->evaluate(QStringLiteral("function %1() { return PacUtils.%1.apply(null, arguments); }").arg(functions.at(i))).isError();
 		}
 	}
-	else
+
+	if (m_engine->evaluate(script).isError())
 	{
-		const QUrl url(path);
+		emit setupFinished(false);
 
-		if (url.isValid())
-		{
-			m_reply = NetworkManagerFactory::createRequest(url);
+		return;
+	}
 
-			connect(m_reply, &QNetworkReply::finished, this, &NetworkAutomaticProxy::handleReplyFinished);
-		}
-		else
-		{
-			Console::addMessage(tr("Failed to load proxy auto-config (PAC). Invalid URL: %1").arg(url.url()), Console::NetworkCategory, Console::ErrorLevel);
-		}
+	m_findProxy = m_engine->globalObject().property(QLatin1String("FindProxyForURL"));
+
+// proxies named by the script are used for hosts without decision yet, so these are never connected directly
+	const QRegularExpression expression(QLatin1String("(PROXY|SOCKS)\\s+([\\w\\.\\-]+):(\\d+)"), QRegularExpression::CaseInsensitiveOption);
+	QRegularExpressionMatchIterator iterator(expression.globalMatch(script));
+	QVector<QNetworkProxy> proxies;
+
+	while (iterator.hasNext())
+	{
+		const QRegularExpressionMatch match(iterator.next());
+
+		proxies.append(QNetworkProxy(((match.captured(1).compare(QLatin1String("SOCKS"), Qt::CaseInsensitive) == 0) ? QNetworkProxy::Socks5Proxy : QNetworkProxy::HttpProxy), match.captured(2), match.captured(3).toUShort()));
 	}
-}
 
-QString NetworkAutomaticProxy::getPath() const
-{
-	return m_path;
+// script without any proxy can only connect directly
+	if (proxies.isEmpty())
+	{
+		proxies.append(QNetworkProxy(QNetworkProxy::NoProxy));
+	}
+
+	m_proxy->setFallbackProxies(proxies);
+
+	emit setupFinished(m_findProxy.isCallable());
 }
 
-QVector<QNetworkProxy> NetworkAutomaticProxy::getProxy(const QString &url, const QString &host)
+QVector<QNetworkProxy> PacEvaluator::getProxy(const QString &url, const QString &host)
 {
-	const QJSValue result(m_findProxy.call(QJSValueList({m_engine.toScriptValue(url), m_engine.toScriptValue(host)})));
+	if (!m_engine || !m_findProxy.isCallable())
+	{
+		return m_proxies[QLatin1String("ERROR")];
+	}
+
+	const QJSValue result(m_findProxy.call(QJSValueList({m_engine->toScriptValue(url), m_engine->toScriptValue(host)})));
 
 	if (result.isError())
 	{
@@ -411,7 +533,7 @@ QVector<QNetworkProxy> NetworkAutomaticProxy::getProxy(const QString &url, const
 			continue;
 		}
 
-		Console::addMessage(QCoreApplication::translate("main", "Failed to parse entry of proxy auto-config (PAC): %1").arg(proxies.at(i)), Console::NetworkCategory, Console::ErrorLevel);
+		emit errorOccurred(QCoreApplication::translate("main", "Failed to parse entry of proxy auto-config (PAC): %1").arg(proxies.at(i)));
 
 		return m_proxies[QLatin1String("ERROR")];
 	}
@@ -421,21 +543,188 @@ QVector<QNetworkProxy> NetworkAutomaticProxy::getProxy(const QString &url, const
 	return m_proxies[configuration];
 }
 
-bool NetworkAutomaticProxy::isValid() const
+NetworkAutomaticProxy::NetworkAutomaticProxy(const QString &path, QObject *parent) : QObject(parent),
+	m_reply(nullptr),
+	m_evaluator(new PacEvaluator(this)),
+	m_path(path),
+	m_isLoading(false),
+	m_isValid(false)
 {
-	return m_isValid;
+	m_evaluator->moveToThread(&m_evaluatorThread);
+	m_evaluatorThread.start();
+
+	connect(m_evaluator, &PacEvaluator::alertRequested, this, [&](const QString &message)
+	{
+		Console::addMessage(message, Console::NetworkCategory, Console::WarningLevel);
+	});
+	connect(m_evaluator, &PacEvaluator::errorOccurred, this, [&](const QString &message)
+	{
+		Console::addMessage(message, Console::NetworkCategory, Console::ErrorLevel);
+	});
+	connect(m_evaluator, &PacEvaluator::setupFinished, this, [&](bool isSuccess)
+	{
+		m_isLoading = false;
+		m_isValid = isSuccess;
+
+		if (!isSuccess)
+		{
+			Console::addMessage(tr("Failed to load proxy auto-config (PAC). Invalid script."), Console::NetworkCategory, Console::ErrorLevel, m_path);
+		}
+	});
+
+	setPath(path);
+}
+
+NetworkAutomaticProxy::~NetworkAutomaticProxy()
+{
+	m_evaluatorThread.quit();
+	m_evaluatorThread.wait();
+
+	delete m_evaluator;
 }
 
-bool NetworkAutomaticProxy::setup(const QString &script)
+void NetworkAutomaticProxy::handleReplyFinished()
 {
-	if (m_engine.evaluate(script).isError())
+	if (m_reply->error() == QNetworkReply::NoError)
+	{
+		setup(m_reply->readAll());
+	}
+	else
 	{
-		return false;
+		m_isLoading = false;
+
+		Console::addMessage(tr("Failed to load proxy auto-config (PAC): %1").arg(m_reply->errorString()), Console::NetworkCategory, Console::ErrorLevel, m_reply->url().url());
 	}
 
-	m_findProxy = m_engine.globalObject().property(QLatin1String("FindProxyForURL"));
+	m_reply->deleteLater();
+}
+
+void NetworkAutomaticProxy::setPath(const QString &path)
+{
+	m_path = path;
+	m_isLoading = true;
+	m_isValid = false;
 
-	return m_findProxy.isCallable();
+// keep previous results as fallback until the new script evaluates them again
+	m_proxiesMutex.lock();
+
+	QHash<QString, ProxyInformation>::iterator iterator;
+
+	for (iterator = m_proxies.begin(); iterator != m_proxies.end(); ++iterator)
+	{
+		iterator.value().expirationTime = 0;
+	}
+
+	m_proxiesMutex.unlock();
+
+	if (QFile::exists(path))
+	{
+		QFile file(path);
+
+		if (file.open(QIODevice::ReadOnly | QIODevice::Text))
+		{
+			setup(file.readAll());
+
+			file.close();
+		}
+		else
+		{
+			m_isLoading = false;
+
+			Console::addMessage(tr("Failed to load proxy auto-config (PAC): %1").arg(file.errorString()), Console::NetworkCategory, Console::ErrorLevel, path);
+		}
+	}
+	else
+	{
+		const QUrl url(path);
+
+		if (url.isValid())
+		{
+			m_reply = NetworkManagerFactory::createRequest(url);
+
+			connect(m_reply, &QNetworkReply::finished, this, &NetworkAutomaticProxy::handleReplyFinished);
+		}
+		else
+		{
+			m_isLoading = false;
+
+			Console::addMessage(tr("Failed to load proxy auto-config (PAC). Invalid URL: %1").arg(url.url()), Console::NetworkCategory, Console::ErrorLevel);
+		}
+	}
+}
+
+QString NetworkAutomaticProxy::getPath() const
+{
+	return m_path;
+}
+
+void NetworkAutomaticProxy::setProxy(const QString &key, const QVector<QNetworkProxy> &proxies)
+{
+	QMutexLocker locker(&m_proxiesMutex);
+	ProxyInformation &information(m_proxies[key]);
+	information.proxies = proxies;
+	information.expirationTime = (QDateTime::currentMSecsSinceEpoch() + 300000);
+	information.isPending = false;
+
+	for (int i = 0; i < proxies.count(); ++i)
+	{
+		if (proxies.at(i).type() == QNetworkProxy::HttpProxy || proxies.at(i).type() == QNetworkProxy::Socks5Proxy)
+		{
+			m_fallbackProxies = proxies;
+
+			break;
+		}
+	}
+}
+
+void NetworkAutomaticProxy::setFallbackProxies(const QVector<QNetworkProxy> &proxies)
+{
+	QMutexLocker locker(&m_proxiesMutex);
+
+	m_fallbackProxies = proxies;
+}
+
+QVector<QNetworkProxy> NetworkAutomaticProxy::getProxy(const QString &url, const QString &host, const QString &scheme)
+{
+	const QString key(scheme + QLatin1String("://") + host.toLower());
+	QMutexLocker locker(&m_proxiesMutex);
+	ProxyInformation &information(m_proxies[key]);
+
+	if (m_isValid && !information.isPending && information.expirationTime < QDateTime::currentMSecsSinceEpoch())
+	{
+		information.isPending = true;
+
+		QMetaObject::invokeMethod(m_evaluator, "evaluate", Qt::QueuedConnection, Q_ARG(QString, url), Q_ARG(QString, host), Q_ARG(QString, key));
+	}
+
+// never wait for the script, it might be blocked by DNS lookups; use previous result until it is evaluated
+	if (!information.proxies.isEmpty())
+	{
+		return information.proxies;
+	}
+
+// connecting directly could bypass the proxy required by the network, so without any known proxy the request fails instead
+	if (m_fallbackProxies.isEmpty())
+	{
+		return {QNetworkProxy(QNetworkProxy::HttpProxy)};
+	}
+
+	return m_fallbackProxies;
+}
+
+bool NetworkAutomaticProxy::isLoading() const
+{
+	return m_isLoading;
+}
+
+bool NetworkAutomaticProxy::isValid() const
+{
+	return m_isValid;
+}
+
+void NetworkAutomaticProxy::setup(const QString &script)
+{
+	QMetaObject::invokeMethod(m_evaluator, "setup", Qt::QueuedConnection, Q_ARG(QString, script));
 }
 
 }
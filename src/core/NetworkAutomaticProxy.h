@@ -21,6 +21,10 @@
 #ifndef OTTER_NETWORKAUTOMATICPROXY_H
 #define OTTER_NETWORKAUTOMATICPROXY_H
 
+#include <QtCore/QMutex>
+#include <QtCore/QSet>
+#include <QtCore/QThread>
+#include <QtNetwork/QHostInfo>
 #include <QtNetwork/QNetworkProxy>
 #include <QtNetwork/QNetworkReply>
 #include <QtQml/QJSEngine>
@@ -28,6 +32,8 @@
 namespace Otter
 {
 
+class NetworkAutomaticProxy;
+
 class PacUtils final : public QObject
 {
 	Q_OBJECT
@@ -36,13 +42,13 @@ public:
 	explicit PacUtils(QObject *parent = nullptr);
 
 public slots:
-	void alert(const QString &message) const;
-	QString dnsResolve(const QString &host) const;
+	void alert(const QString &message);
+	QString dnsResolve(const QString &host);
 	QString myIpAddress() const;
 	int dnsDomainLevels(const QString &host) const;
 	bool isInNet(const QString &host, const QString &pattern, const QString &mask) const;
 	bool isPlainHostName(const QString &host) const;
-	bool isResolvable(const QString &host) const;
+	bool isResolvable(const QString &host);
 	bool localHostOrDomainIs(const QString &host, QString domain) const;
 	bool dnsDomainIs(const QString &host, const QString &domain) const;
 	bool shExpMatch(const QString &string, const QString &expression) const;
@@ -51,11 +57,67 @@ public slots:
 	bool timeRange(const QVariant &arg1, const QVariant &arg2, const QVariant &arg3, const QVariant &arg4, const QVariant &arg5, const QVariant &arg6, const QString &gmt = QLatin1String("gmt")) const;
 
 protected:
+	QHostAddress resolveHost(const QString &host);
 	bool isInRange(const QVariant &valueOne, const QVariant &valueTwo, const QVariant &actualValue) const;
 
+protected slots:
+	void handleHostLookup(const QHostInfo &information);
+
 private:
+	struct HostInformation final
+	{
+		QHostAddress address;
+		qint64 expirationTime = 0;
+	};
+
+	QSet<QString> m_pendingLookups;
+
 	static QStringList m_months;
 	static QStringList m_days;
+	static QHash<QString, HostInformation> m_hosts;
+	static QMutex m_hostsMutex;
+
+signals:
+	void alertRequested(const QString &message);
+	void hostLookupFinished(const QString &host);
+};
+
+class PacEvaluator final : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit PacEvaluator(NetworkAutomaticProxy *proxy);
+
+public slots:
+	void evaluate(const QString &url, const QString &host, const QString &key);
+	void setup(const QString &script);
+
+protected:
+	void applyScript();
+	QVector<QNetworkProxy> getProxy(const QString &url, const QString &host);
+
+private:
+	struct Query final
+	{
+		QString url;
+		QString host;
+		QString key;
+	};
+
+	NetworkAutomaticProxy *m_proxy;
+	QJSEngine *m_engine;
+	QJSValue m_findProxy;
+	QString m_pendingScript;
+	QVector<Query> m_queries;
+	QHash<QString, QVector<QNetworkProxy> > m_proxies;
+	bool m_isEvaluating;
+	bool m_hasPendingScript;
+
+signals:
+	void alertRequested(const QString &message);
+	void errorOccurred(const QString &message);
+	void setupFinished(bool isSuccess);
 };
 
 class NetworkAutomaticProxy final : public QObject
@@ -64,25 +126,41 @@ class NetworkAutomaticProxy final : public QObject
 
 public:
 	explicit NetworkAutomaticProxy(const QString &path, QObject *parent = nullptr);
+	~NetworkAutomaticProxy();
 
 	void setPath(const QString &path);
 	QString getPath() const;
-	QVector<QNetworkProxy> getProxy(const QString &url, const QString &host);
+	QVector<QNetworkProxy> getProxy(const QString &url, const QString &host, const QString &scheme);
+	bool isLoading() const;
 	bool isValid() const;
 
 protected:
-	bool setup(const QString &script);
+	struct ProxyInformation final
+	{
+		QVector<QNetworkProxy> proxies;
+		qint64 expirationTime = 0;
+		bool isPending = false;
+	};
+
+	void setProxy(const QString &key, const QVector<QNetworkProxy> &proxies);
+	void setFallbackProxies(const QVector<QNetworkProxy> &proxies);
+	void setup(const QString &script);
 
 protected slots:
 	void handleReplyFinished();
 
 private:
 	QNetworkReply *m_reply;
-	QJSEngine m_engine;
-	QJSValue m_findProxy;
+	PacEvaluator *m_evaluator;
+	QThread m_evaluatorThread;
 	QString m_path;
-	QHash<QString, QVector<QNetworkProxy> > m_proxies;
+	QVector<QNetworkProxy> m_fallbackProxies;
+	QHash<QString, ProxyInformation> m_proxies;
+	QMutex m_proxiesMutex;
+	bool m_isLoading;
 	bool m_isValid;
+
+friend class PacEvaluator;
 };
 
 }
@@ -201,6 +201,7 @@ public:
 	static NetworkCache* getCache();
 	static CookieJar* getCookieJar();
 	static QNetworkReply* createRequest(const QUrl &url, QNetworkAccessManager::Operation operation = QNetworkAccessManager::GetOperation, bool isPrivate = false, QIODevice *outgoingData = nullptr);
+	static QNetworkReply* createRequest(const QNetworkRequest &request, QNetworkAccessManager::Operation operation = QNetworkAccessManager::GetOperation, bool isPrivate = false, QIODevice *outgoingData = nullptr);
 	static QString getAcceptLanguage();
 	static QString getUserAgent();
 	static QStringList getProxies();
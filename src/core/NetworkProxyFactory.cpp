@@ -142,9 +142,10 @@ QList<QNetworkProxy> NetworkProxyFactory::queryProxy(const QNetworkProxyQuery &q
 
 			break;
 		case ProxyDefinition::AutomaticProxy:
-			if (m_automaticProxy && m_automaticProxy->isValid())
+// script itself is still fetched using system settings
+			if (m_automaticProxy && (m_automaticProxy->isValid() || (m_automaticProxy->isLoading() && query.url() != QUrl(m_automaticProxy->getPath()))))
 			{
-				return m_automaticProxy->getProxy(query.url().toString(), query.peerHostName()).toList();
+				return m_automaticProxy->getProxy(query.url().toString(), query.peerHostName(), query.protocolTag().toLower()).toList();
 			}
 
 			return QNetworkProxyFactory::systemProxyForQuery(query);
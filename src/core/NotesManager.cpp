@@ -66,13 +66,17 @@ void NotesManager::scheduleSave()
 
 NotesManager* NotesManager::getInstance()
 {
+	createInstance();
+
 	return m_instance;
 }
 
 BookmarksModel* NotesManager::getModel()
 {
-	if (!m_model && m_instance)
+	if (!m_model)
 	{
+		createInstance();
+
 		m_model = new BookmarksModel(SessionsManager::getWritableDataPath(QLatin1String("notes.xbel")), BookmarksModel::NotesMode, m_instance);
 
 		connect(m_model, &BookmarksModel::modelModified, m_instance, &NotesManager::scheduleSave);
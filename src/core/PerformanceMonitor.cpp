@@ -0,0 +1,147 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2018 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "PerformanceMonitor.h"
+
+namespace Otter
+{
+
+QMutex PerformanceMonitor::m_mutex;
+QHash<QString, QSharedPointer<PerformanceMonitor::ContentFiltersCounters> > PerformanceMonitor::m_contentFiltersCounters;
+PerformanceMonitor::FlushStatistics PerformanceMonitor::m_flushStatistics[FlushTypesAmount];
+QAtomicInt PerformanceMonitor::m_settingsLookups(0);
+
+PerformanceMonitor::FlushSpan::FlushSpan(FlushType type) :
+	m_type(type)
+{
+	m_timer.start();
+}
+
+PerformanceMonitor::FlushSpan::~FlushSpan()
+{
+	addFlush(m_type, m_timer.nsecsElapsed());
+}
+
+void PerformanceMonitor::addContentFiltersCheck(const QString &profile, qint64 duration)
+{
+	int bucket(0);
+
+	while (bucket < (LatencyBucketsAmount - 1) && duration >= getLatencyBucketLimit(bucket))
+	{
+		++bucket;
+	}
+
+	ContentFiltersCounters *counters(getContentFiltersCounters(profile));
+	counters->totalDuration.fetchAndAddRelaxed(duration);
+	counters->checks.fetchAndAddRelaxed(1);
+	counters->latencies[bucket].fetchAndAddRelaxed(1);
+}
+
+void PerformanceMonitor::addFlush(FlushType type, qint64 duration)
+{
+	QMutexLocker locker(&m_mutex);
+	FlushStatistics &statistics(m_flushStatistics[type]);
+	statistics.lastDuration = duration;
+	statistics.maximumDuration = qMax(statistics.maximumDuration, duration);
+	statistics.totalDuration += duration;
+
+	++statistics.amount;
+}
+
+void PerformanceMonitor::addSettingsLookup()
+{
+	m_settingsLookups.fetchAndAddRelaxed(1);
+}
+
+QVector<PerformanceMonitor::ContentFiltersStatistics> PerformanceMonitor::getContentFiltersStatistics()
+{
+	QMutexLocker locker(&m_mutex);
+	QVector<ContentFiltersStatistics> statistics;
+	statistics.reserve(m_contentFiltersCounters.count());
+
+	QHash<QString, QSharedPointer<ContentFiltersCounters> >::const_iterator iterator;
+
+	for (iterator = m_contentFiltersCounters.constBegin(); iterator != m_contentFiltersCounters.constEnd(); ++iterator)
+	{
+		ContentFiltersStatistics profileStatistics;
+		profileStatistics.profile = iterator.key();
+		profileStatistics.totalDuration = iterator.value()->totalDuration.load();
+		profileStatistics.checks = iterator.value()->checks.load();
+
+		for (int i = 0; i < LatencyBucketsAmount; ++i)
+		{
+			profileStatistics.latencies[i] = iterator.value()->latencies[i].load();
+		}
+
+		statistics.append(profileStatistics);
+	}
+
+	return statistics;
+}
+
+PerformanceMonitor::ContentFiltersCounters* PerformanceMonitor::getContentFiltersCounters(const QString &profile)
+{
+// counters are never removed, so each thread can keep its own lookup table and only lock on first use of a profile
+	thread_local QHash<QString, ContentFiltersCounters*> cache;
+	ContentFiltersCounters *counters(cache.value(profile));
+
+	if (counters)
+	{
+		return counters;
+	}
+
+	QMutexLocker locker(&m_mutex);
+
+	if (!m_contentFiltersCounters.contains(profile))
+	{
+		m_contentFiltersCounters[profile] = QSharedPointer<ContentFiltersCounters>(new ContentFiltersCounters());
+	}
+
+	counters = m_contentFiltersCounters[profile].data();
+
+	cache[profile] = counters;
+
+	return counters;
+}
+
+PerformanceMonitor::FlushStatistics PerformanceMonitor::getFlushStatistics(FlushType type)
+{
+	QMutexLocker locker(&m_mutex);
+
+	return m_flushStatistics[type];
+}
+
+qint64 PerformanceMonitor::getLatencyBucketLimit(int bucket)
+{
+	qint64 limit(10000);
+
+	for (int i = 0; i < bucket; ++i)
+	{
+		limit *= 10;
+	}
+
+	return limit;
+}
+
+quint32 PerformanceMonitor::getSettingsLookups()
+{
+	return static_cast<quint32>(m_settingsLookups.load());
+}
+
+}
@@ -0,0 +1,104 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2018 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_PERFORMANCEMONITOR_H
+#define OTTER_PERFORMANCEMONITOR_H
+
+#include <QtCore/QAtomicInt>
+#include <QtCore/QAtomicInteger>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QVector>
+
+namespace Otter
+{
+
+class PerformanceMonitor final
+{
+public:
+	enum FlushType
+	{
+		BookmarksFlush = 0,
+		CookiesFlush,
+		HistoryFlush,
+		SessionFlush,
+		FlushTypesAmount
+	};
+
+	enum
+	{
+		LatencyBucketsAmount = 5
+	};
+
+	class FlushSpan final
+	{
+	public:
+		explicit FlushSpan(FlushType type);
+		~FlushSpan();
+
+	private:
+		QElapsedTimer m_timer;
+		FlushType m_type;
+	};
+
+	struct ContentFiltersStatistics final
+	{
+		QString profile;
+		qint64 totalDuration = 0;
+		quint64 checks = 0;
+		quint64 latencies[LatencyBucketsAmount] = {};
+	};
+
+	struct FlushStatistics final
+	{
+		qint64 lastDuration = -1;
+		qint64 maximumDuration = 0;
+		qint64 totalDuration = 0;
+		quint64 amount = 0;
+	};
+
+	static void addContentFiltersCheck(const QString &profile, qint64 duration);
+	static void addFlush(FlushType type, qint64 duration);
+	static void addSettingsLookup();
+	static QVector<ContentFiltersStatistics> getContentFiltersStatistics();
+	static FlushStatistics getFlushStatistics(FlushType type);
+	static qint64 getLatencyBucketLimit(int bucket);
+	static quint32 getSettingsLookups();
+
+private:
+	struct ContentFiltersCounters final
+	{
+		QAtomicInteger<qint64> totalDuration;
+		QAtomicInteger<quint64> checks;
+		QAtomicInteger<quint64> latencies[LatencyBucketsAmount];
+	};
+
+	static ContentFiltersCounters* getContentFiltersCounters(const QString &profile);
+
+	static QMutex m_mutex;
+	static QHash<QString, QSharedPointer<ContentFiltersCounters> > m_contentFiltersCounters;
+	static FlushStatistics m_flushStatistics[FlushTypesAmount];
+	static QAtomicInt m_settingsLookups;
+};
+
+}
+
+#endif
@@ -23,6 +23,8 @@
 #include "../ui/MainWindow.h"
 #include "../ui/Window.h"
 
+#include <QtCore/QTimerEvent>
+
 namespace Otter
 {
 
@@ -88,7 +90,9 @@ QVariant SessionItem::data(int role) const
 }
 
 MainWindowSessionItem::MainWindowSessionItem(MainWindow *mainWindow) : SessionItem(),
-	m_mainWindow(mainWindow)
+	m_mainWindow(mainWindow),
+	m_updateTimer(0),
+	m_isMainWindowModified(false)
 {
 	for (int i = 0; i < mainWindow->getWindowCount(); ++i)
 	{
@@ -106,35 +110,140 @@ MainWindowSessionItem::MainWindowSessionItem(MainWindow *mainWindow) : SessionIt
 	connect(mainWindow, &MainWindow::windowRemoved, this, &MainWindowSessionItem::handleWindowRemoved);
 }
 
-void MainWindowSessionItem::handleWindowAdded(quint64 identifier)
+void MainWindowSessionItem::timerEvent(QTimerEvent *event)
 {
-	for (int i = 0; i < rowCount(); ++i)
+	if (event->timerId() == m_updateTimer)
 	{
-		if (index().child(i, 0).data(SessionModel::IdentifierRole).toULongLong() == identifier)
+		killTimer(m_updateTimer);
+
+		m_updateTimer = 0;
+
+		if (m_isMainWindowModified)
 		{
-			return;
+			m_isMainWindowModified = false;
+
+			emitDataChanged();
 		}
+
+		if (!m_modifiedWindows.isEmpty())
+		{
+			for (int i = 0; i < rowCount(); ++i)
+			{
+				WindowSessionItem *windowItem(static_cast<WindowSessionItem*>(child(i, 0)));
+
+				if (windowItem && m_modifiedWindows.contains(windowItem->data(SessionModel::IdentifierRole).toULongLong()))
+				{
+					windowItem->emitDataChanged();
+				}
+			}
+
+			m_modifiedWindows.clear();
+		}
+	}
+	else
+	{
+		QObject::timerEvent(event);
+	}
+}
+
+void MainWindowSessionItem::scheduleUpdate()
+{
+	if (m_updateTimer == 0)
+	{
+		m_updateTimer = startTimer(16);
 	}
+}
 
-	insertRow(m_mainWindow->getWindowIndex(identifier), new WindowSessionItem(m_mainWindow->getWindowByIdentifier(identifier)));
+void MainWindowSessionItem::handleWindowAdded(quint64 identifier)
+{
+	if (getWindowItem(identifier))
+	{
+		return;
+	}
+
+	Window *window(m_mainWindow->getWindowByIdentifier(identifier));
+
+	if (!window)
+	{
+		return;
+	}
+
+	WindowSessionItem *windowItem(new WindowSessionItem(window));
+	windowItem->m_thumbnail = window->createThumbnail();
+
+	insertRow(m_mainWindow->getWindowIndex(identifier), windowItem);
+
+	connect(window, &Window::titleChanged, this, &MainWindowSessionItem::handleWindowModified);
+	connect(window, &Window::urlChanged, this, &MainWindowSessionItem::handleWindowModified);
+	connect(window, &Window::iconChanged, this, &MainWindowSessionItem::handleWindowModified);
+	connect(window, &Window::thumbnailChanged, this, &MainWindowSessionItem::handleWindowThumbnailChanged);
+	connect(window, &Window::loadingStateChanged, this, &MainWindowSessionItem::handleWindowModified);
+	connect(window, &Window::zoomChanged, this, &MainWindowSessionItem::handleWindowModified);
+	connect(window, &Window::isPinnedChanged, this, &MainWindowSessionItem::handleWindowModified);
 }
 
 void MainWindowSessionItem::handleWindowRemoved(quint64 identifier)
 {
 	for (int i = 0; i < rowCount(); ++i)
 	{
-		if (index().child(i, 0).data(SessionModel::IdentifierRole).toULongLong() == identifier)
+		const WindowSessionItem *windowItem(static_cast<WindowSessionItem*>(child(i, 0)));
+
+		if (windowItem && windowItem->data(SessionModel::IdentifierRole).toULongLong() == identifier)
 		{
+			const Window *window(windowItem->getActiveWindow());
+
+			if (window)
+			{
+				disconnect(window, nullptr, this, nullptr);
+			}
+
 			removeRow(i);
 
 			break;
 		}
 	}
+
+	m_modifiedWindows.remove(identifier);
+}
+
+void MainWindowSessionItem::handleWindowModified()
+{
+	const Window *window(qobject_cast<Window*>(sender()));
+
+	if (window)
+	{
+		m_modifiedWindows.insert(window->getIdentifier());
+
+		scheduleUpdate();
+	}
+}
+
+void MainWindowSessionItem::handleWindowThumbnailChanged()
+{
+	const Window *window(qobject_cast<Window*>(sender()));
+
+	if (!window)
+	{
+		return;
+	}
+
+	WindowSessionItem *windowItem(getWindowItem(window->getIdentifier()));
+
+	if (windowItem)
+	{
+		windowItem->m_thumbnail = window->createThumbnail();
+
+		m_modifiedWindows.insert(window->getIdentifier());
+
+		scheduleUpdate();
+	}
 }
 
 void MainWindowSessionItem::notifyMainWindowModified()
 {
-	emitDataChanged();
+	m_isMainWindowModified = true;
+
+	scheduleUpdate();
 }
 
 Window* MainWindowSessionItem::getActiveWindow() const
@@ -147,6 +256,21 @@ MainWindow* MainWindowSessionItem::getMainWindow() const
 	return m_mainWindow;
 }
 
+WindowSessionItem* MainWindowSessionItem::getWindowItem(quint64 identifier) const
+{
+	for (int i = 0; i < rowCount(); ++i)
+	{
+		WindowSessionItem *windowItem(static_cast<WindowSessionItem*>(child(i, 0)));
+
+		if (windowItem && windowItem->data(SessionModel::IdentifierRole).toULongLong() == identifier)
+		{
+			return windowItem;
+		}
+	}
+
+	return nullptr;
+}
+
 QVariant MainWindowSessionItem::data(int role) const
 {
 	if (!m_mainWindow)
@@ -217,6 +341,8 @@ QVariant WindowSessionItem::data(int role) const
 			}
 		case SessionModel::LastActivityRole:
 			return m_window->getLastActivity();
+		case SessionModel::ThumbnailRole:
+			return m_thumbnail;
 		case SessionModel::ZoomRole:
 			return m_window->getZoom();
 		case SessionModel::IsActiveRole:
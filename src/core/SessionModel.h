@@ -21,6 +21,8 @@
 #define OTTER_SESSIONMODEL_H
 
 #include <QtCore/QPointer>
+#include <QtCore/QSet>
+#include <QtGui/QPixmap>
 #include <QtGui/QStandardItemModel>
 
 namespace Otter
@@ -28,6 +30,7 @@ namespace Otter
 
 class MainWindow;
 class Window;
+class WindowSessionItem;
 
 class SessionItem : public QStandardItem
 {
@@ -53,13 +56,22 @@ public:
 protected:
 	explicit MainWindowSessionItem(MainWindow *mainWindow);
 
+	void timerEvent(QTimerEvent *event) override;
+	void scheduleUpdate();
+	WindowSessionItem* getWindowItem(quint64 identifier) const;
+
 protected slots:
 	void handleWindowAdded(quint64 identifier);
 	void handleWindowRemoved(quint64 identifier);
+	void handleWindowModified();
+	void handleWindowThumbnailChanged();
 	void notifyMainWindowModified();
 
 private:
 	QPointer<MainWindow> m_mainWindow;
+	QSet<quint64> m_modifiedWindows;
+	int m_updateTimer;
+	bool m_isMainWindowModified;
 
 friend class SessionModel;
 };
@@ -75,6 +87,7 @@ protected:
 
 private:
 	QPointer<Window> m_window;
+	QPixmap m_thumbnail;
 
 friend class MainWindowSessionItem;
 };
@@ -103,6 +116,7 @@ public:
 		TypeRole,
 		IndexRole,
 		LastActivityRole,
+		ThumbnailRole,
 		ZoomRole,
 		IsActiveRole,
 		IsAudibleRole,
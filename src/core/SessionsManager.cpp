@@ -21,7 +21,9 @@
 #include "SessionsManager.h"
 #include "Application.h"
 #include "JsonSettings.h"
+#include "PerformanceMonitor.h"
 #include "SessionModel.h"
+#include "TraceRecorder.h"
 #include "../ui/MainWindow.h"
 
 #include <QtCore/QDir>
@@ -38,7 +40,9 @@ QString SessionsManager::m_sessionTitle;
 QString SessionsManager::m_cachePath;
 QString SessionsManager::m_profilePath;
 QVector<SessionMainWindow> SessionsManager::m_closedWindows;
+QHash<QString, SessionMetaData> SessionsManager::m_sessionsIndex;
 bool SessionsManager::m_isDirty(false);
+bool SessionsManager::m_isSessionsIndexLoaded(false);
 bool SessionsManager::m_isPrivate(false);
 bool SessionsManager::m_isReadOnly(false);
 
@@ -84,6 +88,75 @@ void SessionsManager::scheduleSave()
 	}
 }
 
+void SessionsManager::loadSessionsIndex()
+{
+	if (m_isSessionsIndexLoaded)
+	{
+		return;
+	}
+
+	m_isSessionsIndexLoaded = true;
+
+	const JsonSettings settings(m_profilePath + QLatin1String("/sessionsIndex.json"));
+	const QJsonArray sessionsArray(settings.object().value(QLatin1String("sessions")).toArray());
+
+	for (int i = 0; i < sessionsArray.count(); ++i)
+	{
+		const QJsonObject sessionObject(sessionsArray.at(i).toObject());
+		SessionMetaData metaData;
+		metaData.title = sessionObject.value(QLatin1String("title")).toString();
+		metaData.lastModified = QDateTime::fromMSecsSinceEpoch(static_cast<qint64>(sessionObject.value(QLatin1String("lastModified")).toDouble()));
+		metaData.size = static_cast<qint64>(sessionObject.value(QLatin1String("size")).toDouble());
+		metaData.windows = sessionObject.value(QLatin1String("windows")).toInt();
+		metaData.tabs = sessionObject.value(QLatin1String("tabs")).toInt();
+
+		m_sessionsIndex[sessionObject.value(QLatin1String("path")).toString()] = metaData;
+	}
+}
+
+void SessionsManager::saveSessionsIndex()
+{
+	const TraceRecorder::Span span("SessionsManager::saveSessionsIndex");
+
+	if (m_isReadOnly)
+	{
+		return;
+	}
+
+	QJsonArray sessionsArray;
+	QHash<QString, SessionMetaData>::const_iterator iterator;
+
+	for (iterator = m_sessionsIndex.constBegin(); iterator != m_sessionsIndex.constEnd(); ++iterator)
+	{
+		sessionsArray.append(QJsonObject({{QLatin1String("path"), iterator.key()}, {QLatin1String("title"), iterator.value().title}, {QLatin1String("lastModified"), static_cast<double>(iterator.value().lastModified.toMSecsSinceEpoch())}, {QLatin1String("size"), static_cast<double>(iterator.value().size)}, {QLatin1String("windows"), iterator.value().windows}, {QLatin1String("tabs"), iterator.value().tabs}}));
+	}
+
+	JsonSettings settings;
+	settings.setObject(QJsonObject({{QLatin1String("sessions"), sessionsArray}}));
+	settings.save(m_profilePath + QLatin1String("/sessionsIndex.json"));
+}
+
+void SessionsManager::updateSessionsIndex(const QString &path, SessionMetaData metaData)
+{
+	const QFileInfo fileInfo(path);
+
+	loadSessionsIndex();
+
+	metaData.lastModified = fileInfo.lastModified();
+	metaData.size = fileInfo.size();
+
+	const QString filePath(fileInfo.absoluteFilePath());
+	const bool isModified(!m_sessionsIndex.contains(filePath) || m_sessionsIndex[filePath].title != metaData.title || m_sessionsIndex[filePath].windows != metaData.windows || m_sessionsIndex[filePath].tabs != metaData.tabs);
+
+	m_sessionsIndex[filePath] = metaData;
+
+// autosave changes only file time and size most of the time, stored entry is then just refreshed once after restart
+	if (isModified)
+	{
+		saveSessionsIndex();
+	}
+}
+
 void SessionsManager::clearClosedWindows()
 {
 	m_closedWindows.clear();
@@ -117,6 +190,38 @@ void SessionsManager::storeClosedWindow(MainWindow *mainWindow)
 	}
 }
 
+void SessionsManager::compactHistory(SessionWindow *window)
+{
+	if (!window->serializedHistory.isEmpty())
+	{
+		if (window->history.count() == 1 && window->serializedHistoryIndex >= 0 && window->serializedHistoryIndex < window->serializedHistory.count())
+		{
+			const QJsonObject entryObject(writeHistoryEntry(window->history.first()));
+
+			if (window->serializedHistory.at(window->serializedHistoryIndex).toObject() != entryObject)
+			{
+				window->serializedHistory.replace(window->serializedHistoryIndex, entryObject);
+			}
+		}
+
+		return;
+	}
+
+	if (window->history.count() < 2 || window->historyIndex < 0 || window->historyIndex >= window->history.count())
+	{
+		return;
+	}
+
+	for (int i = 0; i < window->history.count(); ++i)
+	{
+		window->serializedHistory.append(writeHistoryEntry(window->history.at(i)));
+	}
+
+	window->serializedHistoryIndex = window->historyIndex;
+	window->history = {window->history.at(window->historyIndex)};
+	window->historyIndex = 0;
+}
+
 void SessionsManager::markSessionAsModified()
 {
 	if (!m_isPrivate && !m_isDirty && m_sessionPath == QLatin1String("default"))
@@ -261,22 +366,21 @@ SessionInformation SessionsManager::getSession(const QString &path)
 				}
 			}
 
-			for (int k = 0; k < windowHistoryArray.count(); ++k)
+			if (sessionWindow.historyIndex < 0 || sessionWindow.historyIndex >= windowHistoryArray.count())
 			{
-				const QJsonObject historyEntryObject(windowHistoryArray.at(k).toObject());
-				const QStringList position(historyEntryObject.value(QLatin1String("position")).toString().split(QLatin1Char(',')));
-				WindowHistoryEntry historyEntry;
-				historyEntry.url = historyEntryObject.value(QLatin1String("url")).toString();
-				historyEntry.title = historyEntryObject.value(QLatin1String("title")).toString();
-				historyEntry.position = ((position.count() == 2) ? QPoint(position.at(0).simplified().toInt(), position.at(1).simplified().toInt()) : QPoint(0, 0));
-				historyEntry.zoom = historyEntryObject.value(QLatin1String("zoom")).toInt(defaultZoom);
-
-				sessionWindow.history.append(historyEntry);
+				sessionWindow.historyIndex = (windowHistoryArray.count() - 1);
 			}
 
-			if (sessionWindow.historyIndex < 0 || sessionWindow.historyIndex >= sessionWindow.history.count())
+			if (windowHistoryArray.count() > 1)
+			{
+				sessionWindow.history = {readHistoryEntry(windowHistoryArray.at(sessionWindow.historyIndex).toObject(), defaultZoom)};
+				sessionWindow.serializedHistory = windowHistoryArray;
+				sessionWindow.serializedHistoryIndex = sessionWindow.historyIndex;
+				sessionWindow.historyIndex = 0;
+			}
+			else if (windowHistoryArray.count() == 1)
 			{
-				sessionWindow.historyIndex = (sessionWindow.history.count() - 1);
+				sessionWindow.history = {readHistoryEntry(windowHistoryArray.at(0).toObject(), defaultZoom)};
 			}
 
 			sessionMainWindow.windows.append(sessionWindow);
@@ -374,6 +478,125 @@ SessionInformation SessionsManager::getSession(const QString &path)
 	return session;
 }
 
+SessionMetaData SessionsManager::readSessionMetaData(const QString &path)
+{
+	const QFileInfo fileInfo(path);
+	const JsonSettings settings(path);
+	const QJsonArray mainWindowsArray(settings.object().value(QLatin1String("windows")).toArray());
+	SessionMetaData metaData;
+	metaData.title = settings.object().value(QLatin1String("title")).toString();
+	metaData.lastModified = fileInfo.lastModified();
+	metaData.size = fileInfo.size();
+	metaData.windows = mainWindowsArray.count();
+
+	for (int i = 0; i < mainWindowsArray.count(); ++i)
+	{
+		metaData.tabs += mainWindowsArray.at(i).toObject().value(QLatin1String("windows")).toArray().count();
+	}
+
+	return metaData;
+}
+
+WindowHistoryInformation SessionsManager::getHistory(const SessionWindow &window)
+{
+	WindowHistoryInformation history;
+
+	if (window.serializedHistory.isEmpty())
+	{
+		history.entries = window.history;
+		history.index = window.historyIndex;
+
+		return history;
+	}
+
+	const int defaultZoom(SettingsManager::getOption(SettingsManager::Content_DefaultZoomOption).toInt());
+
+	history.entries.reserve(window.serializedHistory.count());
+	history.index = window.serializedHistoryIndex;
+
+	for (int i = 0; i < window.serializedHistory.count(); ++i)
+	{
+		history.entries.append((i == history.index && !window.history.isEmpty()) ? window.history.first() : readHistoryEntry(window.serializedHistory.at(i).toObject(), defaultZoom));
+	}
+
+	return history;
+}
+
+WindowHistoryEntry SessionsManager::readHistoryEntry(const QJsonObject &object, int defaultZoom)
+{
+	const QStringList position(object.value(QLatin1String("position")).toString().split(QLatin1Char(',')));
+	WindowHistoryEntry entry;
+	entry.url = object.value(QLatin1String("url")).toString();
+	entry.title = object.value(QLatin1String("title")).toString();
+	entry.position = ((position.count() == 2) ? QPoint(position.at(0).simplified().toInt(), position.at(1).simplified().toInt()) : QPoint(0, 0));
+	entry.zoom = object.value(QLatin1String("zoom")).toInt(defaultZoom);
+
+	return entry;
+}
+
+QJsonObject SessionsManager::writeHistoryEntry(const WindowHistoryEntry &entry)
+{
+	QJsonObject object({{QLatin1String("url"), entry.url}, {QLatin1String("title"), entry.title}, {QLatin1String("zoom"), entry.zoom}});
+
+	if (!entry.position.isNull())
+	{
+		object.insert(QLatin1String("position"), QStringLiteral("%1, %2").arg(entry.position.x()).arg(entry.position.y()));
+	}
+
+	return object;
+}
+
+QVector<SessionMetaData> SessionsManager::getSessionsMetaData()
+{
+	loadSessionsIndex();
+
+	const QStringList sessions(getSessions());
+	QHash<QString, SessionMetaData> sessionsIndex;
+	QVector<SessionMetaData> metaData;
+	metaData.reserve(sessions.count());
+	bool isModified(false);
+
+	for (int i = 0; i < sessions.count(); ++i)
+	{
+		const QFileInfo fileInfo(getSessionPath(sessions.at(i)));
+		SessionMetaData entry;
+
+		if (fileInfo.exists())
+		{
+			const QString filePath(fileInfo.absoluteFilePath());
+
+			entry = m_sessionsIndex.value(filePath);
+
+			if (entry.size != fileInfo.size() || entry.lastModified != fileInfo.lastModified())
+			{
+				entry = readSessionMetaData(filePath);
+
+				isModified = true;
+			}
+
+			sessionsIndex[filePath] = entry;
+
+			if (entry.title.isEmpty())
+			{
+				entry.title = ((sessions.at(i) == QLatin1String("default")) ? tr("Default") : tr("(Untitled)"));
+			}
+		}
+
+		entry.path = sessions.at(i);
+
+		metaData.append(entry);
+	}
+
+	if (isModified || sessionsIndex.count() != m_sessionsIndex.count())
+	{
+		m_sessionsIndex = sessionsIndex;
+
+		saveSessionsIndex();
+	}
+
+	return metaData;
+}
+
 QStringList SessionsManager::getClosedWindows()
 {
 	QStringList closedWindows;
@@ -525,6 +748,8 @@ bool SessionsManager::restoreClosedWindow(int index)
 
 bool SessionsManager::restoreSession(const SessionInformation &session, MainWindow *mainWindow, bool isPrivate)
 {
+	const TraceRecorder::Span span("SessionsManager::restoreSession");
+
 	if (session.windows.isEmpty())
 	{
 		if (m_sessionPath.isEmpty() && session.path == QLatin1String("default"))
@@ -565,6 +790,8 @@ bool SessionsManager::restoreSession(const SessionInformation &session, MainWind
 
 bool SessionsManager::saveSession(const QString &path, const QString &title, MainWindow *mainWindow, bool isClean)
 {
+	const TraceRecorder::Span span("SessionsManager::saveSession");
+
 	if (m_isPrivate && path.isEmpty())
 	{
 		return false;
@@ -603,6 +830,9 @@ bool SessionsManager::saveSession(const QString &path, const QString &title, Mai
 
 bool SessionsManager::saveSession(const SessionInformation &session)
 {
+	const TraceRecorder::Span span("SessionsManager::saveSession");
+	const PerformanceMonitor::FlushSpan flushSpan(PerformanceMonitor::SessionFlush);
+
 	const QString sessionsPath(m_profilePath + QLatin1String("/sessions/"));
 
 	QDir().mkpath(sessionsPath);
@@ -649,7 +879,7 @@ bool SessionsManager::saveSession(const SessionInformation &session)
 
 		for (int j = 0; j < sessionEntry.windows.count(); ++j)
 		{
-			QJsonObject windowObject({{QLatin1String("currentIndex"), (sessionEntry.windows.at(j).historyIndex + 1)}});
+			QJsonObject windowObject({{QLatin1String("currentIndex"), ((sessionEntry.windows.at(j).serializedHistory.isEmpty() ? sessionEntry.windows.at(j).historyIndex : sessionEntry.windows.at(j).serializedHistoryIndex) + 1)}});
 
 			if (!sessionEntry.windows.at(j).options.isEmpty())
 			{
@@ -705,19 +935,14 @@ bool SessionsManager::saveSession(const SessionInformation &session)
 				windowObject.insert(QLatin1String("isPinned"), true);
 			}
 
-			QJsonArray windowHistoryArray;
+			QJsonArray windowHistoryArray(sessionEntry.windows.at(j).serializedHistory);
 
-			for (int k = 0; k < sessionEntry.windows.at(j).history.count(); ++k)
+			if (windowHistoryArray.isEmpty())
 			{
-				const QPoint position(sessionEntry.windows.at(j).history.at(k).position);
-				QJsonObject historyEntryObject({{QLatin1String("url"), sessionEntry.windows.at(j).history.at(k).url}, {QLatin1String("title"), sessionEntry.windows.at(j).history.at(k).title}, {QLatin1String("zoom"), sessionEntry.windows.at(j).history.at(k).zoom}});
-
-				if (!position.isNull())
+				for (int k = 0; k < sessionEntry.windows.at(j).history.count(); ++k)
 				{
-					historyEntryObject.insert(QLatin1String("position"), QStringLiteral("%1, %2").arg(position.x()).arg(position.y()));
+					windowHistoryArray.append(writeHistoryEntry(sessionEntry.windows.at(j).history.at(k)));
 				}
-
-				windowHistoryArray.append(historyEntryObject);
 			}
 
 			windowObject.insert(QLatin1String("history"), windowHistoryArray);
@@ -814,7 +1039,23 @@ bool SessionsManager::saveSession(const SessionInformation &session)
 	JsonSettings settings;
 	settings.setObject(sessionObject);
 
-	return settings.save(path);
+	if (!settings.save(path))
+	{
+		return false;
+	}
+
+	SessionMetaData metaData;
+	metaData.title = session.title;
+	metaData.windows = session.windows.count();
+
+	for (int i = 0; i < session.windows.count(); ++i)
+	{
+		metaData.tabs += session.windows.at(i).windows.count();
+	}
+
+	updateSessionsIndex(path, metaData);
+
+	return true;
 }
 
 bool SessionsManager::deleteSession(const QString &path)
@@ -823,6 +1064,13 @@ bool SessionsManager::deleteSession(const QString &path)
 
 	if (QFile::exists(cleanPath))
 	{
+		loadSessionsIndex();
+
+		if (m_sessionsIndex.remove(QFileInfo(cleanPath).absoluteFilePath()) > 0)
+		{
+			saveSessionsIndex();
+		}
+
 		return QFile::remove(cleanPath);
 	}
 
@@ -27,6 +27,8 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDateTime>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
 #include <QtCore/QRect>
 
 namespace Otter
@@ -132,8 +134,10 @@ struct SessionWindow final
 	WindowState state;
 	QHash<int, QVariant> options;
 	QVector<WindowHistoryEntry> history;
+	QJsonArray serializedHistory;
 	int parentGroup = 0;
 	int historyIndex = -1;
+	int serializedHistoryIndex = -1;
 	bool isAlwaysOnTop = false;
 	bool isPinned = false;
 
@@ -200,6 +204,16 @@ struct SessionInformation final
 	}
 };
 
+struct SessionMetaData final
+{
+	QString path;
+	QString title;
+	QDateTime lastModified;
+	qint64 size = 0;
+	int windows = 0;
+	int tabs = 0;
+};
+
 struct ClosedWindow final
 {
 	SessionWindow window;
@@ -233,6 +247,7 @@ public:
 	static void createInstance(const QString &profilePath, const QString &cachePath, bool isPrivate = false, bool isReadOnly = false);
 	static void clearClosedWindows();
 	static void storeClosedWindow(MainWindow *mainWindow);
+	static void compactHistory(SessionWindow *window);
 	static void markSessionAsModified();
 	static void removeStoredUrl(const QString &url);
 	static SessionsManager* getInstance();
@@ -244,6 +259,8 @@ public:
 	static QString getWritableDataPath(const QString &path);
 	static QString getSessionPath(const QString &path, bool isBound = false);
 	static SessionInformation getSession(const QString &path);
+	static WindowHistoryInformation getHistory(const SessionWindow &window);
+	static QVector<SessionMetaData> getSessionsMetaData();
 	static QStringList getClosedWindows();
 	static QStringList getSessions();
 	static SessionsManager::OpenHints calculateOpenHints(OpenHints hints, Qt::MouseButton button, Qt::KeyboardModifiers modifiers);
@@ -263,6 +280,12 @@ protected:
 
 	void timerEvent(QTimerEvent *event) override;
 	void scheduleSave();
+	static void loadSessionsIndex();
+	static void saveSessionsIndex();
+	static void updateSessionsIndex(const QString &path, SessionMetaData metaData);
+	static SessionMetaData readSessionMetaData(const QString &path);
+	static WindowHistoryEntry readHistoryEntry(const QJsonObject &object, int defaultZoom);
+	static QJsonObject writeHistoryEntry(const WindowHistoryEntry &entry);
 
 private:
 	int m_saveTimer;
@@ -274,7 +297,9 @@ private:
 	static QString m_cachePath;
 	static QString m_profilePath;
 	static QVector<SessionMainWindow> m_closedWindows;
+	static QHash<QString, SessionMetaData> m_sessionsIndex;
 	static bool m_isDirty;
+	static bool m_isSessionsIndexLoaded;
 	static bool m_isPrivate;
 	static bool m_isReadOnly;
 
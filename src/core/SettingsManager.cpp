@@ -20,6 +20,7 @@
 **************************************************************************/
 
 #include "SettingsManager.h"
+#include "PerformanceMonitor.h"
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
@@ -84,6 +85,9 @@ void SettingsManager::createInstance(const QString &path)
 	registerOption(Browser_InactiveTabTimeUntilSuspendOption, IntegerType, -1);
 	registerOption(Browser_KeyboardShortcutsProfilesOrderOption, ListType, QStringList(QLatin1String("default")));
 	registerOption(Browser_LocaleOption, StringType, QLatin1String("system"));
+	registerOption(Browser_MemoryControlGroupUsageLimitOption, IntegerType, 0);
+	registerOption(Browser_MemoryPressureLimitOption, IntegerType, 0);
+	registerOption(Browser_MemoryUsageLimitOption, IntegerType, 0);
 	registerOption(Browser_MigrationsOption, ListType, QStringList());
 	registerOption(Browser_MouseProfilesOrderOption, ListType, QStringList(QLatin1String("default")));
 	registerOption(Browser_OfflineStorageLimitOption, IntegerType, 10240);
@@ -167,6 +171,11 @@ void SettingsManager::createInstance(const QString &path)
 	registerOption(Network_ThirdPartyCookiesAcceptedHostsOption, ListType, QStringList());
 	registerOption(Network_ThirdPartyCookiesPolicyOption, EnumerationType, QLatin1String("acceptAll"), QStringList({QLatin1String("acceptAll"), QLatin1String("acceptExisting"), QLatin1String("ignore")}));
 	registerOption(Network_ThirdPartyCookiesRejectedHostsOption, ListType, QStringList());
+	registerOption(Network_TransferSegmentsAmountOption, IntegerType, 1);
+	registerOption(Network_TransferSpeedLimitOption, IntegerType, 0);
+	registerOption(Network_TransfersLimitAmountGlobalOption, IntegerType, 0);
+	registerOption(Network_TransfersLimitAmountHostOption, IntegerType, 0);
+	registerOption(Network_TransfersSpeedLimitOption, IntegerType, 0);
 	registerOption(Network_UserAgentOption, EnumerationType, QLatin1String("default"), QStringList(QLatin1String("default")));
 	registerOption(Network_WorkOfflineOption, BooleanType, false);
 	registerOption(Paths_DownloadsOption, PathType, QStandardPaths::writableLocation(QStandardPaths::DownloadLocation));
@@ -203,6 +212,7 @@ void SettingsManager::createInstance(const QString &path)
 	registerOption(Security_AllowMixedContentOption, BooleanType, false);
 	registerOption(Security_CiphersOption, ListType, QStringList(QLatin1String("default")));
 	registerOption(Security_EnableFraudCheckingOption, BooleanType, true);
+	registerOption(Security_FraudCheckingUpdateUrlOption, StringType, QString());
 	registerOption(Security_IgnoreSslErrorsOption, ListType, QStringList());
 	registerOption(Sessions_DeferTabsLoadingOption, BooleanType, true);
 	registerOption(Sessions_OpenInExistingWindowOption, BooleanType, false);
@@ -217,6 +227,7 @@ void SettingsManager::createInstance(const QString &path)
 	registerOption(StartPage_EnableStartPageOption, BooleanType, true);
 	registerOption(StartPage_ShowAddTileOption, BooleanType, true);
 	registerOption(StartPage_ShowSearchFieldOption, BooleanType, true);
+	registerOption(StartPage_ThumbnailsRefreshPeriodOption, IntegerType, 7);
 	registerOption(StartPage_TileBackgroundModeOption, EnumerationType, QLatin1String("thumbnail"), QStringList({QLatin1String("none"), QLatin1String("thumbnail"), QLatin1String("favicon")}));
 	registerOption(StartPage_TileHeightOption, IntegerType, 190);
 	registerOption(StartPage_TileWidthOption, IntegerType, 270);
@@ -485,6 +496,8 @@ QString SettingsManager::getOptionName(int identifier)
 
 QVariant SettingsManager::getOption(int identifier, const QString &host)
 {
+	PerformanceMonitor::addSettingsLookup();
+
 	if (identifier < 0 || identifier >= m_definitions.count())
 	{
 		return {};
@@ -62,6 +62,9 @@ public:
 		Browser_InactiveTabTimeUntilSuspendOption,
 		Browser_KeyboardShortcutsProfilesOrderOption,
 		Browser_LocaleOption,
+		Browser_MemoryControlGroupUsageLimitOption,
+		Browser_MemoryPressureLimitOption,
+		Browser_MemoryUsageLimitOption,
 		Browser_MigrationsOption,
 		Browser_MouseProfilesOrderOption,
 		Browser_OfflineStorageLimitOption,
@@ -145,6 +148,11 @@ public:
 		Network_ThirdPartyCookiesAcceptedHostsOption,
 		Network_ThirdPartyCookiesPolicyOption,
 		Network_ThirdPartyCookiesRejectedHostsOption,
+		Network_TransferSegmentsAmountOption,
+		Network_TransferSpeedLimitOption,
+		Network_TransfersLimitAmountGlobalOption,
+		Network_TransfersLimitAmountHostOption,
+		Network_TransfersSpeedLimitOption,
 		Network_UserAgentOption,
 		Network_WorkOfflineOption,
 		Paths_DownloadsOption,
@@ -181,6 +189,7 @@ public:
 		Security_AllowMixedContentOption,
 		Security_CiphersOption,
 		Security_EnableFraudCheckingOption,
+		Security_FraudCheckingUpdateUrlOption,
 		Security_IgnoreSslErrorsOption,
 		Sessions_DeferTabsLoadingOption,
 		Sessions_OpenInExistingWindowOption,
@@ -195,6 +204,7 @@ public:
 		StartPage_EnableStartPageOption,
 		StartPage_ShowAddTileOption,
 		StartPage_ShowSearchFieldOption,
+		StartPage_ThumbnailsRefreshPeriodOption,
 		StartPage_TileBackgroundModeOption,
 		StartPage_TileHeightOption,
 		StartPage_TileWidthOption,
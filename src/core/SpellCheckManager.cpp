@@ -19,6 +19,7 @@
 
 #include "SpellCheckManager.h"
 #include "SessionsManager.h"
+#include "TraceRecorder.h"
 #ifdef OTTER_ENABLE_SPELLCHECK
 #include "../../3rdparty/sonnet/src/core/speller.h"
 #endif
@@ -31,13 +32,12 @@ namespace Otter
 SpellCheckManager* SpellCheckManager::m_instance(nullptr);
 QString SpellCheckManager::m_defaultDictionary;
 QMap<QString, QString> SpellCheckManager::m_dictionaries;
+bool SpellCheckManager::m_areDictionariesLoaded(false);
 
 SpellCheckManager::SpellCheckManager(QObject *parent) : QObject(parent)
 {
 #ifdef OTTER_ENABLE_SPELLCHECK
 	qputenv("OTTER_DICTIONARIES", SessionsManager::getWritableDataPath(QLatin1String("dictionaries")).toLatin1());
-
-	m_dictionaries = Sonnet::Speller().availableDictionaries();
 #endif
 }
 
@@ -49,8 +49,24 @@ void SpellCheckManager::createInstance()
 	}
 }
 
+void SpellCheckManager::loadDictionaries()
+{
+	const TraceRecorder::Span span("SpellCheckManager::loadDictionaries");
+
+	m_areDictionariesLoaded = true;
+
+#ifdef OTTER_ENABLE_SPELLCHECK
+	m_dictionaries = Sonnet::Speller().availableDictionaries();
+#endif
+}
+
 void SpellCheckManager::updateDefaultDictionary()
 {
+	if (!m_areDictionariesLoaded)
+	{
+		loadDictionaries();
+	}
+
 	const QStringList dictionaries(m_dictionaries.values());
 	const QString defaultLanguage(QLocale().bcp47Name());
 
@@ -104,6 +120,11 @@ QString SpellCheckManager::getDefaultDictionary()
 
 QVector<SpellCheckManager::DictionaryInformation> SpellCheckManager::getDictionaries()
 {
+	if (!m_areDictionariesLoaded)
+	{
+		loadDictionaries();
+	}
+
 	QVector<DictionaryInformation> dictionaries;
 	dictionaries.reserve(m_dictionaries.count());
 
@@ -123,7 +144,7 @@ QVector<SpellCheckManager::DictionaryInformation> SpellCheckManager::getDictiona
 
 bool SpellCheckManager::event(QEvent *event)
 {
-	if (event->type() == QEvent::LanguageChange)
+	if (event->type() == QEvent::LanguageChange && m_areDictionariesLoaded)
 	{
 		updateDefaultDictionary();
 	}
@@ -45,12 +45,14 @@ public:
 protected:
 	explicit SpellCheckManager(QObject *parent);
 
+	static void loadDictionaries();
 	static void updateDefaultDictionary();
 
 private:
 	static SpellCheckManager *m_instance;
 	static QString m_defaultDictionary;
 	static QMap<QString, QString> m_dictionaries;
+	static bool m_areDictionariesLoaded;
 };
 
 }
@@ -104,12 +104,16 @@ ThemesManager* ThemesManager::m_instance(nullptr);
 Palette* ThemesManager::m_palette(nullptr);
 QWidget* ThemesManager::m_probeWidget(nullptr);
 QString ThemesManager::m_iconThemePath(QLatin1String(":/icons/theme/"));
+QHash<QPair<QString, bool>, QIcon> ThemesManager::m_icons;
+QCache<QString, QIcon> ThemesManager::m_dataUriIcons(200);
+QSet<QString> ThemesManager::m_iconThemeFiles;
 bool ThemesManager::m_useSystemIconTheme(false);
 
 ThemesManager::ThemesManager(QObject *parent) : QObject(parent)
 {
 	m_useSystemIconTheme = SettingsManager::getOption(SettingsManager::Interface_UseSystemIconThemeOption).toBool();
 
+	indexIconTheme();
 	handleOptionChanged(SettingsManager::Interface_IconThemePathOption, SettingsManager::getOption(SettingsManager::Interface_IconThemePathOption));
 
 	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &ThemesManager::handleOptionChanged);
@@ -153,6 +157,8 @@ void ThemesManager::handleOptionChanged(int identifier, const QVariant &value)
 				{
 					m_iconThemePath = path;
 
+					indexIconTheme();
+
 					emit iconThemeChanged();
 				}
 			}
@@ -163,6 +169,8 @@ void ThemesManager::handleOptionChanged(int identifier, const QVariant &value)
 			{
 				m_useSystemIconTheme = value.toBool();
 
+				m_icons.clear();
+
 				emit iconThemeChanged();
 			}
 		default:
@@ -170,6 +178,12 @@ void ThemesManager::handleOptionChanged(int identifier, const QVariant &value)
 	}
 }
 
+void ThemesManager::indexIconTheme()
+{
+	m_icons.clear();
+	m_iconThemeFiles = QDir(m_iconThemePath).entryList(QDir::Files).toSet();
+}
+
 ThemesManager* ThemesManager::getInstance()
 {
 	return m_instance;
@@ -200,19 +214,18 @@ Style* ThemesManager::createStyle(const QString &name)
 
 QString ThemesManager::getAnimationPath(const QString &name)
 {
-	const QString iconPath(m_iconThemePath + name);
-	const QString svgPath(iconPath + QLatin1String(".svg"));
+	const QString svgName(name + QLatin1String(".svg"));
 
-	if (QFile::exists(svgPath))
+	if (m_iconThemeFiles.contains(svgName))
 	{
-		return svgPath;
+		return m_iconThemePath + svgName;
 	}
 
-	const QString gifPath(iconPath + QLatin1String(".gif"));
+	const QString gifName(name + QLatin1String(".gif"));
 
-	if (QFile::exists(gifPath))
+	if (m_iconThemeFiles.contains(gifName))
 	{
-		return gifPath;
+		return m_iconThemePath + gifName;
 	}
 
 	return {};
@@ -227,29 +240,67 @@ QIcon ThemesManager::createIcon(const QString &name, bool fromTheme)
 
 	if (name.startsWith(QLatin1String("data:image/")))
 	{
-		return QIcon(Utils::loadPixmapFromDataUri(name));
+		const QIcon *cachedIcon(m_dataUriIcons.object(name));
+
+		if (cachedIcon)
+		{
+			return *cachedIcon;
+		}
+
+		const QIcon icon(Utils::loadPixmapFromDataUri(name));
+
+		m_dataUriIcons.insert(name, new QIcon(icon));
+
+		return icon;
 	}
 
-	if (m_useSystemIconTheme && fromTheme && QIcon::hasThemeIcon(name))
+	const QPair<QString, bool> key(name, fromTheme);
+	const QHash<QPair<QString, bool>, QIcon>::const_iterator iterator(m_icons.constFind(key));
+
+	if (iterator != m_icons.constEnd())
 	{
-		return QIcon::fromTheme(name);
+		return iterator.value();
 	}
 
-	const QString iconPath((!fromTheme && name == QLatin1String("otter-browser")) ? QLatin1String(":/icons/otter-browser") : m_iconThemePath + name);
-	const QString svgPath(iconPath + QLatin1String(".svg"));
-	const QString rasterPath(iconPath + QLatin1String(".png"));
+	QIcon icon;
 
-	if (QFile::exists(svgPath))
+	if (m_useSystemIconTheme && fromTheme && QIcon::hasThemeIcon(name))
 	{
-		return QIcon(svgPath);
+		icon = QIcon::fromTheme(name);
 	}
+	else if (!fromTheme && name == QLatin1String("otter-browser"))
+	{
+		const QString iconPath(QLatin1String(":/icons/otter-browser"));
+		const QString svgPath(iconPath + QLatin1String(".svg"));
+		const QString rasterPath(iconPath + QLatin1String(".png"));
 
-	if (QFile::exists(rasterPath))
+		if (QFile::exists(svgPath))
+		{
+			icon = QIcon(svgPath);
+		}
+		else if (QFile::exists(rasterPath))
+		{
+			icon = QIcon(rasterPath);
+		}
+	}
+	else
 	{
-		return QIcon(rasterPath);
+		const QString svgName(name + QLatin1String(".svg"));
+		const QString rasterName(name + QLatin1String(".png"));
+
+		if (m_iconThemeFiles.contains(svgName))
+		{
+			icon = QIcon(m_iconThemePath + svgName);
+		}
+		else if (m_iconThemeFiles.contains(rasterName))
+		{
+			icon = QIcon(m_iconThemePath + rasterName);
+		}
 	}
 
-	return {};
+	m_icons[key] = icon;
+
+	return icon;
 }
 
 bool ThemesManager::eventFilter(QObject *object, QEvent *event)
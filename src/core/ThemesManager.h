@@ -21,7 +21,10 @@
 #define OTTER_THEMESMANAGER_H
 
 #include <QtCore/QAbstractNativeEventFilter>
+#include <QtCore/QCache>
 #include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtGui/QIcon>
 #include <QtWidgets/QStyle>
 
 namespace Otter
@@ -104,6 +107,7 @@ public:
 protected:
 	explicit ThemesManager(QObject *parent);
 
+	static void indexIconTheme();
 	bool eventFilter(QObject *object, QEvent *event) override;
 #ifdef Q_OS_WIN32
 	bool nativeEventFilter(const QByteArray &eventType, void *message, long *result) override;
@@ -117,6 +121,9 @@ private:
 	static Palette *m_palette;
 	static QWidget *m_probeWidget;
 	static QString m_iconThemePath;
+	static QHash<QPair<QString, bool>, QIcon> m_icons;
+	static QCache<QString, QIcon> m_dataUriIcons;
+	static QSet<QString> m_iconThemeFiles;
 	static bool m_useSystemIconTheme;
 
 signals:
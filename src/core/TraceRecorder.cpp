@@ -0,0 +1,212 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2018 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "TraceRecorder.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QSaveFile>
+#include <QtCore/QTextStream>
+#include <QtCore/QThread>
+
+namespace Otter
+{
+
+QElapsedTimer TraceRecorder::m_timer;
+QMutex TraceRecorder::m_mutex;
+QVector<TraceRecorder::ThreadBuffer*> TraceRecorder::m_buffers;
+bool TraceRecorder::m_isEnabled(false);
+
+TraceRecorder::Span::Span(const char *name) :
+	m_name(name),
+	m_startTime(m_isEnabled ? m_timer.nsecsElapsed() : -1)
+{
+}
+
+TraceRecorder::Span::~Span()
+{
+	if (m_startTime >= 0)
+	{
+		addEvent(m_name, m_startTime, (m_timer.nsecsElapsed() - m_startTime));
+	}
+}
+
+void TraceRecorder::addEvent(const char *name, qint64 startTime, qint64 duration)
+{
+	ThreadBuffer *buffer(getThreadBuffer());
+	Event event;
+	event.name = name;
+	event.startTime = startTime;
+	event.duration = duration;
+
+// lock is uncontended unless trace is being saved right now
+	QMutexLocker locker(&buffer->mutex);
+
+	if (buffer->hasWrapped)
+	{
+		buffer->events[buffer->position] = event;
+	}
+	else
+	{
+		buffer->events.append(event);
+	}
+
+	++buffer->position;
+
+	if (buffer->position == BufferSize)
+	{
+		buffer->position = 0;
+		buffer->hasWrapped = true;
+	}
+}
+
+void TraceRecorder::releaseThreadBuffer(ThreadBuffer *buffer)
+{
+	QMutexLocker locker(&buffer->mutex);
+	const int amount(buffer->hasWrapped ? BufferSize : buffer->position);
+	const int offset(buffer->hasWrapped ? buffer->position : 0);
+	const int start(qMax(0, (amount - FinishedBufferSize)));
+	QVector<Event> events;
+	events.reserve(amount - start);
+
+	for (int i = start; i < amount; ++i)
+	{
+		events.append(buffer->events.at((offset + i) % BufferSize));
+	}
+
+	buffer->events = events;
+	buffer->position = events.count();
+	buffer->hasWrapped = false;
+}
+
+void TraceRecorder::setEnabled(bool isEnabled)
+{
+	m_isEnabled = isEnabled;
+
+	if (isEnabled && !m_timer.isValid())
+	{
+		m_timer.start();
+	}
+}
+
+TraceRecorder::ThreadBuffer* TraceRecorder::getThreadBuffer()
+{
+	struct ThreadBufferHolder final
+	{
+		~ThreadBufferHolder()
+		{
+			if (buffer)
+			{
+				releaseThreadBuffer(buffer);
+			}
+		}
+
+		ThreadBuffer *buffer = nullptr;
+	};
+
+	thread_local ThreadBufferHolder holder;
+
+	if (!holder.buffer)
+	{
+		holder.buffer = new ThreadBuffer();
+		holder.buffer->isMainThread = (QCoreApplication::instance() && QThread::currentThread() == QCoreApplication::instance()->thread());
+
+		QMutexLocker locker(&m_mutex);
+
+		holder.buffer->identifier = (m_buffers.count() + 1);
+
+		m_buffers.append(holder.buffer);
+	}
+
+	return holder.buffer;
+}
+
+bool TraceRecorder::save(const QString &path)
+{
+	QSaveFile file(path);
+
+	if (!file.open(QIODevice::WriteOnly))
+	{
+		return false;
+	}
+
+	const qint64 processIdentifier(QCoreApplication::applicationPid());
+	QTextStream stream(&file);
+	stream.setCodec("UTF-8");
+	stream.setRealNumberNotation(QTextStream::FixedNotation);
+	stream.setRealNumberPrecision(3);
+	stream << QLatin1String("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+
+	m_mutex.lock();
+
+	const QVector<ThreadBuffer*> buffers(m_buffers);
+
+	m_mutex.unlock();
+
+	bool hasEvents(false);
+
+	for (int i = 0; i < buffers.count(); ++i)
+	{
+		ThreadBuffer *buffer(buffers.at(i));
+		const QString threadName(buffer->isMainThread ? QLatin1String("Main") : QStringLiteral("Worker %1").arg(buffer->identifier));
+		QVector<Event> events;
+
+// owning thread keeps appending meanwhile, so its events are copied in order while it waits
+		buffer->mutex.lock();
+
+		const int amount(buffer->hasWrapped ? BufferSize : buffer->position);
+		const int offset(buffer->hasWrapped ? buffer->position : 0);
+
+		events.reserve(amount);
+
+		for (int j = 0; j < amount; ++j)
+		{
+			events.append(buffer->events.at((offset + j) % BufferSize));
+		}
+
+		buffer->mutex.unlock();
+
+		if (hasEvents)
+		{
+			stream << QLatin1Char(',');
+		}
+
+		stream << QLatin1String("\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":") << processIdentifier << QLatin1String(",\"tid\":") << buffer->identifier << QLatin1String(",\"args\":{\"name\":\"") << threadName << QLatin1String("\"}}");
+
+		hasEvents = true;
+
+		for (int j = 0; j < events.count(); ++j)
+		{
+			const Event &event(events.at(j));
+
+			stream << QLatin1String(",\n{\"name\":\"") << QLatin1String(event.name) << QLatin1String("\",\"cat\":\"otter\",\"ph\":\"X\",\"ts\":") << (event.startTime / 1000.0) << QLatin1String(",\"dur\":") << (event.duration / 1000.0) << QLatin1String(",\"pid\":") << processIdentifier << QLatin1String(",\"tid\":") << buffer->identifier << QLatin1Char('}');
+		}
+	}
+
+	stream << QLatin1String("\n]}\n");
+	stream.flush();
+
+	return file.commit();
+}
+
+bool TraceRecorder::isEnabled()
+{
+	return m_isEnabled;
+}
+
+}
@@ -0,0 +1,86 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2018 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#ifndef OTTER_TRACERECORDER_H
+#define OTTER_TRACERECORDER_H
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+namespace Otter
+{
+
+class TraceRecorder final
+{
+public:
+	class Span final
+	{
+	public:
+		explicit Span(const char *name);
+		~Span();
+
+	private:
+		const char *m_name;
+		qint64 m_startTime;
+	};
+
+	static void setEnabled(bool isEnabled);
+	static bool save(const QString &path);
+	static bool isEnabled();
+
+protected:
+	enum
+	{
+		BufferSize = 65536,
+		FinishedBufferSize = 4096
+	};
+
+	struct Event final
+	{
+		const char *name = nullptr;
+		qint64 startTime = 0;
+		qint64 duration = 0;
+	};
+
+	struct ThreadBuffer final
+	{
+		QMutex mutex;
+		QVector<Event> events;
+		int identifier = 0;
+		int position = 0;
+		bool hasWrapped = false;
+		bool isMainThread = false;
+	};
+
+	static void addEvent(const char *name, qint64 startTime, qint64 duration);
+	static void releaseThreadBuffer(ThreadBuffer *buffer);
+	static ThreadBuffer* getThreadBuffer();
+
+private:
+	static QElapsedTimer m_timer;
+	static QMutex m_mutex;
+	static QVector<ThreadBuffer*> m_buffers;
+	static bool m_isEnabled;
+};
+
+}
+
+#endif
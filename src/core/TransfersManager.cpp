@@ -19,10 +19,12 @@
 
 #include "TransfersManager.h"
 #include "Application.h"
+#include "Console.h"
 #include "NetworkManager.h"
 #include "NetworkManagerFactory.h"
 #include "NotificationsManager.h"
 #include "SessionsManager.h"
+#include "TraceRecorder.h"
 #include "Utils.h"
 #include "../ui/MainWindow.h"
 
@@ -35,14 +37,210 @@
 #include <QtNetwork/QAbstractNetworkCache>
 #include <QtWidgets/QMessageBox>
 
+#ifdef Q_OS_LINUX
+#include <fcntl.h>
+#endif
+
 namespace Otter
 {
 
 TransfersManager* TransfersManager::m_instance(nullptr);
+QThread* TransfersManager::m_writerThread(nullptr);
 QVector<Transfer*> TransfersManager::m_transfers;
 QVector<Transfer*> TransfersManager::m_privateTransfers;
+QVector<QPointer<Transfer> > TransfersManager::m_unmanagedTransfers;
+QVector<QPointer<Transfer> > TransfersManager::m_queuedTransfers;
+QVector<QPointer<Transfer> > TransfersManager::m_throttledTransfers;
+QHash<QObject*, qint64> TransfersManager::m_pageRequests;
+QElapsedTimer TransfersManager::m_bandwidthTimer;
+QElapsedTimer TransfersManager::m_measurementTimer;
+qint64 TransfersManager::m_bandwidthAvailable(0);
+qint64 TransfersManager::m_bandwidthEstimate(0);
+qint64 TransfersManager::m_measuredBytes(0);
+qint64 TransfersManager::m_speedLimit(0);
+int TransfersManager::m_transfersLimit(0);
+int TransfersManager::m_hostTransfersLimit(0);
 bool TransfersManager::m_isInitilized(false);
 bool TransfersManager::m_hasRunningTransfers(false);
+bool TransfersManager::m_isMeasurementThrottled(false);
+
+TransferWriter::TransferWriter(QFile *file) : QObject(),
+	m_file(file),
+	m_pendingBytes(0),
+	m_isProcessingScheduled(false),
+	m_isWaitingForDrain(false),
+	m_hasError(false)
+{
+	m_file->setParent(this);
+	m_buffer.data.reserve(1048576);
+}
+
+void TransferWriter::write(qint64 position, const QByteArray &data)
+{
+	if (!m_buffer.data.isEmpty() && (m_buffer.position + m_buffer.data.size()) != position)
+	{
+		enqueueBuffer();
+	}
+
+	if (m_buffer.data.isEmpty())
+	{
+		m_buffer.position = position;
+	}
+
+	m_buffer.data.append(data);
+
+	if (m_buffer.data.size() >= 1048576)
+	{
+		enqueueBuffer();
+	}
+}
+
+void TransferWriter::preallocate(qint64 size, bool canResize)
+{
+	QMetaObject::invokeMethod(this, "allocate", Qt::QueuedConnection, Q_ARG(qint64, size), Q_ARG(bool, canResize));
+}
+
+void TransferWriter::truncate()
+{
+	QMetaObject::invokeMethod(this, "truncateFile", Qt::QueuedConnection);
+}
+
+void TransferWriter::close(bool hasToRemove)
+{
+	enqueueBuffer();
+
+	QMetaObject::invokeMethod(this, "closeFile", Qt::QueuedConnection, Q_ARG(bool, hasToRemove));
+}
+
+void TransferWriter::enqueueBuffer()
+{
+	if (m_buffer.data.isEmpty())
+	{
+		return;
+	}
+
+	QMutexLocker locker(&m_mutex);
+
+	m_pendingBytes += m_buffer.data.size();
+	m_buffers.enqueue(m_buffer);
+
+	m_buffer.position = 0;
+	m_buffer.data = (m_freeBuffers.isEmpty() ? QByteArray() : m_freeBuffers.takeLast());
+
+	if (m_buffer.data.capacity() < 1048576)
+	{
+		m_buffer.data.reserve(1048576);
+	}
+
+	if (!m_isProcessingScheduled)
+	{
+		m_isProcessingScheduled = true;
+
+		QMetaObject::invokeMethod(this, "processBuffers", Qt::QueuedConnection);
+	}
+}
+
+void TransferWriter::processBuffers()
+{
+	m_mutex.lock();
+
+	while (!m_buffers.isEmpty())
+	{
+		Buffer buffer(m_buffers.dequeue());
+
+		m_mutex.unlock();
+
+		if (!m_hasError && ((m_file->pos() != buffer.position && !m_file->seek(buffer.position)) || m_file->write(buffer.data) != buffer.data.size()))
+		{
+			m_hasError = true;
+
+			emit writeFailed();
+		}
+
+		const int size(buffer.data.size());
+
+		buffer.data.resize(0);
+
+		m_mutex.lock();
+
+		m_pendingBytes -= size;
+
+		if (m_freeBuffers.count() < 4)
+		{
+			m_freeBuffers.append(buffer.data);
+		}
+
+		if (m_isWaitingForDrain && m_pendingBytes <= 4194304)
+		{
+			m_isWaitingForDrain = false;
+
+			emit drained();
+		}
+	}
+
+	m_isProcessingScheduled = false;
+
+	m_mutex.unlock();
+}
+
+void TransferWriter::allocate(qint64 size, bool canResize)
+{
+	m_file->flush();
+
+#ifdef Q_OS_LINUX
+	if (fallocate(m_file->handle(), (canResize ? 0 : FALLOC_FL_KEEP_SIZE), 0, size) == 0)
+	{
+		return;
+	}
+#endif
+
+	if (canResize && m_file->size() < size)
+	{
+		m_file->resize(size);
+	}
+}
+
+void TransferWriter::truncateFile()
+{
+	if (!m_file->resize(0))
+	{
+		m_hasError = true;
+
+		emit writeFailed();
+	}
+}
+
+void TransferWriter::closeFile(bool hasToRemove)
+{
+	if (hasToRemove)
+	{
+		m_file->remove();
+	}
+	else
+	{
+		processBuffers();
+
+		m_file->close();
+	}
+
+	emit closed(!m_hasError);
+
+	deleteLater();
+}
+
+bool TransferWriter::isFull()
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (m_pendingBytes >= 8388608)
+	{
+		m_isWaitingForDrain = true;
+
+		return true;
+	}
+
+	return false;
+}
 
 Transfer::Transfer(TransferOptions options, QObject *parent) : QObject(parent ? parent : TransfersManager::getInstance()),
 	m_reply(nullptr),
@@ -52,13 +250,19 @@ Transfer::Transfer(TransferOptions options, QObject *parent) : QObject(parent ?
 	m_bytesReceivedDifference(0),
 	m_bytesReceived(0),
 	m_bytesTotal(0),
+	m_writePosition(0),
+	m_speedLimit(SettingsManager::getOption(SettingsManager::Network_TransferSpeedLimitOption).toLongLong() * 1024),
+	m_bandwidthAvailable(0),
 	m_options(options),
 	m_state(UnknownState),
+	m_priority(NormalPriority),
 	m_updateTimer(0),
+	m_progressTimer(0),
 	m_updateInterval(0),
 	m_remainingTime(-1),
 	m_isSelectingPath(false),
-	m_isArchived(false)
+	m_isArchived(false),
+	m_isQueued(false)
 {
 }
 
@@ -75,16 +279,39 @@ Transfer::Transfer(const QSettings &settings, QObject *parent) : QObject(parent
 	m_bytesReceivedDifference(0),
 	m_bytesReceived(settings.value(QLatin1String("bytesReceived")).toLongLong()),
 	m_bytesTotal(settings.value(QLatin1String("bytesTotal")).toLongLong()),
+	m_writePosition(0),
+	m_speedLimit(SettingsManager::getOption(SettingsManager::Network_TransferSpeedLimitOption).toLongLong() * 1024),
+	m_bandwidthAvailable(0),
 	m_options(NoOption),
 	m_state((m_bytesReceived > 0 && m_bytesTotal == m_bytesReceived && QFile::exists(settings.value(QLatin1String("target")).toString())) ? FinishedState : ErrorState),
+	m_priority(NormalPriority),
 	m_updateTimer(0),
+	m_progressTimer(0),
 	m_updateInterval(0),
 	m_remainingTime(-1),
 	m_isSelectingPath(false),
-	m_isArchived(true)
+	m_isArchived(true),
+	m_isQueued(false)
 {
 	m_timeStarted.setTimeSpec(Qt::UTC);
 	m_timeFinished.setTimeSpec(Qt::UTC);
+
+	if (m_state == ErrorState)
+	{
+		const QStringList segments(settings.value(QLatin1String("segments")).toStringList());
+
+		for (int i = 0; i < segments.count(); ++i)
+		{
+			Segment segment;
+			segment.position = segments.at(i).section(QLatin1Char('-'), 0, 0).toLongLong();
+			segment.end = segments.at(i).section(QLatin1Char('-'), 1, 1).toLongLong();
+
+			if (segment.position <= segment.end)
+			{
+				m_segments.append(segment);
+			}
+		}
+	}
 }
 
 Transfer::Transfer(const QUrl &source, const QString &target, TransferOptions options, QObject *parent) : QObject(parent ? parent : TransfersManager::getInstance()),
@@ -97,21 +324,38 @@ Transfer::Transfer(const QUrl &source, const QString &target, TransferOptions op
 	m_bytesReceivedDifference(0),
 	m_bytesReceived(0),
 	m_bytesTotal(0),
+	m_writePosition(0),
+	m_speedLimit(SettingsManager::getOption(SettingsManager::Network_TransferSpeedLimitOption).toLongLong() * 1024),
+	m_bandwidthAvailable(0),
 	m_options(options),
 	m_state(UnknownState),
+	m_priority(NormalPriority),
 	m_updateTimer(0),
+	m_progressTimer(0),
 	m_updateInterval(0),
 	m_remainingTime(-1),
 	m_isSelectingPath(false),
-	m_isArchived(false)
+	m_isArchived(false),
+	m_isQueued(false)
 {
 	QNetworkRequest request;
 	request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
 	request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
 	request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
+	request.setPriority(QNetworkRequest::LowPriority);
 	request.setUrl(QUrl(source));
 
-	start(NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(request), target);
+	if (TransfersManager::canStartTransfer(this))
+	{
+		start(NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(request), target);
+		startSegments();
+	}
+	else
+	{
+		m_pendingRequest = request;
+
+		enqueue();
+	}
 }
 
 Transfer::Transfer(const QNetworkRequest &request, const QString &target, TransferOptions options, QObject *parent) : QObject(parent ? parent : TransfersManager::getInstance()),
@@ -124,15 +368,31 @@ Transfer::Transfer(const QNetworkRequest &request, const QString &target, Transf
 	m_bytesReceivedDifference(0),
 	m_bytesReceived(0),
 	m_bytesTotal(0),
+	m_writePosition(0),
+	m_speedLimit(SettingsManager::getOption(SettingsManager::Network_TransferSpeedLimitOption).toLongLong() * 1024),
+	m_bandwidthAvailable(0),
 	m_options(options),
 	m_state(UnknownState),
+	m_priority(NormalPriority),
 	m_updateTimer(0),
+	m_progressTimer(0),
 	m_updateInterval(0),
 	m_remainingTime(-1),
 	m_isSelectingPath(false),
-	m_isArchived(false)
+	m_isArchived(false),
+	m_isQueued(false)
 {
-	start(NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(request), target);
+	if (TransfersManager::canStartTransfer(this))
+	{
+		start(NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(request), target);
+		startSegments();
+	}
+	else
+	{
+		m_pendingRequest = request;
+
+		enqueue();
+	}
 }
 
 Transfer::Transfer(QNetworkReply *reply, const QString &target, TransferOptions options, QObject *parent) : QObject(parent ? parent : TransfersManager::getInstance()),
@@ -144,15 +404,30 @@ Transfer::Transfer(QNetworkReply *reply, const QString &target, TransferOptions
 	m_bytesReceivedDifference(0),
 	m_bytesReceived(0),
 	m_bytesTotal(0),
+	m_writePosition(0),
+	m_speedLimit(SettingsManager::getOption(SettingsManager::Network_TransferSpeedLimitOption).toLongLong() * 1024),
+	m_bandwidthAvailable(0),
 	m_options(options),
 	m_state(UnknownState),
+	m_priority(NormalPriority),
 	m_updateTimer(0),
+	m_progressTimer(0),
 	m_updateInterval(0),
 	m_remainingTime(-1),
 	m_isSelectingPath(false),
-	m_isArchived(false)
+	m_isArchived(false),
+	m_isQueued(false)
 {
 	start(reply, target);
+
+	if (m_state == RunningState && !TransfersManager::canStartTransfer(this))
+	{
+		suspend();
+	}
+	else
+	{
+		startSegments();
+	}
 }
 
 Transfer::~Transfer()
@@ -165,13 +440,27 @@ Transfer::~Transfer()
 
 void Transfer::timerEvent(QTimerEvent *event)
 {
-	if (event->timerId() == m_updateTimer)
+	if (event->timerId() == m_progressTimer)
+	{
+		killTimer(m_progressTimer);
+
+		m_progressTimer = 0;
+
+		emit progressChanged(m_bytesReceived, m_bytesTotal);
+	}
+	else if (event->timerId() == m_updateTimer)
 	{
 		const qint64 oldSpeed(m_speed);
 
 		m_speed = (m_bytesReceivedDifference * 2);
 		m_bytesReceivedDifference = 0;
 
+		for (int i = 0; i < m_segments.count(); ++i)
+		{
+			m_segments[i].speed = (m_segments.at(i).bytesReceivedDifference * 2);
+			m_segments[i].bytesReceivedDifference = 0;
+		}
+
 		if (m_speed != oldSpeed)
 		{
 			m_speeds.enqueue(m_speed);
@@ -387,6 +676,231 @@ void Transfer::start(QNetworkReply *reply, const QString &target)
 	}
 }
 
+void Transfer::startSegments()
+{
+	const qint64 minimumSegmentSize(1048576);
+	const int segmentsLimit(SettingsManager::getOption(SettingsManager::Network_TransferSegmentsAmountOption).toInt());
+
+	if (segmentsLimit < 2 || !m_reply || !m_writer || m_reply->isFinished() || m_reply->operation() != QNetworkAccessManager::GetOperation || m_reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool() || m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 200 || m_reply->rawHeader(QByteArrayLiteral("Accept-Ranges")).trimmed().toLower() != QByteArrayLiteral("bytes"))
+	{
+		return;
+	}
+
+	const qint64 position(m_writePosition);
+	const qint64 remainingBytes(m_bytesTotal - position);
+
+	if (m_bytesTotal <= 0 || remainingBytes < (minimumSegmentSize * 2))
+	{
+		return;
+	}
+
+	m_writer->preallocate(m_bytesTotal, true);
+
+// progress reported by the original reply includes data not written yet, segments count only what they write
+	m_bytesReceived = position;
+
+	const int segmentsAmount(static_cast<int>(qMin(static_cast<qint64>(segmentsLimit), (remainingBytes / minimumSegmentSize))));
+	const qint64 segmentSize(remainingBytes / segmentsAmount);
+
+	m_segments.reserve(segmentsAmount);
+
+	for (int i = 0; i < segmentsAmount; ++i)
+	{
+		Segment segment;
+		segment.position = (position + (i * segmentSize));
+		segment.end = ((i == (segmentsAmount - 1)) ? (m_bytesTotal - 1) : (segment.position + segmentSize - 1));
+
+		m_segments.append(segment);
+	}
+
+// the original reply keeps serving the first segment, it will be aborted once it reaches its end
+	disconnect(m_reply, nullptr, this, nullptr);
+	connect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleSegmentDataAvailable);
+	connect(m_reply, &QNetworkReply::finished, this, &Transfer::handleSegmentFinished);
+	connect(m_reply, static_cast<void(QNetworkReply::*)(QNetworkReply::NetworkError)>(&QNetworkReply::error), this, &Transfer::handleDownloadError);
+
+	m_segments[0].reply = m_reply;
+	m_reply = nullptr;
+
+	for (int i = 1; i < m_segments.count(); ++i)
+	{
+		startSegment(i);
+	}
+
+	updateSegment(m_segments.at(0).reply, false);
+}
+
+void Transfer::startSegment(int index)
+{
+	Segment &segment(m_segments[index]);
+	QNetworkRequest request;
+	request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
+	request.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+	request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
+	request.setPriority(QNetworkRequest::LowPriority);
+	request.setRawHeader(QByteArrayLiteral("Range"), QStringLiteral("bytes=%1-%2").arg(segment.position).arg(segment.end).toLatin1());
+	request.setUrl(m_source);
+
+	segment.reply = NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(request);
+	segment.reply->setReadBufferSize(4194304);
+	segment.bytesReceivedDifference = 0;
+	segment.speed = 0;
+
+	connect(segment.reply, &QNetworkReply::readyRead, this, &Transfer::handleSegmentDataAvailable);
+	connect(segment.reply, &QNetworkReply::finished, this, &Transfer::handleSegmentFinished);
+	connect(segment.reply, static_cast<void(QNetworkReply::*)(QNetworkReply::NetworkError)>(&QNetworkReply::error), this, &Transfer::handleDownloadError);
+}
+
+void Transfer::splitSegment()
+{
+	const qint64 minimumSegmentSize(1048576);
+	qint64 longestRemainingTime(-1);
+	int activeSegments(0);
+	int index(-1);
+
+	for (int i = 0; i < m_segments.count(); ++i)
+	{
+		const Segment &segment(m_segments.at(i));
+
+		if (!segment.reply)
+		{
+			continue;
+		}
+
+		const qint64 remainingBytes(segment.end - segment.position + 1);
+		const qint64 remainingTime(remainingBytes / qMax(static_cast<qint64>(1), segment.speed));
+
+		++activeSegments;
+
+		if (remainingBytes >= (minimumSegmentSize * 2) && remainingTime > longestRemainingTime)
+		{
+			longestRemainingTime = remainingTime;
+			index = i;
+		}
+	}
+
+	if (index < 0 || activeSegments >= SettingsManager::getOption(SettingsManager::Network_TransferSegmentsAmountOption).toInt())
+	{
+		return;
+	}
+
+	qint64 averageSpeed(0);
+
+	for (int i = 0; i < m_speeds.count(); ++i)
+	{
+		averageSpeed += m_speeds.at(i);
+	}
+
+	if (!m_speeds.isEmpty())
+	{
+		averageSpeed /= (m_speeds.count() * qMax(1, activeSegments));
+	}
+
+// hand over the part of the slowest range that lets both connections finish at the same time
+	const qint64 remainingBytes(m_segments.at(index).end - m_segments.at(index).position + 1);
+	const qint64 segmentSpeed(qMax(static_cast<qint64>(1), m_segments.at(index).speed));
+	const qint64 newSegmentSpeed(qMax(static_cast<qint64>(1), averageSpeed));
+	const qint64 newSegmentSize(qBound(minimumSegmentSize, static_cast<qint64>(static_cast<qreal>(remainingBytes) * newSegmentSpeed / (segmentSpeed + newSegmentSpeed)), (remainingBytes - minimumSegmentSize)));
+	Segment segment;
+	segment.end = m_segments.at(index).end;
+	segment.position = (segment.end - newSegmentSize + 1);
+
+	m_segments[index].end = (segment.position - 1);
+	m_segments.append(segment);
+
+	startSegment(m_segments.count() - 1);
+}
+
+void Transfer::updateSegment(QNetworkReply *reply, bool isFinished)
+{
+	const int index(getSegmentIndex(reply));
+
+	if (index < 0 || !m_writer || (!isFinished && m_writer->isFull()))
+	{
+		return;
+	}
+
+	if (reply->request().hasRawHeader(QByteArrayLiteral("Range")) && reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid() && reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 206)
+	{
+// server ignores ranges, keeping segments would fail the same way on each resume
+		Console::addMessage(tr("Server does not support partial downloads, restarting transfer: %1").arg(m_source.toDisplayString()), Console::NetworkCategory, Console::WarningLevel);
+
+		restart();
+
+		return;
+	}
+
+	Segment &segment(m_segments[index]);
+	const QByteArray data(isFinished ? reply->readAll() : reply->read(acquireBandwidth(reply->bytesAvailable())));
+	const qint64 length(qMin(static_cast<qint64>(data.size()), (segment.end - segment.position + 1)));
+
+	if (length > 0)
+	{
+		m_writer->write(segment.position, ((length < data.size()) ? data.left(static_cast<int>(length)) : data));
+
+		segment.position += length;
+		segment.bytesReceivedDifference += length;
+
+		m_bytesReceivedDifference += length;
+		m_bytesReceived += length;
+
+		scheduleProgressUpdate();
+	}
+
+	if (segment.position <= segment.end)
+	{
+		if (isFinished)
+		{
+			handleDownloadError(QNetworkReply::UnknownContentError);
+		}
+
+		return;
+	}
+
+	disconnect(reply, nullptr, this, nullptr);
+
+	if (!reply->isFinished())
+	{
+		reply->abort();
+	}
+
+	reply->deleteLater();
+
+	m_segments.removeAt(index);
+
+	if (m_segments.isEmpty())
+	{
+		finishSegments();
+	}
+	else
+	{
+		splitSegment();
+	}
+}
+
+void Transfer::finishSegments()
+{
+	if (m_updateTimer != 0)
+	{
+		killTimer(m_updateTimer);
+
+		m_updateTimer = 0;
+	}
+
+	m_bytesReceived = m_bytesTotal;
+
+	if (m_writer)
+	{
+		connect(m_writer, &TransferWriter::closed, this, &Transfer::handleWriterClosed);
+
+		closeWriter();
+	}
+	else
+	{
+		finishTransfer();
+	}
+}
+
 void Transfer::openTarget() const
 {
 	Utils::runApplication(m_openCommand, QUrl::fromLocalFile(getTarget()));
@@ -407,17 +921,220 @@ void Transfer::cancel()
 	{
 		m_device->remove();
 	}
+	else if (m_writer)
+	{
+		closeWriter(true);
+	}
 
 	stop();
 
+	m_segments.clear();
+
+	if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
+	{
+		deleteLater();
+	}
+}
+
+void Transfer::stop()
+{
+	if (m_updateTimer != 0)
+	{
+		killTimer(m_updateTimer);
+
+		m_updateTimer = 0;
+	}
+
+	if (m_reply)
+	{
+		m_reply->abort();
+
+		QTimer::singleShot(250, m_reply, &QNetworkReply::deleteLater);
+	}
+
+	for (int i = 0; i < m_segments.count(); ++i)
+	{
+		if (m_segments.at(i).reply)
+		{
+			QNetworkReply *reply(m_segments.at(i).reply);
+
+			disconnect(reply, nullptr, this, nullptr);
+
+			reply->abort();
+
+			QTimer::singleShot(250, reply, &QNetworkReply::deleteLater);
+
+			m_segments[i].reply = nullptr;
+		}
+	}
+
+	if (m_device && !m_device->inherits("QTemporaryFile"))
+	{
+		m_device->close();
+		m_device->deleteLater();
+		m_device = nullptr;
+	}
+
+	closeWriter();
+
+	m_isQueued = false;
+
+	if (m_state == RunningState)
+	{
+		m_state = ErrorState;
+
+		if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
+		{
+			deleteLater();
+		}
+	}
+
+	m_speeds.clear();
+
+	emit stopped();
+	emit changed();
+}
+
+void Transfer::openWriter(QFile *file, qint64 position)
+{
+	closeWriter();
+
+	m_writer = new TransferWriter(file);
+	m_writer->moveToThread(TransfersManager::getWriterThread());
+	m_writePosition = position;
+
+	if (m_reply)
+	{
+		m_reply->setReadBufferSize(4194304);
+	}
+
+	if (m_bytesTotal > 0 && m_segments.isEmpty())
+	{
+		m_writer->preallocate(m_bytesTotal, false);
+	}
+
+	connect(m_writer, &TransferWriter::drained, this, &Transfer::readPendingData);
+	connect(m_writer, &TransferWriter::writeFailed, this, [&]()
+	{
+		handleDownloadError(QNetworkReply::UnknownContentError);
+	});
+}
+
+void Transfer::closeWriter(bool hasToRemove)
+{
+	if (m_writer)
+	{
+		disconnect(m_writer, &TransferWriter::drained, this, &Transfer::readPendingData);
+		disconnect(m_writer, &TransferWriter::writeFailed, this, nullptr);
+
+		m_writer->close(hasToRemove);
+		m_writer = nullptr;
+	}
+}
+
+void Transfer::finishTransfer()
+{
+	if (m_bytesTotal <= 0 && m_bytesReceived > 0)
+	{
+		m_bytesTotal = m_bytesReceived;
+	}
+
+	if (m_bytesReceived == 0 || m_bytesReceived < m_bytesTotal)
+	{
+		m_state = ErrorState;
+	}
+	else
+	{
+		markAsFinished();
+
+		m_state = FinishedState;
+		m_mimeType = QMimeDatabase().mimeTypeForFile(m_target);
+	}
+
+	emit finished();
+	emit changed();
+
+	if (m_device && (m_options.testFlag(HasToOpenAfterFinishOption) || !m_device->inherits("QTemporaryFile")))
+	{
+		m_device->close();
+		m_device->deleteLater();
+		m_device = nullptr;
+
+		if (m_reply)
+		{
+			QTimer::singleShot(250, m_reply, &QNetworkReply::deleteLater);
+		}
+	}
+
+	if (m_state == FinishedState && m_options.testFlag(HasToOpenAfterFinishOption))
+	{
+		openTarget();
+	}
+
 	if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
 	{
-		deleteLater();
+		deleteLater();
+	}
+}
+
+void Transfer::scheduleProgressUpdate()
+{
+	if (m_progressTimer == 0)
+	{
+		m_progressTimer = startTimer(100);
+	}
+}
+
+void Transfer::enqueue()
+{
+	m_state = RunningState;
+	m_speed = 0;
+	m_remainingTime = -1;
+	m_isQueued = true;
+
+	TransfersManager::enqueueTransfer(this);
+
+	emit changed();
+}
+
+qint64 Transfer::acquireBandwidth(qint64 amount)
+{
+	if (amount <= 0)
+	{
+		return 0;
+	}
+
+	qint64 grantedAmount(amount);
+
+	if (m_speedLimit > 0)
+	{
+		TransfersManager::refillBandwidth(&m_bandwidthTimer, &m_bandwidthAvailable, m_speedLimit);
+
+		grantedAmount = qMin(grantedAmount, m_bandwidthAvailable);
+	}
+
+	grantedAmount = TransfersManager::acquireBandwidth(grantedAmount);
+
+	if (m_speedLimit > 0)
+	{
+		m_bandwidthAvailable -= grantedAmount;
+	}
+
+	if (grantedAmount < amount)
+	{
+		TransfersManager::throttleTransfer(this);
 	}
+
+	return grantedAmount;
 }
 
-void Transfer::stop()
+bool Transfer::suspend()
 {
+	if (m_state != RunningState || m_isQueued || !m_writer || (m_reply && m_reply->operation() != QNetworkAccessManager::GetOperation))
+	{
+		return false;
+	}
+
 	if (m_updateTimer != 0)
 	{
 		killTimer(m_updateTimer);
@@ -427,32 +1144,38 @@ void Transfer::stop()
 
 	if (m_reply)
 	{
+		disconnect(m_reply, nullptr, this, nullptr);
+
 		m_reply->abort();
 
 		QTimer::singleShot(250, m_reply, &QNetworkReply::deleteLater);
-	}
 
-	if (m_device && !m_device->inherits("QTemporaryFile"))
-	{
-		m_device->close();
-		m_device->deleteLater();
-		m_device = nullptr;
+		m_reply = nullptr;
 	}
 
-	if (m_state == RunningState)
+	for (int i = 0; i < m_segments.count(); ++i)
 	{
-		m_state = ErrorState;
-
-		if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
+		if (m_segments.at(i).reply)
 		{
-			deleteLater();
+			QNetworkReply *reply(m_segments.at(i).reply);
+
+			disconnect(reply, nullptr, this, nullptr);
+
+			reply->abort();
+
+			QTimer::singleShot(250, reply, &QNetworkReply::deleteLater);
+
+			m_segments[i].reply = nullptr;
 		}
 	}
 
+	closeWriter();
+
 	m_speeds.clear();
 
-	emit stopped();
-	emit changed();
+	enqueue();
+
+	return true;
 }
 
 void Transfer::markAsStarted()
@@ -471,12 +1194,12 @@ void Transfer::handleDownloadProgress(qint64 bytesReceived, qint64 bytesTotal)
 	m_bytesReceived = (m_bytesStart + bytesReceived);
 	m_bytesTotal = (m_bytesStart + bytesTotal);
 
-	emit progressChanged(bytesReceived, bytesTotal);
+	scheduleProgressUpdate();
 }
 
 void Transfer::handleDataAvailable()
 {
-	if (!m_reply || !m_device)
+	if (!m_reply || (!m_device && !m_writer))
 	{
 		return;
 	}
@@ -487,14 +1210,37 @@ void Transfer::handleDataAvailable()
 
 		if (m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).isValid() && m_reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt() != 206)
 		{
-			m_device->reset();
+			if (m_writer)
+			{
+				m_writePosition = 0;
+			}
+			else
+			{
+				m_device->reset();
+			}
 		}
 	}
 
-	m_device->write(m_reply->readAll());
-	m_device->seek(m_device->size());
+	if (m_writer)
+	{
+		if (m_writer->isFull())
+		{
+			return;
+		}
+
+		const QByteArray data(m_reply->read(acquireBandwidth(m_reply->bytesAvailable())));
+
+		m_writer->write(m_writePosition, data);
+
+		m_writePosition += data.size();
+	}
+	else
+	{
+		m_device->write(m_reply->readAll());
+		m_device->seek(m_device->size());
+	}
 
-	if (m_state == RunningState && m_reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool() && m_bytesTotal >= 0 && m_device->size() == m_bytesTotal)
+	if (m_state == RunningState && m_reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool() && m_bytesTotal >= 0 && (m_writer ? m_writePosition : m_device->size()) == m_bytesTotal)
 	{
 		handleDownloadFinished();
 	}
@@ -511,6 +1257,8 @@ void Transfer::handleDownloadFinished()
 			m_device = nullptr;
 		}
 
+		closeWriter();
+
 		if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
 		{
 			deleteLater();
@@ -546,55 +1294,92 @@ void Transfer::handleDownloadFinished()
 
 	if (m_reply->size() > 0)
 	{
-		m_device->write(m_reply->readAll());
+		if (m_writer)
+		{
+			const QByteArray data(m_reply->readAll());
+
+			m_writer->write(m_writePosition, data);
+
+			m_writePosition += data.size();
+		}
+		else if (m_device)
+		{
+			m_device->write(m_reply->readAll());
+		}
 	}
 
 	disconnect(m_reply, &QNetworkReply::downloadProgress, this, &Transfer::handleDownloadProgress);
 	disconnect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable);
 	disconnect(m_reply, &QNetworkReply::finished, this, &Transfer::handleDownloadFinished);
 
-	m_bytesReceived = (m_device ? m_device->size() : -1);
-
-	if (m_bytesTotal <= 0 && m_bytesReceived > 0)
+	if (m_writer)
 	{
-		m_bytesTotal = m_bytesReceived;
-	}
+		m_bytesReceived = m_writePosition;
 
-	if (m_bytesReceived == 0 || m_bytesReceived < m_bytesTotal)
-	{
-		m_state = ErrorState;
+		QTimer::singleShot(250, m_reply, &QNetworkReply::deleteLater);
+
+		connect(m_writer, &TransferWriter::closed, this, &Transfer::handleWriterClosed);
+
+		closeWriter();
+
+		return;
 	}
-	else
+
+	m_bytesReceived = (m_device ? m_device->size() : -1);
+
+	finishTransfer();
+}
+
+void Transfer::readPendingData()
+{
+	if (m_segments.isEmpty())
 	{
-		markAsFinished();
+		handleDataAvailable();
 
-		m_state = FinishedState;
-		m_mimeType = QMimeDatabase().mimeTypeForFile(m_target);
+		return;
 	}
 
-	emit finished();
-	emit changed();
+	QVector<QNetworkReply*> replies;
+	replies.reserve(m_segments.count());
 
-	if (m_device && (m_options.testFlag(HasToOpenAfterFinishOption) || !m_device->inherits("QTemporaryFile")))
+	for (int i = 0; i < m_segments.count(); ++i)
 	{
-		m_device->close();
-		m_device->deleteLater();
-		m_device = nullptr;
-
-		if (m_reply)
+		if (m_segments.at(i).reply)
 		{
-			QTimer::singleShot(250, m_reply, &QNetworkReply::deleteLater);
+			replies.append(m_segments.at(i).reply);
 		}
 	}
 
-	if (m_state == FinishedState && m_options.testFlag(HasToOpenAfterFinishOption))
+	for (int i = 0; i < replies.count(); ++i)
 	{
-		openTarget();
+		updateSegment(replies.at(i), replies.at(i)->isFinished());
 	}
+}
 
-	if (m_options.testFlag(CanAutoDeleteOption) && !m_isSelectingPath)
+void Transfer::handleSegmentDataAvailable()
+{
+	updateSegment(qobject_cast<QNetworkReply*>(sender()), false);
+}
+
+void Transfer::handleSegmentFinished()
+{
+	updateSegment(qobject_cast<QNetworkReply*>(sender()), true);
+}
+
+void Transfer::handleWriterClosed(bool isSuccessful)
+{
+	if (m_state != RunningState || m_isQueued)
 	{
-		deleteLater();
+		return;
+	}
+
+	if (isSuccessful)
+	{
+		finishTransfer();
+	}
+	else
+	{
+		handleDownloadError(QNetworkReply::UnknownContentError);
 	}
 }
 
@@ -656,6 +1441,24 @@ void Transfer::setUpdateInterval(int interval)
 	}
 }
 
+void Transfer::setPriority(TransferPriority priority)
+{
+	m_priority = priority;
+}
+
+void Transfer::setSpeedLimit(qint64 limit)
+{
+	if (limit != m_speedLimit)
+	{
+		m_speedLimit = qMax(static_cast<qint64>(0), limit);
+		m_bandwidthAvailable = 0;
+
+		m_bandwidthTimer.invalidate();
+
+		readPendingData();
+	}
+}
+
 QUrl Transfer::getSource() const
 {
 	return m_source;
@@ -767,19 +1570,85 @@ Transfer::TransferState Transfer::getState() const
 	return m_state;
 }
 
+Transfer::TransferPriority Transfer::getPriority() const
+{
+	return m_priority;
+}
+
+qint64 Transfer::getSpeedLimit() const
+{
+	return m_speedLimit;
+}
+
 int Transfer::getRemainingTime() const
 {
 	return m_remainingTime;
 }
 
+int Transfer::getSegmentIndex(QNetworkReply *reply) const
+{
+	if (!reply)
+	{
+		return -1;
+	}
+
+	for (int i = 0; i < m_segments.count(); ++i)
+	{
+		if (m_segments.at(i).reply == reply)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+QStringList Transfer::getSegments() const
+{
+	QStringList segments;
+	segments.reserve(m_segments.count());
+
+	for (int i = 0; i < m_segments.count(); ++i)
+	{
+		segments.append(QStringLiteral("%1-%2").arg(m_segments.at(i).position).arg(m_segments.at(i).end));
+	}
+
+	return segments;
+}
+
 bool Transfer::isArchived() const
 {
 	return m_isArchived;
 }
 
+bool Transfer::isQueued() const
+{
+	return m_isQueued;
+}
+
 bool Transfer::resume()
 {
-	if (m_state != ErrorState || !QFile::exists(m_target))
+	if (!m_pendingRequest.url().isEmpty() && (m_isQueued || m_state == ErrorState))
+	{
+		if (!m_isQueued && !TransfersManager::canStartTransfer(this))
+		{
+			enqueue();
+
+			return true;
+		}
+
+		const QNetworkRequest request(m_pendingRequest);
+
+		m_pendingRequest = {};
+		m_isQueued = false;
+
+		start(NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(request), m_target);
+		startSegments();
+
+		return true;
+	}
+
+	if ((m_state != ErrorState && !m_isQueued) || !QFile::exists(m_target))
 	{
 		return false;
 	}
@@ -791,9 +1660,55 @@ bool Transfer::resume()
 		return restart();
 	}
 
+	if (!m_isQueued && !TransfersManager::canStartTransfer(this))
+	{
+		enqueue();
+
+		return true;
+	}
+
+	m_isQueued = false;
+
+	if (!m_segments.isEmpty())
+	{
+		QFile *file(new QFile(m_target));
+
+		if (!file->open(QIODevice::ReadWrite))
+		{
+			file->deleteLater();
+
+			return false;
+		}
+
+		m_state = RunningState;
+		m_timeStarted = QDateTime::currentDateTimeUtc();
+		m_timeFinished = {};
+		m_bytesStart = 0;
+		m_bytesReceived = m_bytesTotal;
+
+		for (int i = 0; i < m_segments.count(); ++i)
+		{
+			m_bytesReceived -= (m_segments.at(i).end - m_segments.at(i).position + 1);
+		}
+
+		openWriter(file, 0);
+
+		for (int i = 0; i < m_segments.count(); ++i)
+		{
+			startSegment(i);
+		}
+
+		if (m_updateTimer == 0 && m_updateInterval > 0)
+		{
+			m_updateTimer = startTimer(m_updateInterval);
+		}
+
+		return true;
+	}
+
 	QFile *file(new QFile(m_target));
 
-	if (!file->open(QIODevice::WriteOnly | QIODevice::Append))
+	if (!file->open(QIODevice::ReadWrite))
 	{
 		file->deleteLater();
 
@@ -801,19 +1716,20 @@ bool Transfer::resume()
 	}
 
 	m_state = RunningState;
-	m_device = file;
 	m_timeStarted = QDateTime::currentDateTimeUtc();
 	m_timeFinished = {};
-	m_bytesStart = file->size();
+	m_bytesStart = qMax(file->size(), m_writePosition);
 
 	QNetworkRequest request;
 	request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
 	request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
-	request.setRawHeader(QStringLiteral("Range").toLatin1(), QStringLiteral("bytes=%1-").arg(file->size()).toLatin1());
+	request.setPriority(QNetworkRequest::LowPriority);
+	request.setRawHeader(QStringLiteral("Range").toLatin1(), QStringLiteral("bytes=%1-").arg(m_bytesStart).toLatin1());
 	request.setUrl(m_source);
 
 	m_reply = NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(request);
 
+	openWriter(file, m_bytesStart);
 	handleDataAvailable();
 
 	connect(m_reply, &QNetworkReply::downloadProgress, this, &Transfer::handleDownloadProgress);
@@ -831,13 +1747,21 @@ bool Transfer::resume()
 
 bool Transfer::restart()
 {
+	const bool isQueued(m_isQueued);
+
+	if (m_state == RunningState)
+	{
+		m_state = ErrorState;
+	}
+
 	stop();
 
+	m_segments.clear();
 	m_isArchived = false;
 
 	QFile *file(new QFile(m_target));
 
-	if (!file->open(QIODevice::WriteOnly))
+	if (!file->open(QIODevice::ReadWrite))
 	{
 		file->deleteLater();
 
@@ -845,17 +1769,31 @@ bool Transfer::restart()
 	}
 
 	m_state = RunningState;
-	m_device = file;
 	m_timeStarted = QDateTime::currentDateTimeUtc();
 	m_timeFinished = {};
 	m_bytesStart = 0;
+	m_bytesReceived = 0;
+
+	openWriter(file, 0);
+
+	m_writer->truncate();
+
+	if (!isQueued && !TransfersManager::canStartTransfer(this))
+	{
+		closeWriter();
+		enqueue();
+
+		return true;
+	}
 
 	QNetworkRequest request;
 	request.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
 	request.setHeader(QNetworkRequest::UserAgentHeader, NetworkManagerFactory::getUserAgent());
+	request.setPriority(QNetworkRequest::LowPriority);
 	request.setUrl(m_source);
 
 	m_reply = NetworkManagerFactory::getNetworkManager(m_options.testFlag(IsPrivateOption))->get(request);
+	m_reply->setReadBufferSize(4194304);
 
 	handleDataAvailable();
 
@@ -869,47 +1807,114 @@ bool Transfer::restart()
 		m_updateTimer = startTimer(m_updateInterval);
 	}
 
-	return true;
-}
+	return true;
+}
+
+bool Transfer::setTarget(const QString &target, bool canOverwriteExisting)
+{
+	if (m_target == target)
+	{
+		return false;
+	}
+
+	QString mutableTarget(target);
+
+	if (!canOverwriteExisting && !m_options.testFlag(CanOverwriteOption) && QFile::exists(target))
+	{
+		const int result(QMessageBox::question(Application::getActiveWindow(), tr("Question"), tr("File with the same name already exists.\nDo you want to overwrite it?\n\n%1").arg(target), QMessageBox::Yes, QMessageBox::No, QMessageBox::Cancel));
+
+		if (result == QMessageBox::No)
+		{
+			const QFileInfo information(target);
+			const QString path(Utils::getSavePath(information.fileName(), information.path(), {}, true).path);
+
+			if (path.isEmpty())
+			{
+				cancel();
+
+				return false;
+			}
+
+			mutableTarget = path;
+		}
+		else if (result == QMessageBox::Cancel)
+		{
+			cancel();
+
+			return false;
+		}
+	}
+
+	if (m_writer)
+	{
+		if (m_reply)
+		{
+			disconnect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable);
+			disconnect(m_reply, &QNetworkReply::finished, this, &Transfer::handleDownloadFinished);
+		}
+
+		connect(m_writer, &TransferWriter::closed, this, [=](bool isSuccessful)
+		{
+			if (isSuccessful)
+			{
+				if (QFile::exists(mutableTarget))
+				{
+					QFile::remove(mutableTarget);
+				}
+
+				if (QFile::rename(m_target, mutableTarget))
+				{
+					m_target = mutableTarget;
+
+					emit changed();
+				}
+			}
+
+			if (m_state != RunningState || m_isQueued || (!m_reply && m_segments.isEmpty()))
+			{
+				return;
+			}
+
+			QFile *file(new QFile(m_target, this));
+
+			if (!isSuccessful || !file->open(QIODevice::ReadWrite))
+			{
+				file->deleteLater();
+
+				handleDownloadError(QNetworkReply::UnknownContentError);
+
+				return;
+			}
+
+			openWriter(file, m_writePosition);
 
-bool Transfer::setTarget(const QString &target, bool canOverwriteExisting)
-{
-	if (m_target == target)
-	{
-		return false;
-	}
+// segments kept their replies connected, data received meanwhile is waiting in them
+			if (!m_reply)
+			{
+				readPendingData();
 
-	QString mutableTarget(target);
+				return;
+			}
 
-	if (!canOverwriteExisting && !m_options.testFlag(CanOverwriteOption) && QFile::exists(target))
-	{
-		const int result(QMessageBox::question(Application::getActiveWindow(), tr("Question"), tr("File with the same name already exists.\nDo you want to overwrite it?\n\n%1").arg(target), QMessageBox::Yes, QMessageBox::No, QMessageBox::Cancel));
+			connect(m_reply, &QNetworkReply::readyRead, this, &Transfer::handleDataAvailable);
+			connect(m_reply, &QNetworkReply::finished, this, &Transfer::handleDownloadFinished);
 
-		if (result == QMessageBox::No)
-		{
-			const QFileInfo information(target);
-			const QString path(Utils::getSavePath(information.fileName(), information.path(), {}, true).path);
+			handleDataAvailable();
 
-			if (path.isEmpty())
+			if (m_reply->isFinished())
 			{
-				cancel();
-
-				return false;
+				handleDownloadFinished();
 			}
+		});
 
-			mutableTarget = path;
-		}
-		else if (result == QMessageBox::Cancel)
-		{
-			cancel();
+		closeWriter();
 
-			return false;
-		}
+		return true;
 	}
 
 	if (!m_device)
 	{
-		if (m_state != FinishedState)
+		if (m_state != FinishedState && !m_isQueued)
 		{
 			return false;
 		}
@@ -955,10 +1960,10 @@ bool Transfer::setTarget(const QString &target, bool canOverwriteExisting)
 
 		m_device->close();
 		m_device->deleteLater();
+		m_device = nullptr;
 	}
 
-	m_device = file;
-
+	openWriter(file, file->size());
 	handleDataAvailable();
 
 	if (!m_reply || m_reply->isFinished())
@@ -974,8 +1979,46 @@ bool Transfer::setTarget(const QString &target, bool canOverwriteExisting)
 }
 
 TransfersManager::TransfersManager(QObject *parent) : QObject(parent),
-	m_saveTimer(0)
+	m_saveTimer(0),
+	m_queueTimer(0),
+	m_throttleTimer(0)
+{
+	handleOptionChanged(SettingsManager::Network_TransfersLimitAmountGlobalOption, SettingsManager::getOption(SettingsManager::Network_TransfersLimitAmountGlobalOption));
+	handleOptionChanged(SettingsManager::Network_TransfersLimitAmountHostOption, SettingsManager::getOption(SettingsManager::Network_TransfersLimitAmountHostOption));
+	handleOptionChanged(SettingsManager::Network_TransfersSpeedLimitOption, SettingsManager::getOption(SettingsManager::Network_TransfersSpeedLimitOption));
+
+	connect(SettingsManager::getInstance(), &SettingsManager::optionChanged, this, &TransfersManager::handleOptionChanged);
+}
+
+TransfersManager::~TransfersManager()
 {
+	for (int i = 0; i < m_transfers.count(); ++i)
+	{
+		if (m_transfers.at(i)->getState() == Transfer::RunningState)
+		{
+			m_transfers.at(i)->stop();
+		}
+	}
+
+	for (int i = 0; i < m_privateTransfers.count(); ++i)
+	{
+		if (m_privateTransfers.at(i)->getState() == Transfer::RunningState)
+		{
+			m_privateTransfers.at(i)->stop();
+		}
+	}
+
+	if (m_writerThread)
+	{
+		QObject *barrier(new QObject());
+		barrier->moveToThread(m_writerThread);
+
+		connect(barrier, &QObject::destroyed, m_writerThread, &QThread::quit, Qt::DirectConnection);
+
+		barrier->deleteLater();
+
+		m_writerThread->wait();
+	}
 }
 
 void TransfersManager::createInstance()
@@ -996,6 +2039,32 @@ void TransfersManager::timerEvent(QTimerEvent *event)
 
 		save();
 	}
+	else if (event->timerId() == m_queueTimer)
+	{
+		killTimer(m_queueTimer);
+
+		m_queueTimer = 0;
+
+		startQueuedTransfers();
+	}
+	else if (event->timerId() == m_throttleTimer)
+	{
+		killTimer(m_throttleTimer);
+
+		m_throttleTimer = 0;
+
+		const QVector<QPointer<Transfer> > transfers(m_throttledTransfers);
+
+		m_throttledTransfers.clear();
+
+		for (int i = 0; i < transfers.count(); ++i)
+		{
+			if (transfers.at(i) && transfers.at(i)->getState() == Transfer::RunningState && !transfers.at(i)->isQueued())
+			{
+				transfers.at(i)->readPendingData();
+			}
+		}
+	}
 }
 
 void TransfersManager::scheduleSave()
@@ -1012,7 +2081,7 @@ void TransfersManager::updateRunningTransfersState()
 
 	for (int i = 0; i < m_transfers.count(); ++i)
 	{
-		if (m_transfers.at(i)->getState() == Transfer::RunningState)
+		if (m_transfers.at(i)->getState() == Transfer::RunningState && !m_transfers.at(i)->isQueued())
 		{
 			hasRunningTransfers = true;
 
@@ -1023,9 +2092,247 @@ void TransfersManager::updateRunningTransfersState()
 	m_hasRunningTransfers = hasRunningTransfers;
 }
 
+void TransfersManager::scheduleQueuedTransfers()
+{
+	if (m_queueTimer == 0 && !m_queuedTransfers.isEmpty())
+	{
+		m_queueTimer = startTimer(0);
+	}
+}
+
+void TransfersManager::startQueuedTransfers()
+{
+	for (int i = (m_queuedTransfers.count() - 1); i >= 0; --i)
+	{
+		if (!m_queuedTransfers.at(i) || !m_queuedTransfers.at(i)->isQueued())
+		{
+			m_queuedTransfers.removeAt(i);
+		}
+	}
+
+	while (!m_queuedTransfers.isEmpty())
+	{
+		int index(-1);
+
+		for (int i = 0; i < m_queuedTransfers.count(); ++i)
+		{
+			if ((index < 0 || m_queuedTransfers.at(i)->getPriority() > m_queuedTransfers.at(index)->getPriority()) && hasCapacity(m_queuedTransfers.at(i)))
+			{
+				index = i;
+			}
+		}
+
+		if (index < 0)
+		{
+			break;
+		}
+
+		Transfer *transfer(m_queuedTransfers.takeAt(index));
+
+		if (!transfer->resume())
+		{
+			transfer->stop();
+		}
+	}
+}
+
+void TransfersManager::enqueueTransfer(Transfer *transfer)
+{
+	if (!m_queuedTransfers.contains(transfer))
+	{
+		m_queuedTransfers.append(transfer);
+	}
+}
+
+void TransfersManager::throttleTransfer(Transfer *transfer)
+{
+	if (!m_throttledTransfers.contains(transfer))
+	{
+		m_throttledTransfers.append(transfer);
+	}
+
+	if (m_instance && m_instance->m_throttleTimer == 0)
+	{
+		m_instance->m_throttleTimer = m_instance->startTimer(100);
+	}
+}
+
+void TransfersManager::refillBandwidth(QElapsedTimer *timer, qint64 *bandwidth, qint64 limit)
+{
+	if (!timer->isValid())
+	{
+		timer->start();
+
+		*bandwidth = (limit / 10);
+
+		return;
+	}
+
+	const qint64 amount((limit * qMin(timer->nsecsElapsed(), static_cast<qint64>(1000000000))) / 1000000000);
+
+	if (amount > 0)
+	{
+		*bandwidth = qMin(limit, (*bandwidth + amount));
+
+		timer->restart();
+	}
+}
+
+qint64 TransfersManager::acquireBandwidth(qint64 amount)
+{
+	if (!m_measurementTimer.isValid())
+	{
+		m_measurementTimer.start();
+	}
+	else if (m_measurementTimer.elapsed() >= 1000)
+	{
+		if (!m_isMeasurementThrottled)
+		{
+			m_bandwidthEstimate = qMax(((m_bandwidthEstimate * 3) / 4), ((m_measuredBytes * 1000) / m_measurementTimer.elapsed()));
+		}
+
+		m_measuredBytes = 0;
+		m_isMeasurementThrottled = false;
+
+		m_measurementTimer.restart();
+	}
+
+	qint64 limit(m_speedLimit);
+
+// long polling or streaming page could keep its request open indefinitely, so it is prioritized only for limited time
+	if (!m_pageRequests.isEmpty())
+	{
+		const qint64 currentTime(QDateTime::currentMSecsSinceEpoch());
+		QHash<QObject*, qint64>::iterator iterator(m_pageRequests.begin());
+
+		while (iterator != m_pageRequests.end())
+		{
+			if (iterator.value() < currentTime)
+			{
+				iterator = m_pageRequests.erase(iterator);
+			}
+			else
+			{
+				++iterator;
+			}
+		}
+	}
+
+	if (!m_pageRequests.isEmpty())
+	{
+		const qint64 referenceLimit((limit > 0) ? limit : m_bandwidthEstimate);
+
+		if (referenceLimit > 0)
+		{
+			limit = qMax(static_cast<qint64>(16384), (referenceLimit / 4));
+		}
+
+		m_isMeasurementThrottled = true;
+	}
+
+	if (limit <= 0)
+	{
+		m_measuredBytes += amount;
+
+		return amount;
+	}
+
+	refillBandwidth(&m_bandwidthTimer, &m_bandwidthAvailable, limit);
+
+	const qint64 grantedAmount(qMin(amount, m_bandwidthAvailable));
+
+	m_bandwidthAvailable -= grantedAmount;
+	m_measuredBytes += grantedAmount;
+
+	return grantedAmount;
+}
+
+bool TransfersManager::canStartTransfer(Transfer *transfer)
+{
+	if (m_instance && !m_transfers.contains(transfer) && !m_unmanagedTransfers.contains(transfer))
+	{
+		for (int i = (m_unmanagedTransfers.count() - 1); i >= 0; --i)
+		{
+			if (!m_unmanagedTransfers.at(i))
+			{
+				m_unmanagedTransfers.removeAt(i);
+			}
+		}
+
+		m_unmanagedTransfers.append(transfer);
+
+		connect(transfer, &Transfer::finished, m_instance, &TransfersManager::scheduleQueuedTransfers);
+		connect(transfer, &Transfer::stopped, m_instance, &TransfersManager::scheduleQueuedTransfers);
+		connect(transfer, &Transfer::destroyed, m_instance, &TransfersManager::scheduleQueuedTransfers);
+	}
+
+	if (!hasCapacity(transfer))
+	{
+		return false;
+	}
+
+	for (int i = 0; i < m_queuedTransfers.count(); ++i)
+	{
+		const Transfer *queuedTransfer(m_queuedTransfers.at(i));
+
+		if (!queuedTransfer || queuedTransfer == transfer || !queuedTransfer->isQueued() || queuedTransfer->getPriority() < transfer->getPriority())
+		{
+			continue;
+		}
+
+		if ((queuedTransfer->getPriority() > transfer->getPriority() || !transfer->isQueued() || i < m_queuedTransfers.indexOf(const_cast<Transfer*>(transfer))) && hasCapacity(queuedTransfer))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool TransfersManager::hasCapacity(const Transfer *transfer)
+{
+	if (m_transfersLimit <= 0 && m_hostTransfersLimit <= 0)
+	{
+		return true;
+	}
+
+	const QString host(transfer->getSource().host());
+	QVector<Transfer*> transfers(m_transfers);
+	int transfersAmount(0);
+	int hostTransfersAmount(0);
+
+	for (int i = 0; i < m_unmanagedTransfers.count(); ++i)
+	{
+		if (m_unmanagedTransfers.at(i))
+		{
+			transfers.append(m_unmanagedTransfers.at(i));
+		}
+	}
+
+	for (int i = 0; i < transfers.count(); ++i)
+	{
+		const Transfer *activeTransfer(transfers.at(i));
+
+		if (activeTransfer == transfer || activeTransfer->getState() != Transfer::RunningState || activeTransfer->isQueued())
+		{
+			continue;
+		}
+
+		++transfersAmount;
+
+		if (activeTransfer->getSource().host() == host)
+		{
+			++hostTransfersAmount;
+		}
+	}
+
+	return ((m_transfersLimit <= 0 || transfersAmount < m_transfersLimit) && (m_hostTransfersLimit <= 0 || hostTransfersAmount < m_hostTransfersLimit));
+}
+
 void TransfersManager::addTransfer(Transfer *transfer)
 {
 	m_transfers.append(transfer);
+	m_unmanagedTransfers.removeAll(transfer);
 
 	transfer->setUpdateInterval(500);
 
@@ -1052,6 +2359,8 @@ void TransfersManager::addTransfer(Transfer *transfer)
 
 void TransfersManager::save()
 {
+	const TraceRecorder::Span span("TransfersManager::save");
+
 	if (SessionsManager::isReadOnly() || SettingsManager::getOption(SettingsManager::Browser_PrivateModeOption).toBool() || !SettingsManager::getOption(SettingsManager::History_RememberDownloadsOption).toBool())
 	{
 		return;
@@ -1077,6 +2386,13 @@ void TransfersManager::save()
 		history.setValue(QStringLiteral("%1/bytesTotal").arg(entry), m_transfers.at(i)->getBytesTotal());
 		history.setValue(QStringLiteral("%1/bytesReceived").arg(entry), m_transfers.at(i)->getBytesReceived());
 
+		const QStringList segments(m_transfers.at(i)->getSegments());
+
+		if (!segments.isEmpty())
+		{
+			history.setValue(QStringLiteral("%1/segments").arg(entry), segments);
+		}
+
 		++entry;
 	}
 
@@ -1100,7 +2416,7 @@ void TransfersManager::handleTransferStarted()
 
 	if (transfer && transfer->getState() != Transfer::CancelledState)
 	{
-		if (transfer->getState() == Transfer::RunningState)
+		if (transfer->getState() == Transfer::RunningState && !transfer->isQueued())
 		{
 			m_hasRunningTransfers = true;
 		}
@@ -1116,6 +2432,7 @@ void TransfersManager::handleTransferFinished()
 	Transfer *transfer(qobject_cast<Transfer*>(sender()));
 
 	updateRunningTransfersState();
+	scheduleQueuedTransfers();
 
 	if (transfer)
 	{
@@ -1146,11 +2463,40 @@ void TransfersManager::handleTransferChanged()
 	}
 }
 
+void TransfersManager::handleOptionChanged(int identifier, const QVariant &value)
+{
+	switch (identifier)
+	{
+		case SettingsManager::Network_TransfersLimitAmountGlobalOption:
+			m_transfersLimit = value.toInt();
+
+			scheduleQueuedTransfers();
+
+			break;
+		case SettingsManager::Network_TransfersLimitAmountHostOption:
+			m_hostTransfersLimit = value.toInt();
+
+			scheduleQueuedTransfers();
+
+			break;
+		case SettingsManager::Network_TransfersSpeedLimitOption:
+			m_speedLimit = (value.toLongLong() * 1024);
+			m_bandwidthAvailable = 0;
+
+			m_bandwidthTimer.invalidate();
+
+			break;
+		default:
+			break;
+	}
+}
+
 void TransfersManager::handleTransferStopped()
 {
 	Transfer *transfer(qobject_cast<Transfer*>(sender()));
 
 	updateRunningTransfersState();
+	scheduleQueuedTransfers();
 
 	if (transfer)
 	{
@@ -1165,6 +2511,18 @@ TransfersManager* TransfersManager::getInstance()
 	return m_instance;
 }
 
+QThread* TransfersManager::getWriterThread()
+{
+	if (!m_writerThread)
+	{
+		m_writerThread = new QThread(m_instance);
+		m_writerThread->setObjectName(QLatin1String("TransferWriter"));
+		m_writerThread->start();
+	}
+
+	return m_writerThread;
+}
+
 Transfer* TransfersManager::startTransfer(const QUrl &source, const QString &target, Transfer::TransferOptions options)
 {
 	Transfer *transfer(new Transfer(source, target, options, m_instance));
@@ -1217,6 +2575,7 @@ QVector<Transfer*> TransfersManager::getTransfers()
 {
 	if (!m_isInitilized)
 	{
+		const TraceRecorder::Span span("TransfersManager::getTransfers");
 		QSettings history(SessionsManager::getWritableDataPath(QLatin1String("transfers.ini")), QSettings::IniFormat);
 		const QStringList entries(history.childGroups());
 
@@ -1255,7 +2614,14 @@ bool TransfersManager::removeTransfer(Transfer *transfer, bool keepFile)
 
 	if (transfer->getState() == Transfer::RunningState)
 	{
-		transfer->stop();
+		if (keepFile)
+		{
+			transfer->stop();
+		}
+		else
+		{
+			transfer->cancel();
+		}
 	}
 
 	if (!keepFile && !transfer->getTarget().isEmpty() && QFile::exists(transfer->getTarget()))
@@ -1265,6 +2631,8 @@ bool TransfersManager::removeTransfer(Transfer *transfer, bool keepFile)
 
 	emit m_instance->transferRemoved(transfer);
 
+	m_instance->scheduleQueuedTransfers();
+
 	transfer->deleteLater();
 
 	return true;
@@ -1303,6 +2671,27 @@ bool TransfersManager::isDownloading(const QString &source, const QString &targe
 	return false;
 }
 
+void TransfersManager::registerPageRequest(QNetworkReply *reply)
+{
+	if (!m_instance || !reply || reply->isFinished())
+	{
+		return;
+	}
+
+	QObject *object(reply);
+
+	m_pageRequests.insert(object, (QDateTime::currentMSecsSinceEpoch() + 30000));
+
+	connect(reply, &QNetworkReply::finished, m_instance, [=]()
+	{
+		m_pageRequests.remove(object);
+	});
+	connect(reply, &QNetworkReply::destroyed, m_instance, [=]()
+	{
+		m_pageRequests.remove(object);
+	});
+}
+
 bool TransfersManager::hasRunningTransfers()
 {
 	return m_hasRunningTransfers;
@@ -20,11 +20,15 @@
 #ifndef OTTER_TRANSFERSMANAGER_H
 #define OTTER_TRANSFERSMANAGER_H
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QFile>
 #include <QtCore/QMimeType>
+#include <QtCore/QMutex>
 #include <QtCore/QPointer>
 #include <QtCore/QQueue>
+#include <QtCore/QSet>
 #include <QtCore/QSettings>
+#include <QtCore/QThread>
 #include <QtNetwork/QNetworkReply>
 
 namespace Otter
@@ -32,6 +36,51 @@ namespace Otter
 
 class NetworkManager;
 
+class TransferWriter final : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit TransferWriter(QFile *file);
+
+	void write(qint64 position, const QByteArray &data);
+	void preallocate(qint64 size, bool canResize);
+	void truncate();
+	void close(bool hasToRemove = false);
+	bool isFull();
+
+protected:
+	void enqueueBuffer();
+
+protected slots:
+	void processBuffers();
+	void allocate(qint64 size, bool canResize);
+	void truncateFile();
+	void closeFile(bool hasToRemove);
+
+private:
+	struct Buffer final
+	{
+		QByteArray data;
+		qint64 position = 0;
+	};
+
+	QFile *m_file;
+	Buffer m_buffer;
+	QQueue<Buffer> m_buffers;
+	QVector<QByteArray> m_freeBuffers;
+	QMutex m_mutex;
+	qint64 m_pendingBytes;
+	bool m_isProcessingScheduled;
+	bool m_isWaitingForDrain;
+	bool m_hasError;
+
+signals:
+	void drained();
+	void writeFailed();
+	void closed(bool isSuccessful);
+};
+
 class Transfer : public QObject
 {
 	Q_OBJECT
@@ -60,6 +109,13 @@ public:
 		FinishedState
 	};
 
+	enum TransferPriority
+	{
+		LowPriority = 0,
+		NormalPriority,
+		HighPriority
+	};
+
 	explicit Transfer(TransferOptions options = CanAskForPathOption, QObject *parent = nullptr);
 	Transfer(const QSettings &settings, QObject *parent = nullptr);
 	Transfer(const QUrl &source, const QString &target = {}, TransferOptions options = CanAskForPathOption, QObject *parent = nullptr);
@@ -68,6 +124,8 @@ public:
 	~Transfer();
 
 	virtual void setUpdateInterval(int interval);
+	void setPriority(TransferPriority priority);
+	void setSpeedLimit(qint64 limit);
 	virtual QUrl getSource() const;
 	virtual QString getSuggestedFileName();
 	virtual QString getTarget() const;
@@ -79,8 +137,12 @@ public:
 	virtual qint64 getBytesTotal() const;
 	TransferOptions getOptions() const;
 	virtual TransferState getState() const;
+	TransferPriority getPriority() const;
+	qint64 getSpeedLimit() const;
 	virtual int getRemainingTime() const;
+	QStringList getSegments() const;
 	bool isArchived() const;
+	bool isQueued() const;
 
 public slots:
 	void openTarget() const;
@@ -92,8 +154,30 @@ public slots:
 	virtual bool setTarget(const QString &target, bool canOverwriteExisting = false);
 
 protected:
+	struct Segment final
+	{
+		QPointer<QNetworkReply> reply;
+		qint64 position = 0;
+		qint64 end = 0;
+		qint64 bytesReceivedDifference = 0;
+		qint64 speed = 0;
+	};
+
 	void timerEvent(QTimerEvent *event) override;
 	void start(QNetworkReply *reply, const QString &target);
+	void startSegments();
+	void startSegment(int index);
+	void splitSegment();
+	void updateSegment(QNetworkReply *reply, bool isFinished);
+	void finishSegments();
+	void openWriter(QFile *file, qint64 position);
+	void closeWriter(bool hasToRemove = false);
+	void finishTransfer();
+	void scheduleProgressUpdate();
+	void enqueue();
+	qint64 acquireBandwidth(qint64 amount);
+	int getSegmentIndex(QNetworkReply *reply) const;
+	bool suspend();
 
 protected slots:
 	void markAsStarted();
@@ -102,10 +186,16 @@ protected slots:
 	void handleDataAvailable();
 	void handleDownloadFinished();
 	void handleDownloadError(QNetworkReply::NetworkError error);
+	void handleSegmentDataAvailable();
+	void handleSegmentFinished();
+	void handleWriterClosed(bool isSuccessful);
+	void readPendingData();
 
 private:
 	QPointer<QNetworkReply> m_reply;
 	QPointer<QFile> m_device;
+	QPointer<TransferWriter> m_writer;
+	QNetworkRequest m_pendingRequest;
 	QUrl m_source;
 	QString m_target;
 	QString m_openCommand;
@@ -113,19 +203,27 @@ private:
 	QDateTime m_timeStarted;
 	QDateTime m_timeFinished;
 	QMimeType m_mimeType;
+	QElapsedTimer m_bandwidthTimer;
 	QQueue<qint64> m_speeds;
+	QVector<Segment> m_segments;
 	qint64 m_speed;
 	qint64 m_bytesStart;
 	qint64 m_bytesReceivedDifference;
 	qint64 m_bytesReceived;
 	qint64 m_bytesTotal;
+	qint64 m_writePosition;
+	qint64 m_speedLimit;
+	qint64 m_bandwidthAvailable;
 	TransferOptions m_options;
 	TransferState m_state;
+	TransferPriority m_priority;
 	int m_updateTimer;
+	int m_progressTimer;
 	int m_updateInterval;
 	int m_remainingTime;
 	bool m_isSelectingPath;
 	bool m_isArchived;
+	bool m_isQueued;
 
 signals:
 	void progressChanged(qint64 bytesReceived, qint64 bytesTotal);
@@ -133,6 +231,8 @@ signals:
 	void finished();
 	void changed();
 	void stopped();
+
+friend class TransfersManager;
 };
 
 class TransfersManager final : public QObject
@@ -144,6 +244,7 @@ public:
 	static void addTransfer(Transfer *transfer);
 	static void clearTransfers(int period = 0);
 	static TransfersManager* getInstance();
+	static QThread* getWriterThread();
 	static Transfer* startTransfer(const QUrl &source, const QString &target = {}, Transfer::TransferOptions options = Transfer::CanAskForPathOption);
 	static Transfer* startTransfer(const QNetworkRequest &request, const QString &target = {}, Transfer::TransferOptions options = Transfer::CanAskForPathOption);
 	static Transfer* startTransfer(QNetworkReply *reply, const QString &target = {}, Transfer::TransferOptions options = Transfer::CanAskForPathOption);
@@ -151,13 +252,23 @@ public:
 	static bool removeTransfer(Transfer *transfer, bool keepFile = true);
 	static bool isDownloading(const QString &source, const QString &target = {});
 	static bool hasRunningTransfers();
+	static void registerPageRequest(QNetworkReply *reply);
 
 protected:
 	explicit TransfersManager(QObject *parent);
+	~TransfersManager();
 
 	void timerEvent(QTimerEvent *event) override;
 	void scheduleSave();
 	void updateRunningTransfersState();
+	void scheduleQueuedTransfers();
+	void startQueuedTransfers();
+	static void enqueueTransfer(Transfer *transfer);
+	static void throttleTransfer(Transfer *transfer);
+	static void refillBandwidth(QElapsedTimer *timer, qint64 *bandwidth, qint64 limit);
+	static qint64 acquireBandwidth(qint64 amount);
+	static bool canStartTransfer(Transfer *transfer);
+	static bool hasCapacity(const Transfer *transfer);
 
 protected slots:
 	void save();
@@ -165,15 +276,32 @@ protected slots:
 	void handleTransferFinished();
 	void handleTransferChanged();
 	void handleTransferStopped();
+	void handleOptionChanged(int identifier, const QVariant &value);
 
 private:
 	int m_saveTimer;
+	int m_queueTimer;
+	int m_throttleTimer;
 
 	static TransfersManager *m_instance;
+	static QThread *m_writerThread;
 	static QVector<Transfer*> m_transfers;
 	static QVector<Transfer*> m_privateTransfers;
+	static QVector<QPointer<Transfer> > m_unmanagedTransfers;
+	static QVector<QPointer<Transfer> > m_queuedTransfers;
+	static QVector<QPointer<Transfer> > m_throttledTransfers;
+	static QHash<QObject*, qint64> m_pageRequests;
+	static QElapsedTimer m_bandwidthTimer;
+	static QElapsedTimer m_measurementTimer;
+	static qint64 m_bandwidthAvailable;
+	static qint64 m_bandwidthEstimate;
+	static qint64 m_measuredBytes;
+	static qint64 m_speedLimit;
+	static int m_transfersLimit;
+	static int m_hostTransfersLimit;
 	static bool m_isInitilized;
 	static bool m_hasRunningTransfers;
+	static bool m_isMeasurementThrottled;
 
 signals:
 	void transferStarted(Transfer *transfer);
@@ -181,6 +309,8 @@ signals:
 	void transferChanged(Transfer *transfer);
 	void transferStopped(Transfer *transfer);
 	void transferRemoved(Transfer *transfer);
+
+friend class Transfer;
 };
 
 }
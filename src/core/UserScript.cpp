@@ -275,49 +275,6 @@ QString UserScript::getSource()
 	return m_source;
 }
 
-QString UserScript::checkUrlSubString(const QString &rule, const QString &urlSubString, QString generatedUrl, int position) const
-{
-	if (rule.isEmpty())
-	{
-		return urlSubString;
-	}
-
-	for (int i = 0; i < urlSubString.length(); ++i)
-	{
-		const QChar character(urlSubString.at(i));
-
-		if (rule.at(position) == QLatin1Char('*'))
-		{
-			const QString wildcardString(urlSubString.mid(i));
-
-			for (int j = 1; j < wildcardString.length(); ++j)
-			{
-				const QString result(checkUrlSubString(rule, urlSubString.right(wildcardString.length() - j), generatedUrl + wildcardString.left(j), (position + 1)));
-
-				if (!result.isEmpty())
-				{
-					return result;
-				}
-			}
-		}
-		else if (rule.at(position) != character)
-		{
-			return {};
-		}
-
-		++position;
-
-		generatedUrl += character;
-
-		if (position == rule.length())
-		{
-			return generatedUrl;
-		}
-	}
-
-	return {};
-}
-
 QUrl UserScript::getHomePage() const
 {
 	return m_homePage;
@@ -350,16 +307,20 @@ QStringList UserScript::getMatchRules() const
 
 QVector<UserScript*> UserScript::getUserScriptsForUrl(const QUrl &url, UserScript::InjectionTime injectionTime, bool isSubFrame)
 {
-	const QStringList scriptNames(AddonsManager::getUserScripts());
-	QVector<UserScript*> scripts;
+	QVector<UserScript*> scripts(AddonsManager::getUserScriptsForUrl(url));
 
-	for (int i = 0; i < scriptNames.count(); ++i)
+	if (injectionTime == AnyTime && !isSubFrame)
 	{
-		UserScript *script(AddonsManager::getUserScript(scriptNames.at(i)));
+		return scripts;
+	}
+
+	for (int i = (scripts.count() - 1); i >= 0; --i)
+	{
+		const UserScript *script(scripts.at(i));
 
-		if (script->isEnabled() && (injectionTime == AnyTime || script->getInjectionTime() == injectionTime) && (!isSubFrame || script->shouldRunOnSubFrames()) && script->isEnabledForUrl(url))
+		if ((injectionTime != AnyTime && script->getInjectionTime() != injectionTime) || (isSubFrame && !script->shouldRunOnSubFrames()))
 		{
-			scripts.append(script);
+			scripts.removeAt(i);
 		}
 	}
 
@@ -376,73 +337,11 @@ Addon::AddonType UserScript::getType() const
 	return Addon::UserScriptType;
 }
 
-bool UserScript::isEnabledForUrl(const QUrl &url)
-{
-	if (url.scheme() != QLatin1String("http") && url.scheme() != QLatin1String("https") && url.scheme() != QLatin1String("file") && url.scheme() != QLatin1String("ftp") && url.scheme() != QLatin1String("about"))
-	{
-		return false;
-	}
-
-	bool isEnabled(!(m_includeRules.length() > 0 || m_matchRules.length() > 0));
-
-	if (checkUrl(url, m_matchRules))
-	{
-		isEnabled = true;
-	}
-
-	if (!isEnabled && checkUrl(url, m_includeRules))
-	{
-		isEnabled = true;
-	}
-
-	if (isEnabled && checkUrl(url, m_excludeRules))
-	{
-		isEnabled = false;
-	}
-
-	return isEnabled;
-}
-
 bool UserScript::canRemove() const
 {
 	return true;
 }
 
-bool UserScript::checkUrl(const QUrl &url, const QStringList &rules) const
-{
-	for (int i = 0; i < rules.count(); ++i)
-	{
-		QString rule(rules.at(i));
-
-		if (rule.startsWith(QLatin1Char('/')) && rule.endsWith(QLatin1Char('/')))
-		{
-			return QRegularExpression(rule.mid(1, rule.length() - 2)).match(url.url()).hasMatch();
-		}
-
-		if (rule.contains(QLatin1String(".tld"), Qt::CaseInsensitive))
-		{
-			rule.replace(QLatin1String(".tld"), url.topLevelDomain(), Qt::CaseInsensitive);
-		}
-
-		bool useExactMatch(true);
-
-		if (rule.endsWith(QLatin1Char('*')))
-		{
-			useExactMatch = false;
-			rule = rule.left(rule.length() - 1);
-		}
-
-		const QString result(checkUrlSubString(rule, url.url(), {}));
-
-		if (!result.isEmpty() && ((useExactMatch && url.url() == result) || (!useExactMatch && url.url().startsWith(result))))
-		{
-			return true;
-		}
-	}
-
-	return false;
-}
-
 bool UserScript::shouldRunOnSubFrames() const
 {
 	return m_shouldRunOnSubFrames;
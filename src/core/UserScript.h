@@ -58,7 +58,6 @@ public:
 	static QVector<UserScript*> getUserScriptsForUrl(const QUrl &url, InjectionTime injectionTime = AnyTime, bool isSubFrame = false);
 	InjectionTime getInjectionTime() const;
 	AddonType getType() const override;
-	bool isEnabledForUrl(const QUrl &url);
 	bool canRemove() const override;
 	bool shouldRunOnSubFrames() const;
 	bool remove() override;
@@ -66,10 +65,6 @@ public:
 public slots:
 	void reload();
 
-protected:
-	QString checkUrlSubString(const QString &rule, const QString &urlSubString, QString generatedUrl, int position = 0) const;
-	bool checkUrl(const QUrl &url, const QStringList &rules) const;
-
 private:
 	IconFetchJob *m_iconFetchJob;
 	QString m_path;
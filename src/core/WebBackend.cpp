@@ -42,6 +42,11 @@ WebBackend::WebBackend(QObject *parent) : QObject(parent), Addon()
 {
 }
 
+void WebBackend::cancelThumbnail(const QUrl &url)
+{
+	Q_UNUSED(url)
+}
+
 QVector<SpellCheckManager::DictionaryInformation> WebBackend::getDictionaries() const
 {
 	return {};
@@ -84,6 +84,9 @@ public:
 	virtual BackendCapabilities getCapabilities() const;
 	virtual bool requestThumbnail(const QUrl &url, const QSize &size) = 0;
 
+public slots:
+	virtual void cancelThumbnail(const QUrl &url);
+
 signals:
 	void thumbnailAvailable(const QUrl &url, const QPixmap &thumbnail, const QString &title);
 };
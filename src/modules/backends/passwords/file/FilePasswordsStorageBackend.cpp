@@ -21,6 +21,7 @@
 #include "FilePasswordsStorageBackend.h"
 #include "../../../../core/Console.h"
 #include "../../../../core/SessionsManager.h"
+#include "../../../../core/TraceRecorder.h"
 
 #include <QtCore/QFile>
 #include <QtCore/QJsonArray>
@@ -37,6 +38,8 @@ FilePasswordsStorageBackend::FilePasswordsStorageBackend(QObject *parent) : Pass
 
 void FilePasswordsStorageBackend::initialize()
 {
+	const TraceRecorder::Span span("FilePasswordsStorageBackend::initialize");
+
 	m_isInitialized = true;
 
 	const QString path(SessionsManager::getWritableDataPath(QLatin1String("passwords.json")));
@@ -80,7 +80,7 @@ QtWebEngineWebWidget::QtWebEngineWebWidget(const QVariantMap &parameters, WebBac
 	{
 		m_documentLoadingProgress = progress;
 
-		emit pageInformationChanged(DocumentLoadingProgressInformation, progress);
+		emit pageInformationChanged({{DocumentLoadingProgressInformation, progress}});
 	});
 	connect(m_page, &QtWebEnginePage::loadStarted, this, &QtWebEngineWebWidget::handleLoadStarted);
 	connect(m_page, &QtWebEnginePage::loadFinished, this, &QtWebEngineWebWidget::handleLoadFinished);
@@ -966,7 +966,7 @@ void QtWebEngineWebWidget::handleLoadStarted()
 
 	emit geometryChanged();
 	emit loadingStateChanged(OngoingLoadingState);
-	emit pageInformationChanged(DocumentLoadingProgressInformation, 0);
+	emit pageInformationChanged({{DocumentLoadingProgressInformation, 0}});
 }
 
 void QtWebEngineWebWidget::handleLoadFinished()
@@ -34,6 +34,7 @@
 #include "../../../../core/PasswordsManager.h"
 #include "../../../../core/SettingsManager.h"
 #include "../../../../core/ThemesManager.h"
+#include "../../../../core/TransfersManager.h"
 #include "../../../../core/WebBackend.h"
 #include "../../../../ui/AuthenticationDialog.h"
 #include "../../../../ui/ContentsDialog.h"
@@ -61,8 +62,16 @@ QtWebKitNetworkManager::QtWebKitNetworkManager(bool isPrivate, QtWebKitCookieJar
 	m_contentState(WebWidget::UnknownContentState),
 	m_doNotTrackPolicy(NetworkManagerFactory::SkipTrackPolicy),
 	m_isSecureValue(UnknownValue),
+	m_documentBytesReceived(0),
+	m_documentBytesTotal(0),
+	m_totalBytesReceived(0),
+	m_totalBytesTotal(0),
 	m_bytesReceivedDifference(0),
+	m_requestsStarted(0),
+	m_requestsFinished(0),
+	m_loadingMessage(NoLoadingMessage),
 	m_loadingSpeedTimer(0),
+	m_statisticsTimer(0),
 	m_areImagesEnabled(true),
 	m_canSendReferrer(true)
 {
@@ -108,6 +117,10 @@ void QtWebKitNetworkManager::timerEvent(QTimerEvent *event)
 	{
 		updateLoadingSpeed();
 	}
+	else if (event->timerId() == m_statisticsTimer)
+	{
+		updateStatistics();
+	}
 }
 
 void QtWebKitNetworkManager::addContentBlockingException(const QUrl &url, NetworkManager::ResourceType resourceType)
@@ -123,11 +136,13 @@ void QtWebKitNetworkManager::addContentBlockingException(const QUrl &url, Networ
 void QtWebKitNetworkManager::resetStatistics()
 {
 	killTimer(m_loadingSpeedTimer);
+	killTimer(m_statisticsTimer);
 
-	const QList<WebWidget::PageInformation> keys(m_pageInformation.keys());
+	QMap<WebWidget::PageInformation, QVariant> information(m_pageInformation);
 
 	m_sslInformation = WebWidget::SslInformation();
 	m_loadingSpeedTimer = 0;
+	m_statisticsTimer = 0;
 	m_blockedElements.clear();
 	m_contentBlockingProfiles.clear();
 	m_contentBlockingExceptions.clear();
@@ -144,15 +159,25 @@ void QtWebKitNetworkManager::resetStatistics()
 	m_baseReply = nullptr;
 	m_contentState = WebWidget::UnknownContentState;
 	m_isSecureValue = UnknownValue;
-	m_bytesReceivedDifference = 0;
+	m_loadingMessage = NoLoadingMessage;
+	m_documentBytesReceived.store(0);
+	m_documentBytesTotal.store(0);
+	m_totalBytesReceived.store(0);
+	m_totalBytesTotal.store(0);
+	m_bytesReceivedDifference.store(0);
+	m_requestsStarted.store(0);
+	m_requestsFinished.store(0);
 
 	updateLoadingSpeed();
 
-	for (int i = 0; i < keys.count(); ++i)
+	QMap<WebWidget::PageInformation, QVariant>::iterator iterator;
+
+	for (iterator = information.begin(); iterator != information.end(); ++iterator)
 	{
-		emit pageInformationChanged(keys.at(i), m_pageInformation.value(keys.at(i)));
+		iterator.value() = m_pageInformation.value(iterator.key());
 	}
 
+	emit pageInformationChanged(information);
 	emit contentStateChanged(m_contentState);
 }
 
@@ -180,9 +205,10 @@ void QtWebKitNetworkManager::handleDownloadProgress(qint64 bytesReceived, qint64
 		}
 		else
 		{
-			setPageInformation(WebWidget::DocumentBytesReceivedInformation, bytesReceived);
-			setPageInformation(WebWidget::DocumentBytesTotalInformation, bytesTotal);
-			setPageInformation(WebWidget::DocumentLoadingProgressInformation, ((bytesTotal > 0) ? Utils::calculatePercent(bytesReceived, bytesTotal) : -1));
+			m_documentBytesReceived.store(bytesReceived);
+			m_documentBytesTotal.store(bytesTotal);
+
+			scheduleStatisticsUpdate();
 		}
 	}
 
@@ -192,31 +218,25 @@ void QtWebKitNetworkManager::handleDownloadProgress(qint64 bytesReceived, qint64
 	}
 
 	const QUrl url(reply->url());
+	QPair<qint64, bool> &statistics(m_replies[reply]);
+	const qint64 difference(bytesReceived - statistics.first);
 
-	if (url.isValid() && url.scheme() != QLatin1String("data"))
-	{
-		setPageInformation(WebWidget::LoadingMessageInformation, tr("Receiving data from %1…").arg(Utils::extractHost(reply->url())));
-	}
-
-	const qint64 difference(bytesReceived - m_replies[reply].first);
-
-	m_replies[reply].first = bytesReceived;
+	statistics.first = bytesReceived;
 
-	if (!m_replies[reply].second && bytesTotal > 0)
+	if (!statistics.second && bytesTotal > 0)
 	{
-		m_replies[reply].second = true;
+		statistics.second = true;
 
-		m_pageInformation[WebWidget::TotalBytesTotalInformation] = (m_pageInformation[WebWidget::TotalBytesTotalInformation].toLongLong() + bytesTotal);
+		m_totalBytesTotal.fetchAndAddRelaxed(bytesTotal);
 	}
 
-	if (difference <= 0)
+	if (difference > 0)
 	{
-		return;
+		m_bytesReceivedDifference.fetchAndAddRelaxed(difference);
+		m_totalBytesReceived.fetchAndAddRelaxed(difference);
 	}
 
-	m_bytesReceivedDifference += difference;
-
-	setPageInformation(WebWidget::TotalBytesReceivedInformation, (m_pageInformation[WebWidget::TotalBytesReceivedInformation].toLongLong() + difference));
+	scheduleStatisticsUpdate(((url.isValid() && url.scheme() != QLatin1String("data")) ? ReceivingDataLoadingMessage : NoLoadingMessage), url);
 }
 
 void QtWebKitNetworkManager::handleRequestFinished(QNetworkReply *reply)
@@ -229,8 +249,7 @@ void QtWebKitNetworkManager::handleRequestFinished(QNetworkReply *reply)
 	const QUrl url(reply->url());
 
 	m_replies.remove(reply);
-
-	setPageInformation(WebWidget::RequestsFinishedInformation, (m_pageInformation[WebWidget::RequestsFinishedInformation].toInt() + 1));
+	m_requestsFinished.fetchAndAddRelaxed(1);
 
 	if (reply == m_baseReply)
 	{
@@ -265,10 +284,7 @@ void QtWebKitNetworkManager::handleRequestFinished(QNetworkReply *reply)
 		}
 	}
 
-	if (url.isValid() && url.scheme() != QLatin1String("data"))
-	{
-		setPageInformation(WebWidget::LoadingMessageInformation, tr("Completed request to %1").arg(Utils::extractHost(url)));
-	}
+	scheduleStatisticsUpdate(((url.isValid() && url.scheme() != QLatin1String("data")) ? CompletedRequestLoadingMessage : NoLoadingMessage), url);
 
 	disconnect(reply, &QNetworkReply::downloadProgress, this, &QtWebKitNetworkManager::handleDownloadProgress);
 }
@@ -414,6 +430,9 @@ void QtWebKitNetworkManager::handleOnlineStateChanged(bool isOnline)
 
 void QtWebKitNetworkManager::handleLoadFinished(bool result)
 {
+	m_loadingMessage = NoLoadingMessage;
+
+	updateStatistics();
 	setPageInformation(WebWidget::LoadingFinishedInformation, QDateTime::currentDateTime());
 	setPageInformation(WebWidget::LoadingMessageInformation, tr("Loading finished"));
 	setPageInformation(WebWidget::LoadingSpeedInformation, 0);
@@ -431,9 +450,67 @@ void QtWebKitNetworkManager::handleLoadFinished(bool result)
 
 void QtWebKitNetworkManager::updateLoadingSpeed()
 {
-	setPageInformation(WebWidget::LoadingSpeedInformation, (m_bytesReceivedDifference * 2));
+	setPageInformation(WebWidget::LoadingSpeedInformation, (m_bytesReceivedDifference.fetchAndStoreRelaxed(0) * 2));
+}
+
+void QtWebKitNetworkManager::updateStatistics()
+{
+	killTimer(m_statisticsTimer);
+
+	m_statisticsTimer = 0;
+
+	const qint64 documentBytesReceived(m_documentBytesReceived.load());
+	const qint64 documentBytesTotal(m_documentBytesTotal.load());
+	QMap<WebWidget::PageInformation, QVariant> information;
+
+	if (documentBytesTotal != 0)
+	{
+		information[WebWidget::DocumentBytesReceivedInformation] = documentBytesReceived;
+		information[WebWidget::DocumentBytesTotalInformation] = documentBytesTotal;
+		information[WebWidget::DocumentLoadingProgressInformation] = ((documentBytesTotal > 0) ? Utils::calculatePercent(documentBytesReceived, documentBytesTotal) : -1);
+	}
+
+	information[WebWidget::TotalBytesTotalInformation] = m_totalBytesTotal.load();
+	information[WebWidget::TotalBytesReceivedInformation] = m_totalBytesReceived.load();
+	information[WebWidget::RequestsStartedInformation] = m_requestsStarted.load();
+	information[WebWidget::RequestsFinishedInformation] = m_requestsFinished.load();
+
+	switch (m_loadingMessage)
+	{
+		case SendingRequestLoadingMessage:
+			information[WebWidget::LoadingMessageInformation] = tr("Sending request to %1…").arg(m_loadingMessageUrl.host());
+
+			break;
+		case ReceivingDataLoadingMessage:
+			information[WebWidget::LoadingMessageInformation] = tr("Receiving data from %1…").arg(Utils::extractHost(m_loadingMessageUrl));
+
+			break;
+		case CompletedRequestLoadingMessage:
+			information[WebWidget::LoadingMessageInformation] = tr("Completed request to %1").arg(Utils::extractHost(m_loadingMessageUrl));
+
+			break;
+		default:
+			break;
+	}
 
-	m_bytesReceivedDifference = 0;
+	setPageInformation(information);
+
+	m_loadingMessage = NoLoadingMessage;
+	m_loadingMessageUrl.clear();
+}
+
+void QtWebKitNetworkManager::scheduleStatisticsUpdate(LoadingMessage message, const QUrl &url)
+{
+	if (message != NoLoadingMessage)
+	{
+		m_loadingMessage = message;
+		m_loadingMessageUrl = url;
+	}
+
+	if (m_statisticsTimer == 0)
+	{
+		m_statisticsTimer = startTimer(33);
+	}
 }
 
 void QtWebKitNetworkManager::updateOptions(const QUrl &url)
@@ -536,13 +613,34 @@ void QtWebKitNetworkManager::updateOptions(const QUrl &url)
 	}
 }
 
-void QtWebKitNetworkManager::setPageInformation(WebWidget::PageInformation key, const QVariant &value)
+void QtWebKitNetworkManager::setPageInformation(WebWidget::PageInformation key, const QVariant &value, bool onlyIfChanged)
 {
-	if (m_loadingSpeedTimer != 0 || key != WebWidget::LoadingMessageInformation)
+	if ((m_loadingSpeedTimer != 0 || key != WebWidget::LoadingMessageInformation) && (!onlyIfChanged || m_pageInformation.value(key) != value))
 	{
 		m_pageInformation[key] = value;
 
-		emit pageInformationChanged(key, value);
+		emit pageInformationChanged({{key, value}});
+	}
+}
+
+void QtWebKitNetworkManager::setPageInformation(const QMap<WebWidget::PageInformation, QVariant> &information)
+{
+	QMap<WebWidget::PageInformation, QVariant> changedInformation;
+	QMap<WebWidget::PageInformation, QVariant>::const_iterator iterator;
+
+	for (iterator = information.constBegin(); iterator != information.constEnd(); ++iterator)
+	{
+		if ((m_loadingSpeedTimer != 0 || iterator.key() != WebWidget::LoadingMessageInformation) && m_pageInformation.value(iterator.key()) != iterator.value())
+		{
+			m_pageInformation[iterator.key()] = iterator.value();
+
+			changedInformation[iterator.key()] = iterator.value();
+		}
+	}
+
+	if (!changedInformation.isEmpty())
+	{
+		emit pageInformationChanged(changedInformation);
 	}
 }
 
@@ -695,7 +793,7 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 		}
 	}
 
-	setPageInformation(WebWidget::RequestsStartedInformation, (m_pageInformation[WebWidget::RequestsStartedInformation].toULongLong() + 1));
+	m_requestsStarted.fetchAndAddRelaxed(1);
 
 	QNetworkRequest mutableRequest(request);
 
@@ -724,8 +822,6 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 	mutableRequest.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, false);
 #endif
 
-	setPageInformation(WebWidget::LoadingMessageInformation, tr("Sending request to %1…").arg(request.url().host()));
-
 	QNetworkReply *reply(nullptr);
 
 	if (operation == GetOperation && request.url().isLocalFile() && QFileInfo(request.url().toLocalFile()).isDir())
@@ -772,6 +868,11 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 	if (!m_baseReply && request.url() == m_mainRequestUrl)
 	{
 		m_baseReply = reply;
+
+		if (m_widget)
+		{
+			TransfersManager::registerPageRequest(reply);
+		}
 	}
 
 	if (m_baseReply && m_isSecureValue != FalseValue)
@@ -804,6 +905,8 @@ QNetworkReply* QtWebKitNetworkManager::createRequest(QNetworkAccessManager::Oper
 		m_loadingSpeedTimer = startTimer(500);
 	}
 
+	scheduleStatisticsUpdate(SendingRequestLoadingMessage, request.url());
+
 	return reply;
 }
 
@@ -814,9 +917,20 @@ CookieJar* QtWebKitNetworkManager::getCookieJar() const
 
 QVariant QtWebKitNetworkManager::getPageInformation(WebWidget::PageInformation key) const
 {
-	if (key == WebWidget::RequestsBlockedInformation)
-	{
-		return m_blockedRequests.count();
+	switch (key)
+	{
+		case WebWidget::TotalBytesReceivedInformation:
+			return m_totalBytesReceived.load();
+		case WebWidget::TotalBytesTotalInformation:
+			return m_totalBytesTotal.load();
+		case WebWidget::RequestsBlockedInformation:
+			return m_blockedRequests.count();
+		case WebWidget::RequestsFinishedInformation:
+			return m_requestsFinished.load();
+		case WebWidget::RequestsStartedInformation:
+			return m_requestsStarted.load();
+		default:
+			break;
 	}
 
 	return m_pageInformation.value(key);
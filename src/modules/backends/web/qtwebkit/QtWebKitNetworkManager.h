@@ -26,6 +26,7 @@
 #include "../../../../core/NetworkManager.h"
 #include "../../../../core/NetworkManagerFactory.h"
 
+#include <QtCore/QAtomicInteger>
 #include <QtNetwork/QNetworkRequest>
 
 namespace Otter
@@ -51,13 +52,24 @@ public:
 	WebWidget::ContentStates getContentState() const;
 
 protected:
+	enum LoadingMessage
+	{
+		NoLoadingMessage = 0,
+		SendingRequestLoadingMessage,
+		ReceivingDataLoadingMessage,
+		CompletedRequestLoadingMessage
+	};
+
 	void timerEvent(QTimerEvent *event) override;
 	void addContentBlockingException(const QUrl &url, NetworkManager::ResourceType resourceType);
 	void resetStatistics();
 	void registerTransfer(QNetworkReply *reply);
 	void updateLoadingSpeed();
+	void updateStatistics();
+	void scheduleStatisticsUpdate(LoadingMessage message = NoLoadingMessage, const QUrl &url = {});
 	void updateOptions(const QUrl &url);
-	void setPageInformation(WebWidget::PageInformation key, const QVariant &value);
+	void setPageInformation(WebWidget::PageInformation key, const QVariant &value, bool onlyIfChanged = false);
+	void setPageInformation(const QMap<WebWidget::PageInformation, QVariant> &information);
 	void setFormRequest(const QUrl &url);
 	void setMainRequest(const QUrl &url);
 	void setWidget(QtWebKitWebWidget *widget);
@@ -86,6 +98,7 @@ private:
 	QString m_userAgent;
 	QUrl m_formRequestUrl;
 	QUrl m_mainRequestUrl;
+	QUrl m_loadingMessageUrl;
 	WebWidget::SslInformation m_sslInformation;
 	QStringList m_blockedElements;
 	QStringList m_unblockedHosts;
@@ -99,15 +112,23 @@ private:
 	WebWidget::ContentStates m_contentState;
 	NetworkManagerFactory::DoNotTrackPolicy m_doNotTrackPolicy;
 	TrileanValue m_isSecureValue;
-	qint64 m_bytesReceivedDifference;
+	QAtomicInteger<qint64> m_documentBytesReceived;
+	QAtomicInteger<qint64> m_documentBytesTotal;
+	QAtomicInteger<qint64> m_totalBytesReceived;
+	QAtomicInteger<qint64> m_totalBytesTotal;
+	QAtomicInteger<qint64> m_bytesReceivedDifference;
+	QAtomicInt m_requestsStarted;
+	QAtomicInt m_requestsFinished;
+	LoadingMessage m_loadingMessage;
 	int m_loadingSpeedTimer;
+	int m_statisticsTimer;
 	bool m_areImagesEnabled;
 	bool m_canSendReferrer;
 
 	static WebBackend *m_backend;
 
 signals:
-	void pageInformationChanged(WebWidget::PageInformation, const QVariant &value);
+	void pageInformationChanged(const QMap<WebWidget::PageInformation, QVariant> &information);
 	void requestBlocked(const NetworkManager::ResourceInformation &request);
 	void contentStateChanged(WebWidget::ContentStates state);
 
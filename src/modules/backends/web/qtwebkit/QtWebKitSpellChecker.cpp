@@ -22,15 +22,26 @@
 #include "QtWebKitSpellChecker.h"
 #include "QtWebKitWebBackend.h"
 
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QCoreApplication>
 #include <QtCore/QTextBoundaryFinder>
 
 namespace Otter
 {
 
 Sonnet::Speller* QtWebKitSpellChecker::m_speller(nullptr);
+QCache<QString, bool> QtWebKitSpellChecker::m_verdicts(10000);
+QMutex QtWebKitSpellChecker::m_mutex;
+QThreadPool* QtWebKitSpellChecker::m_threadPool(nullptr);
 
 QtWebKitSpellChecker::QtWebKitSpellChecker() : QWebSpellChecker()
 {
+	if (!m_threadPool)
+	{
+		m_threadPool = new QThreadPool(QCoreApplication::instance());
+		m_threadPool->setMaxThreadCount(1);
+	}
+
 	setDictionary(QtWebKitWebBackend::getActiveDictionary());
 
 	connect(QtWebKitWebBackend::getInstance(), &QtWebKitWebBackend::activeDictionaryChanged, this, &QtWebKitSpellChecker::setDictionary);
@@ -56,6 +67,7 @@ void QtWebKitSpellChecker::checkSpellingOfString(const QString &word, int *missp
 
 	QTextBoundaryFinder finder(QTextBoundaryFinder::Word, word);
 	QTextBoundaryFinder::BoundaryReasons boundary(finder.boundaryReasons());
+	QStringList pendingWords;
 	int start(finder.position());
 	int end(finder.position());
 	bool inWord(boundary.testFlag(QTextBoundaryFinder::StartOfItem));
@@ -72,13 +84,15 @@ void QtWebKitSpellChecker::checkSpellingOfString(const QString &word, int *missp
 
 			if (isValidWord(string))
 			{
-				if (m_speller->isMisspelled(string))
+				if (*misspellingLocation >= 0)
+				{
+					pendingWords.append(string);
+				}
+				else if (isMisspelled(string))
 				{
 					*misspellingLocation = start;
 					*misspellingLength = (end - start);
 				}
-
-				return;
 			}
 
 			inWord = false;
@@ -90,6 +104,29 @@ void QtWebKitSpellChecker::checkSpellingOfString(const QString &word, int *missp
 			inWord = true;
 		}
 	}
+
+	if (!pendingWords.isEmpty())
+	{
+		QtConcurrent::run(m_threadPool, &QtWebKitSpellChecker::checkWords, pendingWords);
+	}
+}
+
+void QtWebKitSpellChecker::checkWords(const QStringList &words)
+{
+	for (int i = 0; i < words.count(); ++i)
+	{
+		QMutexLocker locker(&m_mutex);
+
+		if (!m_speller)
+		{
+			return;
+		}
+
+		if (!m_verdicts.contains(words.at(i)))
+		{
+			m_verdicts.insert(words.at(i), new bool(m_speller->isMisspelled(words.at(i))));
+		}
+	}
 }
 
 void QtWebKitSpellChecker::checkGrammarOfString(const QString &word, QList<QWebSpellChecker::GrammarDetail> &detail, int *badGrammarLocation, int *badGrammarLength)
@@ -102,17 +139,23 @@ void QtWebKitSpellChecker::checkGrammarOfString(const QString &word, QList<QWebS
 
 void QtWebKitSpellChecker::learnWord(const QString &word)
 {
+	QMutexLocker locker(&m_mutex);
+
 	if (m_speller)
 	{
 		m_speller->addToPersonal(word);
+		m_verdicts.remove(word);
 	}
 }
 
 void QtWebKitSpellChecker::ignoreWordInSpellDocument(const QString &word)
 {
+	QMutexLocker locker(&m_mutex);
+
 	if (m_speller)
 	{
 		m_speller->addToSession(word);
+		m_verdicts.remove(word);
 	}
 }
 
@@ -120,6 +163,8 @@ void QtWebKitSpellChecker::guessesForWord(const QString &word, const QString &co
 {
 	Q_UNUSED(context);
 
+	QMutexLocker locker(&m_mutex);
+
 	if (m_speller)
 	{
 		guesses = m_speller->suggest(word);
@@ -128,6 +173,10 @@ void QtWebKitSpellChecker::guessesForWord(const QString &word, const QString &co
 
 void QtWebKitSpellChecker::setDictionary(const QString &dictionary)
 {
+	QMutexLocker locker(&m_mutex);
+
+	m_verdicts.clear();
+
 	if (dictionary.isEmpty() && m_speller)
 	{
 		delete m_speller;
@@ -156,6 +205,8 @@ QString QtWebKitSpellChecker::autoCorrectSuggestionForMisspelledWord(const QStri
 
 QStringList QtWebKitSpellChecker::getSuggestions(const QString &word)
 {
+	QMutexLocker locker(&m_mutex);
+
 	if (!m_speller)
 	{
 		m_speller = new Sonnet::Speller(QtWebKitWebBackend::getActiveDictionary());
@@ -179,6 +230,29 @@ bool QtWebKitSpellChecker::isGrammarCheckingEnabled()
 	return false;
 }
 
+bool QtWebKitSpellChecker::isMisspelled(const QString &word)
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (!m_speller)
+	{
+		return false;
+	}
+
+	const bool *verdict(m_verdicts.object(word));
+
+	if (verdict)
+	{
+		return *verdict;
+	}
+
+	const bool isMisspelled(m_speller->isMisspelled(word));
+
+	m_verdicts.insert(word, new bool(isMisspelled));
+
+	return isMisspelled;
+}
+
 bool QtWebKitSpellChecker::isValidWord(const QString &string)
 {
 	if (string.isEmpty() || (string.length() == 1 && !string.at(0).isLetter()))
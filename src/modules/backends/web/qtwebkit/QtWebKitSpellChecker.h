@@ -25,6 +25,10 @@
 #include "qwebkitplatformplugin.h"
 #include "../../../../../3rdparty/sonnet/src/core/speller.h"
 
+#include <QtCore/QCache>
+#include <QtCore/QMutex>
+#include <QtCore/QThreadPool>
+
 namespace Otter
 {
 
@@ -48,6 +52,8 @@ public:
 	bool isGrammarCheckingEnabled() override;
 
 protected:
+	static void checkWords(const QStringList &words);
+	static bool isMisspelled(const QString &word);
 	static bool isValidWord(const QString &string);
 
 protected slots:
@@ -55,6 +61,9 @@ protected slots:
 
 private:
 	static Sonnet::Speller *m_speller;
+	static QCache<QString, bool> m_verdicts;
+	static QMutex m_mutex;
+	static QThreadPool *m_threadPool;
 };
 
 }
@@ -29,6 +29,7 @@
 #include <QtCore/QDir>
 #include <QtCore/QPointer>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QTimerEvent>
 #include <QtWebKit/QWebHistoryInterface>
 #include <QtWebKit/QWebSettings>
 #include <QtWebKitWidgets/QWebFrame>
@@ -275,33 +276,114 @@ int QtWebKitWebBackend::getOptionIdentifier(QtWebKitWebBackend::OptionIdentifier
 
 bool QtWebKitWebBackend::requestThumbnail(const QUrl &url, const QSize &size)
 {
-	QtWebKitWebPageThumbnailJob *job(new QtWebKitWebPageThumbnailJob(url, size, this));
+	if (m_thumbnailJobs.contains(url))
+	{
+		return true;
+	}
 
-	connect(job, &QtWebKitWebPageThumbnailJob::jobFinished, [=](bool isSuccess)
+	for (int i = 0; i < m_thumbnailRequests.count(); ++i)
 	{
-		Q_UNUSED(isSuccess)
+		if (m_thumbnailRequests.at(i).url == url)
+		{
+			m_thumbnailRequests[i].size = size;
+
+			return true;
+		}
+	}
 
-		emit thumbnailAvailable(url, job->getThumbnail(), job->getTitle());
-	});
+	ThumbnailRequestInformation request;
+	request.url = url;
+	request.size = size;
 
-	job->start();
+	m_thumbnailRequests.append(request);
+
+	startThumbnailJobs();
 
 	return true;
 }
 
+void QtWebKitWebBackend::cancelThumbnail(const QUrl &url)
+{
+	if (m_thumbnailJobs.contains(url))
+	{
+		QtWebKitWebPageThumbnailJob *job(m_thumbnailJobs.take(url));
+		job->disconnect(this);
+		job->cancel();
+
+		startThumbnailJobs();
+
+		return;
+	}
+
+	for (int i = 0; i < m_thumbnailRequests.count(); ++i)
+	{
+		if (m_thumbnailRequests.at(i).url == url)
+		{
+			m_thumbnailRequests.removeAt(i);
+
+			break;
+		}
+	}
+}
+
+void QtWebKitWebBackend::startThumbnailJobs()
+{
+	while (m_thumbnailJobs.count() < 2 && !m_thumbnailRequests.isEmpty())
+	{
+		const ThumbnailRequestInformation request(m_thumbnailRequests.takeFirst());
+		const QUrl url(request.url);
+		QtWebKitWebPageThumbnailJob *job(new QtWebKitWebPageThumbnailJob(url, request.size, this));
+
+		m_thumbnailJobs[url] = job;
+
+		connect(job, &QtWebKitWebPageThumbnailJob::jobFinished, this, [=](bool isSuccess)
+		{
+			Q_UNUSED(isSuccess)
+
+			m_thumbnailJobs.remove(url);
+
+			emit thumbnailAvailable(url, job->getThumbnail(), job->getTitle());
+
+			startThumbnailJobs();
+		});
+
+		job->start();
+	}
+}
+
 QtWebKitWebPageThumbnailJob::QtWebKitWebPageThumbnailJob(const QUrl &url, const QSize &size, QObject *parent) : WebPageThumbnailJob(url, size, parent),
 	m_page(nullptr),
 	m_url(url),
-	m_size(size)
+	m_size(size),
+	m_timeoutTimer(0)
 {
 }
 
+void QtWebKitWebPageThumbnailJob::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_timeoutTimer)
+	{
+		killTimer(m_timeoutTimer);
+
+		m_timeoutTimer = 0;
+
+		disconnect(m_page, &QtWebKitPage::loadFinished, this, &QtWebKitWebPageThumbnailJob::handlePageLoadFinished);
+
+		m_page->triggerAction(QWebPage::Stop);
+
+		handlePageLoadFinished(!m_page->mainFrame()->contentsSize().isEmpty());
+	}
+}
+
 void QtWebKitWebPageThumbnailJob::start()
 {
 	if (!m_page)
 	{
 		m_page = new QtWebKitPage(m_url);
 		m_page->setParent(this);
+		m_page->setViewportSize(m_size.isEmpty() ? QSize(1280, 760) : QSize(1280, qRound(m_size.height() * (1280.0 / m_size.width()))));
+
+		m_timeoutTimer = startTimer(30000);
 
 		connect(m_page, &QtWebKitPage::loadFinished, this, &QtWebKitWebPageThumbnailJob::handlePageLoadFinished);
 	}
@@ -319,6 +401,13 @@ void QtWebKitWebPageThumbnailJob::cancel()
 
 void QtWebKitWebPageThumbnailJob::handlePageLoadFinished(bool result)
 {
+	if (m_timeoutTimer != 0)
+	{
+		killTimer(m_timeoutTimer);
+
+		m_timeoutTimer = 0;
+	}
+
 	if (!result)
 	{
 		deleteLater();
@@ -328,45 +417,22 @@ void QtWebKitWebPageThumbnailJob::handlePageLoadFinished(bool result)
 		return;
 	}
 
-	QSize contentsSize(m_page->mainFrame()->contentsSize());
+	const QSize viewportSize(m_page->viewportSize());
 
-	if (contentsSize.isNull())
+	if (!m_size.isEmpty() && !viewportSize.isEmpty())
 	{
-		m_page->setViewportSize(QSize(1280, 760));
+		m_pixmap = QPixmap(viewportSize);
+		m_pixmap.fill(Qt::white);
 
-		contentsSize = m_page->mainFrame()->contentsSize();
-	}
+		QPainter painter(&m_pixmap);
 
-	if (!m_size.isNull() && !contentsSize.isNull())
-	{
-		if (contentsSize.width() < m_size.width())
-		{
-			contentsSize.setWidth(m_size.width());
-		}
-		else if (contentsSize.width() > 2000)
-		{
-			contentsSize.setWidth(2000);
-		}
+		m_page->mainFrame()->render(&painter, QWebFrame::ContentsLayer, QRegion(QRect(QPoint(0, 0), viewportSize)));
 
-		contentsSize.setHeight(qRound(m_size.height() * (static_cast<qreal>(contentsSize.width()) / m_size.width())));
+		painter.end();
 
-		m_page->setViewportSize(contentsSize);
-
-		if (!contentsSize.isNull())
+		if (m_pixmap.size() != m_size)
 		{
-			m_pixmap = QPixmap(contentsSize);
-			m_pixmap.fill(Qt::white);
-
-			QPainter painter(&m_pixmap);
-
-			m_page->mainFrame()->render(&painter, QWebFrame::ContentsLayer, QRegion(QRect(QPoint(0, 0), contentsSize)));
-
-			painter.end();
-
-			if (m_pixmap.size() != m_size)
-			{
-				m_pixmap = m_pixmap.scaled(m_size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-			}
+			m_pixmap = m_pixmap.scaled(m_size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
 		}
 	}
 
@@ -27,6 +27,7 @@ namespace Otter
 
 class QtWebKitPage;
 class QtWebKitSpellChecker;
+class QtWebKitWebPageThumbnailJob;
 
 class QtWebKitWebBackend final : public WebBackend
 {
@@ -55,7 +56,17 @@ public:
 	static int getOptionIdentifier(OptionIdentifier identifier);
 	bool requestThumbnail(const QUrl &url, const QSize &size) override;
 
+public slots:
+	void cancelThumbnail(const QUrl &url) override;
+
 protected:
+	struct ThumbnailRequestInformation final
+	{
+		QUrl url;
+		QSize size;
+	};
+
+	void startThumbnailJobs();
 	static QtWebKitWebBackend* getInstance();
 	static QString getActiveDictionary();
 
@@ -64,6 +75,8 @@ protected slots:
 	void setActiveWidget(WebWidget *widget);
 
 private:
+	QVector<ThumbnailRequestInformation> m_thumbnailRequests;
+	QHash<QUrl, QtWebKitWebPageThumbnailJob*> m_thumbnailJobs;
 	bool m_isInitialized;
 
 	static QtWebKitWebBackend* m_instance;
@@ -93,6 +106,9 @@ public slots:
 	void start();
 	void cancel();
 
+protected:
+	void timerEvent(QTimerEvent *event) override;
+
 protected slots:
 	void handlePageLoadFinished(bool result);
 
@@ -102,6 +118,7 @@ private:
 	QUrl m_url;
 	QSize m_size;
 	QPixmap m_pixmap;
+	int m_timeoutTimer;
 };
 
 }
@@ -82,7 +82,9 @@ QtWebKitWebWidget::QtWebKitWebWidget(const QVariantMap &parameters, WebBackend *
 	m_networkManager(networkManager),
 	m_loadingState(FinishedLoadingState),
 	m_amountOfDeferredPlugins(0),
+	m_thumbnailTimer(0),
 	m_transfersTimer(0),
+	m_areThumbnailsEnabled(SettingsManager::getOption(SettingsManager::TabBar_EnableThumbnailsOption).toBool()),
 	m_canLoadPlugins(false),
 	m_isAudioMuted(false),
 	m_isFullScreen(false),
@@ -134,6 +136,13 @@ QtWebKitWebWidget::QtWebKitWebWidget(const QVariantMap &parameters, WebBackend *
 	connect(m_page, &QtWebKitPage::downloadRequested, this, &QtWebKitWebWidget::handleDownloadRequested);
 	connect(m_page, &QtWebKitPage::unsupportedContent, this, &QtWebKitWebWidget::handleUnsupportedContent);
 	connect(m_page, &QtWebKitPage::linkHovered, this, &QtWebKitWebWidget::setStatusMessageOverride);
+	connect(m_page, &QtWebKitPage::scrollRequested, this, [&]()
+	{
+		if (m_areThumbnailsEnabled && isVisible())
+		{
+			scheduleThumbnailUpdate(1000);
+		}
+	});
 	connect(m_page, &QtWebKitPage::microFocusChanged, [&]()
 	{
 		emit categorizedActionsStateChanged({ActionsManager::ActionDefinition::EditingCategory});
@@ -180,7 +189,23 @@ QtWebKitWebWidget::~QtWebKitWebWidget()
 
 void QtWebKitWebWidget::timerEvent(QTimerEvent *event)
 {
-	if (event->timerId() == m_transfersTimer)
+	if (event->timerId() == m_thumbnailTimer)
+	{
+		killTimer(m_thumbnailTimer);
+
+		m_thumbnailTimer = 0;
+
+		if (m_loadingState != OngoingLoadingState)
+		{
+			m_thumbnail = createThumbnail(QSize(260, 170));
+
+			if (!m_thumbnail.isNull())
+			{
+				emit thumbnailChanged();
+			}
+		}
+	}
+	else if (event->timerId() == m_transfersTimer)
 	{
 		killTimer(m_transfersTimer);
 
@@ -218,6 +243,11 @@ void QtWebKitWebWidget::hideEvent(QHideEvent *event)
 	WebWidget::hideEvent(event);
 
 	m_page->setVisibilityState(QWebPage::VisibilityStateHidden);
+
+	if (m_areThumbnailsEnabled)
+	{
+		scheduleThumbnailUpdate(0);
+	}
 }
 
 void QtWebKitWebWidget::focusInEvent(QFocusEvent *event)
@@ -495,6 +525,10 @@ void QtWebKitWebWidget::handleOptionChanged(int identifier, const QVariant &valu
 				setStatusMessage({});
 			}
 
+			break;
+		case SettingsManager::TabBar_EnableThumbnailsOption:
+			m_areThumbnailsEnabled = value.toBool();
+
 			break;
 		default:
 			break;
@@ -540,13 +574,18 @@ void QtWebKitWebWidget::handleLoadFinished(bool result)
 
 	m_networkManager->handleLoadFinished(result);
 
-	m_thumbnail = {};
 	m_loadingState = FinishedLoadingState;
 
 	updateAmountOfDeferredPlugins();
 	handleHistory();
 	startReloadTimer();
 
+// thumbnail is refreshed ahead only for visible tab while tab bar shows thumbnails, otherwise it is rendered once requested
+	if (m_areThumbnailsEnabled && isVisible())
+	{
+		scheduleThumbnailUpdate(500);
+	}
+
 	emit categorizedActionsStateChanged({ActionsManager::ActionDefinition::NavigationCategory});
 	emit contentStateChanged(getContentState());
 	emit loadingStateChanged(FinishedLoadingState);
@@ -2152,56 +2191,51 @@ QIcon QtWebKitWebWidget::getIcon() const
 	return (icon.isNull() ? ThemesManager::createIcon(QLatin1String("tab")) : icon);
 }
 
-QPixmap QtWebKitWebWidget::createThumbnail(const QSize &size)
+void QtWebKitWebWidget::scheduleThumbnailUpdate(int delay)
 {
-	if ((size.isNull() || size == m_thumbnail.size()) && ((!m_thumbnail.isNull() && qFuzzyCompare(m_thumbnail.devicePixelRatio(), devicePixelRatio())) || m_loadingState == OngoingLoadingState))
+	if (m_thumbnailTimer != 0)
 	{
-		return m_thumbnail;
-	}
+		if (delay > 0)
+		{
+			return;
+		}
 
-	const QSize thumbnailSize(size.isValid() ? size : QSize(260, 170));
-	const QSize oldViewportSize(m_page->viewportSize());
-	const QPoint position(m_page->mainFrame()->scrollPosition());
-	const qreal zoom(m_page->mainFrame()->zoomFactor());
-	QSize contentsSize(m_page->mainFrame()->contentsSize());
-	QWidget *newView(new QWidget());
-	QWidget *oldView(m_page->view());
+		killTimer(m_thumbnailTimer);
+	}
 
-	m_page->setView(newView);
-	m_page->setViewportSize(contentsSize);
-	m_page->mainFrame()->setZoomFactor(1);
+	m_thumbnailTimer = startTimer(delay);
+}
 
-	if (contentsSize.width() > 2000)
+QPixmap QtWebKitWebWidget::createThumbnail(const QSize &size)
+{
+	if (size.isNull())
 	{
-		contentsSize.setWidth(2000);
+		if (m_loadingState != OngoingLoadingState && (m_thumbnail.isNull() || !qFuzzyCompare(m_thumbnail.devicePixelRatio(), devicePixelRatio())))
+		{
+			scheduleThumbnailUpdate(0);
+		}
+
+		return m_thumbnail;
 	}
 
-	contentsSize.setHeight(qRound(thumbnailSize.height() * (static_cast<qreal>(contentsSize.width()) / thumbnailSize.width())));
+	const QSize viewportSize(m_page->viewportSize());
 
-	m_page->setViewportSize(contentsSize);
+	if (viewportSize.isEmpty() || size.isEmpty())
+	{
+		return {};
+	}
 
-	QPixmap pixmap(contentsSize);
+	const qreal scale(qMin(static_cast<qreal>(1), (static_cast<qreal>(size.width()) / viewportSize.width())));
+	const QSize sourceSize(viewportSize.width(), qMin(viewportSize.height(), qRound(size.height() / scale)));
+	QPixmap pixmap(sourceSize * scale * devicePixelRatio());
+	pixmap.setDevicePixelRatio(devicePixelRatio());
 	pixmap.fill(Qt::white);
 
 	QPainter painter(&pixmap);
+	painter.setRenderHint(QPainter::SmoothPixmapTransform);
+	painter.scale(scale, scale);
 
-	m_page->mainFrame()->render(&painter, QWebFrame::ContentsLayer, QRegion(QRect(QPoint(0, 0), contentsSize)));
-	m_page->mainFrame()->setZoomFactor(zoom);
-	m_page->setView(oldView);
-	m_page->setViewportSize(oldViewportSize);
-	m_page->mainFrame()->setScrollPosition(position);
-
-	painter.end();
-
-	pixmap = pixmap.scaled((thumbnailSize * devicePixelRatio()), Qt::KeepAspectRatio, Qt::SmoothTransformation);
-	pixmap.setDevicePixelRatio(devicePixelRatio());
-
-	newView->deleteLater();
-
-	if (size.isNull())
-	{
-		m_thumbnail = pixmap;
-	}
+	m_page->mainFrame()->render(&painter, QWebFrame::ContentsLayer, QRegion(QRect(QPoint(0, 0), sourceSize)));
 
 	return pixmap;
 }
@@ -114,6 +114,7 @@ protected:
 	void showEvent(QShowEvent *event) override;
 	void hideEvent(QHideEvent *event) override;
 	void focusInEvent(QFocusEvent *event) override;
+	void scheduleThumbnailUpdate(int delay);
 	void clearPluginToken();
 	void resetSpellCheck(QWebElement element);
 	void muteAudio(QWebFrame *frame, bool isMuted);
@@ -182,7 +183,9 @@ private:
 	QNetworkAccessManager::Operation m_formRequestOperation;
 	LoadingState m_loadingState;
 	int m_amountOfDeferredPlugins;
+	int m_thumbnailTimer;
 	int m_transfersTimer;
+	bool m_areThumbnailsEnabled;
 	bool m_canLoadPlugins;
 	bool m_isAudioMuted;
 	bool m_isFullScreen;
@@ -22,146 +22,180 @@
 #include "../../../core/BookmarksManager.h"
 #include "../../../ui/BookmarksImporterWidget.h"
 
+#include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
-#ifdef OTTER_ENABLE_QTWEBKIT
-//TODO QtWebKit should not be used directly
-#include <QtWebKitWidgets/QWebPage>
-#include <QtWebKitWidgets/QWebFrame>
-#include <QtWebKit/QWebElementCollection>
-#endif
+#include <QtCore/QTextStream>
 
 namespace Otter
 {
 
 HtmlBookmarksImporter::HtmlBookmarksImporter(QObject *parent) : BookmarksImporter(parent),
 	m_optionsWidget(nullptr),
+	m_currentBookmark(nullptr),
+	m_pendingFolder(nullptr),
+	m_token(NoToken),
 	m_currentAmount(0),
 	m_totalAmount(-1)
 {
 }
 
-#ifdef OTTER_ENABLE_QTWEBKIT
-void HtmlBookmarksImporter::processElement(const QWebElement &element)
+void HtmlBookmarksImporter::processTag(const QString &tag)
 {
-	QWebElement entryElement(element.findFirst(QLatin1String("dt, hr")));
+	const bool isClosing(tag.startsWith(QLatin1Char('/')));
+	const int nameStart(isClosing ? 1 : 0);
+	int nameEnd(nameStart);
 
-	while (!entryElement.isNull())
+	while (nameEnd < tag.length() && !tag.at(nameEnd).isSpace() && tag.at(nameEnd) != QLatin1Char('/'))
 	{
-		if (entryElement.tagName().toLower() == QLatin1String("hr"))
-		{
-			BookmarksManager::addBookmark(BookmarksModel::SeparatorBookmark, {}, getCurrentFolder());
+		++nameEnd;
+	}
 
-			++m_currentAmount;
+	const QString name(tag.mid(nameStart, (nameEnd - nameStart)).toLower());
 
-			emit importProgress(BookmarksImport, m_totalAmount, m_currentAmount);
-		}
-		else
+	if (m_token == DescriptionToken && (name == QLatin1String("dt") || name == QLatin1String("dl") || name == QLatin1String("hr") || name == QLatin1String("dd")))
+	{
+		if (m_currentBookmark)
 		{
-			BookmarksModel::BookmarkType type(BookmarksModel::UnknownBookmark);
-			QWebElement matchedElement(entryElement.findFirst(QLatin1String("dt > h3")));
+			m_currentBookmark->setItemData(decodeEntities(m_text).simplified(), BookmarksModel::DescriptionRole);
+		}
 
-			if (matchedElement.isNull())
-			{
-				matchedElement = entryElement.findFirst(QLatin1String("dt > a"));
+		m_currentBookmark = nullptr;
+		m_token = NoToken;
+	}
 
-				if (!matchedElement.isNull())
-				{
-					type = (matchedElement.hasAttribute(QLatin1String("FEEDURL")) ? BookmarksModel::FeedBookmark : BookmarksModel::UrlBookmark);
-				}
-			}
-			else
+	if (isClosing)
+	{
+		if ((name == QLatin1String("a") && m_token == AnchorToken) || (name == QLatin1String("h3") && m_token == HeadingToken))
+		{
+			addEntry();
+		}
+		else if (name == QLatin1String("dl") && !m_folders.isEmpty())
+		{
+			if (m_folders.takeLast())
 			{
-				type = BookmarksModel::FolderBookmark;
+				goToParent();
 			}
 
-			if (type != BookmarksModel::UnknownBookmark && !matchedElement.isNull())
-			{
-				QMap<int, QVariant> metaData({{BookmarksModel::TitleRole, matchedElement.toPlainText()}});
-				const bool isUrlBookmark(type == BookmarksModel::UrlBookmark || BookmarksModel::FeedBookmark);
-
-				if (isUrlBookmark)
-				{
-					const QUrl url(matchedElement.attribute(QLatin1String("HREF")));
-
-					if (!areDuplicatesAllowed() && BookmarksManager::hasBookmark(url))
-					{
-						entryElement = entryElement.nextSibling();
-
-						continue;
-					}
-
-					metaData[BookmarksModel::UrlRole] = url;
-				}
-
-				if (matchedElement.hasAttribute(QLatin1String("SHORTCUTURL")))
-				{
-					const QString keyword(matchedElement.attribute(QLatin1String("SHORTCUTURL")));
-
-					if (!keyword.isEmpty() && !BookmarksManager::hasKeyword(keyword))
-					{
-						metaData[BookmarksModel::KeywordRole] = keyword;
-					}
-				}
-
-				if (matchedElement.hasAttribute(QLatin1String("ADD_DATE")))
-				{
-					const QDateTime dateTime(getDateTime(matchedElement, QLatin1String("ADD_DATE")));
-
-					if (dateTime.isValid())
-					{
-						metaData[BookmarksModel::TimeAddedRole] = dateTime;
-						metaData[BookmarksModel::TimeModifiedRole] = dateTime;
-					}
-				}
-
-				if (matchedElement.hasAttribute(QLatin1String("LAST_MODIFIED")))
-				{
-					const QDateTime dateTime(getDateTime(matchedElement, QLatin1String("LAST_MODIFIED")));
-
-					if (dateTime.isValid())
-					{
-						metaData[BookmarksModel::TimeModifiedRole] = dateTime;
-					}
-				}
-
-				if (isUrlBookmark && matchedElement.hasAttribute(QLatin1String("LAST_VISITED")))
-				{
-					const QDateTime dateTime(getDateTime(matchedElement, QLatin1String("LAST_VISITED")));
-
-					if (dateTime.isValid())
-					{
-						metaData[BookmarksModel::TimeVisitedRole] = dateTime;
-					}
-				}
-
-				BookmarksModel::Bookmark *bookmark(BookmarksManager::addBookmark(type, metaData, getCurrentFolder()));
-
-				++m_currentAmount;
-
-				emit importProgress(BookmarksImport, m_totalAmount, m_currentAmount);
-
-				if (type == BookmarksModel::FolderBookmark)
-				{
-					setCurrentFolder(bookmark);
-					processElement(entryElement);
-				}
-
-				if (entryElement.nextSibling().tagName().toLower() == QLatin1String("dd"))
-				{
-					bookmark->setItemData(entryElement.nextSibling().toPlainText(), BookmarksModel::DescriptionRole);
-
-					entryElement = entryElement.nextSibling();
-				}
-			}
+			m_currentBookmark = nullptr;
+		}
+
+		return;
+	}
+
+	if (name == QLatin1String("a") || name == QLatin1String("h3"))
+	{
+		m_attributes = getAttributes(tag);
+		m_text.clear();
+		m_token = ((name == QLatin1String("a")) ? AnchorToken : HeadingToken);
+	}
+	else if (name == QLatin1String("dd"))
+	{
+		m_text.clear();
+		m_token = DescriptionToken;
+	}
+	else if (name == QLatin1String("dl"))
+	{
+		m_folders.append(m_pendingFolder != nullptr);
+
+		if (m_pendingFolder)
+		{
+			setCurrentFolder(m_pendingFolder);
+
+			m_pendingFolder = nullptr;
 		}
 
-		entryElement = entryElement.nextSibling();
+		m_currentBookmark = nullptr;
 	}
+	else if (name == QLatin1String("hr"))
+	{
+		BookmarksManager::addBookmark(BookmarksModel::SeparatorBookmark, {}, getCurrentFolder());
+
+		m_currentBookmark = nullptr;
 
-	goToParent();
+		++m_currentAmount;
+	}
+}
+
+void HtmlBookmarksImporter::processText(const QString &text)
+{
+	if (m_token != NoToken)
+	{
+		m_text.append(text);
+	}
+}
+
+void HtmlBookmarksImporter::addEntry()
+{
+	const BookmarksModel::BookmarkType type((m_token == HeadingToken) ? BookmarksModel::FolderBookmark : (m_attributes.contains(QLatin1String("feedurl")) ? BookmarksModel::FeedBookmark : BookmarksModel::UrlBookmark));
+	const bool isUrlBookmark(type == BookmarksModel::UrlBookmark || type == BookmarksModel::FeedBookmark);
+	QMap<int, QVariant> metaData({{BookmarksModel::TitleRole, decodeEntities(m_text).simplified()}});
+
+	m_token = NoToken;
+	m_currentBookmark = nullptr;
+	m_pendingFolder = nullptr;
+
+	if (isUrlBookmark)
+	{
+		const QUrl url(m_attributes.value(QLatin1String("href")));
+
+		if (!areDuplicatesAllowed() && BookmarksManager::hasBookmark(url))
+		{
+			return;
+		}
+
+		metaData[BookmarksModel::UrlRole] = url;
+	}
+
+	if (m_attributes.contains(QLatin1String("shortcuturl")))
+	{
+		const QString keyword(m_attributes.value(QLatin1String("shortcuturl")));
+
+		if (!keyword.isEmpty() && !BookmarksManager::hasKeyword(keyword))
+		{
+			metaData[BookmarksModel::KeywordRole] = keyword;
+		}
+	}
+
+	const QDateTime timeAdded(getDateTime(m_attributes, QLatin1String("add_date")));
+
+	if (timeAdded.isValid())
+	{
+		metaData[BookmarksModel::TimeAddedRole] = timeAdded;
+		metaData[BookmarksModel::TimeModifiedRole] = timeAdded;
+	}
+
+	const QDateTime timeModified(getDateTime(m_attributes, QLatin1String("last_modified")));
+
+	if (timeModified.isValid())
+	{
+		metaData[BookmarksModel::TimeModifiedRole] = timeModified;
+	}
+
+	if (isUrlBookmark)
+	{
+		const QDateTime timeVisited(getDateTime(m_attributes, QLatin1String("last_visited")));
+
+		if (timeVisited.isValid())
+		{
+			metaData[BookmarksModel::TimeVisitedRole] = timeVisited;
+		}
+	}
+
+	m_currentBookmark = BookmarksManager::addBookmark(type, metaData, getCurrentFolder());
+
+	if (type == BookmarksModel::FolderBookmark)
+	{
+		m_pendingFolder = m_currentBookmark;
+	}
+
+	++m_currentAmount;
+
+	if (m_currentAmount % 100 == 0)
+	{
+		emit importProgress(BookmarksImport, m_totalAmount, m_currentAmount);
+	}
 }
-#endif
 
 QWidget* HtmlBookmarksImporter::createOptionsWidget(QWidget *parent)
 {
@@ -173,6 +207,95 @@ QWidget* HtmlBookmarksImporter::createOptionsWidget(QWidget *parent)
 	return m_optionsWidget;
 }
 
+QString HtmlBookmarksImporter::decodeEntities(const QString &text)
+{
+	if (!text.contains(QLatin1Char('&')))
+	{
+		return text;
+	}
+
+	QString result;
+	result.reserve(text.length());
+
+	int position(0);
+
+	while (position < text.length())
+	{
+		const int start(text.indexOf(QLatin1Char('&'), position));
+
+		if (start < 0)
+		{
+			result.append(text.midRef(position));
+
+			break;
+		}
+
+		result.append(text.midRef(position, (start - position)));
+
+		const int end(text.indexOf(QLatin1Char(';'), start));
+
+		if (end < 0 || (end - start) > 10)
+		{
+			result.append(QLatin1Char('&'));
+
+			position = (start + 1);
+
+			continue;
+		}
+
+		const QString entity(text.mid((start + 1), (end - start - 1)));
+		QString character;
+
+		if (entity.startsWith(QLatin1Char('#')))
+		{
+			bool isValid(false);
+			const uint code(entity.startsWith(QLatin1String("#x"), Qt::CaseInsensitive) ? entity.mid(2).toUInt(&isValid, 16) : entity.mid(1).toUInt(&isValid));
+
+			if (isValid && code > 0)
+			{
+				character = QString::fromUcs4(&code, 1);
+			}
+		}
+		else if (entity == QLatin1String("amp"))
+		{
+			character = QLatin1String("&");
+		}
+		else if (entity == QLatin1String("lt"))
+		{
+			character = QLatin1String("<");
+		}
+		else if (entity == QLatin1String("gt"))
+		{
+			character = QLatin1String(">");
+		}
+		else if (entity == QLatin1String("quot"))
+		{
+			character = QLatin1String("\"");
+		}
+		else if (entity == QLatin1String("apos"))
+		{
+			character = QLatin1String("'");
+		}
+		else if (entity == QLatin1String("nbsp"))
+		{
+			character = QChar(0x00A0);
+		}
+
+		if (character.isEmpty())
+		{
+			result.append(text.midRef(start, (end - start + 1)));
+		}
+		else
+		{
+			result.append(character);
+		}
+
+		position = (end + 1);
+	}
+
+	return result;
+}
+
 QString HtmlBookmarksImporter::getTitle() const
 {
 	return tr("HTML Bookmarks");
@@ -208,20 +331,102 @@ QUrl HtmlBookmarksImporter::getHomePage() const
 	return QUrl(QLatin1String("https://otter-browser.org/"));
 }
 
-#ifdef OTTER_ENABLE_QTWEBKIT
-QDateTime HtmlBookmarksImporter::getDateTime(const QWebElement &element, const QString &attribute)
+QDateTime HtmlBookmarksImporter::getDateTime(const QMap<QString, QString> &attributes, const QString &attribute)
 {
 #if QT_VERSION < 0x050800
-	const uint seconds(element.attribute(attribute).toUInt());
+	const uint seconds(attributes.value(attribute).toUInt());
 
 	return ((seconds > 0) ? QDateTime::fromTime_t(seconds) : QDateTime());
 #else
-	const qint64 seconds(element.attribute(attribute).toLongLong());
+	const qint64 seconds(attributes.value(attribute).toLongLong());
 
 	return ((seconds != 0) ? QDateTime::fromSecsSinceEpoch(seconds) : QDateTime());
 #endif
 }
-#endif
+
+QMap<QString, QString> HtmlBookmarksImporter::getAttributes(const QString &tag)
+{
+	QMap<QString, QString> attributes;
+	int position(0);
+
+	while (position < tag.length() && !tag.at(position).isSpace())
+	{
+		++position;
+	}
+
+	while (position < tag.length())
+	{
+		while (position < tag.length() && (tag.at(position).isSpace() || tag.at(position) == QLatin1Char('/')))
+		{
+			++position;
+		}
+
+		const int nameStart(position);
+
+		while (position < tag.length() && !tag.at(position).isSpace() && tag.at(position) != QLatin1Char('='))
+		{
+			++position;
+		}
+
+		const QString name(tag.mid(nameStart, (position - nameStart)).toLower());
+
+		while (position < tag.length() && tag.at(position).isSpace())
+		{
+			++position;
+		}
+
+		if (position >= tag.length() || tag.at(position) != QLatin1Char('='))
+		{
+			if (!name.isEmpty())
+			{
+				attributes[name] = QString();
+			}
+
+			continue;
+		}
+
+		++position;
+
+		while (position < tag.length() && tag.at(position).isSpace())
+		{
+			++position;
+		}
+
+		QString value;
+
+		if (position < tag.length() && (tag.at(position) == QLatin1Char('"') || tag.at(position) == QLatin1Char('\'')))
+		{
+			const QChar quote(tag.at(position));
+			int end(tag.indexOf(quote, (position + 1)));
+
+			if (end < 0)
+			{
+				end = tag.length();
+			}
+
+			value = tag.mid((position + 1), (end - position - 1));
+			position = (end + 1);
+		}
+		else
+		{
+			const int valueStart(position);
+
+			while (position < tag.length() && !tag.at(position).isSpace())
+			{
+				++position;
+			}
+
+			value = tag.mid(valueStart, (position - valueStart));
+		}
+
+		if (!name.isEmpty())
+		{
+			attributes[name] = decodeEntities(value);
+		}
+	}
+
+	return attributes;
+}
 
 QStringList HtmlBookmarksImporter::getFileFilters() const
 {
@@ -230,7 +435,6 @@ QStringList HtmlBookmarksImporter::getFileFilters() const
 
 bool HtmlBookmarksImporter::import(const QString &path)
 {
-#ifdef OTTER_ENABLE_QTWEBKIT
 	QFile file(getSuggestedPath(path));
 
 	if (!file.open(QIODevice::ReadOnly))
@@ -258,28 +462,90 @@ bool HtmlBookmarksImporter::import(const QString &path)
 		}
 	}
 
-	QWebPage page;
-	page.settings()->setAttribute(QWebSettings::JavascriptEnabled, false);
-	page.mainFrame()->setHtml(file.readAll());
+	const int estimatedAmount((file.size() > 0) ? static_cast<int>(file.size() / 150) : 0);
 
-	m_totalAmount = page.mainFrame()->findAllElements(QLatin1String("dt, hr")).count();
+	m_currentBookmark = nullptr;
+	m_pendingFolder = nullptr;
+	m_folders.clear();
+	m_token = NoToken;
+	m_currentAmount = 0;
+	m_totalAmount = -1;
 
 	emit importStarted(BookmarksImport, m_totalAmount);
 
-	BookmarksManager::getModel()->beginImport(getImportFolder(), page.mainFrame()->findAllElements(QLatin1String("a[href]")).count(), page.mainFrame()->findAllElements(QLatin1String("a[shortcuturl]")).count());
+	BookmarksManager::getModel()->beginImport(getImportFolder(), estimatedAmount, qMin(estimatedAmount, 100));
+
+	QTextStream stream(&file);
+	stream.setCodec("UTF-8");
+
+	QString buffer;
+	int position(0);
+	bool isAtEnd(false);
 
-	processElement(page.mainFrame()->documentElement().findFirst(QLatin1String("dl")));
+	while (!isAtEnd || position < buffer.length())
+	{
+		if (!isAtEnd && (buffer.length() - position) < 4096)
+		{
+			buffer = buffer.mid(position) + stream.read(65536);
+			position = 0;
+			isAtEnd = stream.atEnd();
+		}
+
+		const int tagStart(buffer.indexOf(QLatin1Char('<'), position));
+
+		if (tagStart < 0)
+		{
+			processText(buffer.mid(position));
+
+			position = buffer.length();
+
+			continue;
+		}
+
+		if (tagStart > position)
+		{
+			processText(buffer.mid(position, (tagStart - position)));
+		}
+
+		const bool isComment(buffer.midRef(tagStart, 4) == QLatin1String("<!--"));
+		const int tagEnd(isComment ? buffer.indexOf(QLatin1String("-->"), (tagStart + 4)) : buffer.indexOf(QLatin1Char('>'), (tagStart + 1)));
+
+		if (tagEnd < 0)
+		{
+			if (isAtEnd)
+			{
+				break;
+			}
+
+			position = tagStart;
+
+			buffer = buffer.mid(position) + stream.read(65536);
+			position = 0;
+			isAtEnd = stream.atEnd();
+
+			continue;
+		}
+
+		if (!isComment && buffer.at(tagStart + 1) != QLatin1Char('!') && buffer.at(tagStart + 1) != QLatin1Char('?'))
+		{
+			processTag(buffer.mid((tagStart + 1), (tagEnd - tagStart - 1)));
+		}
+
+		position = (tagEnd + (isComment ? 3 : 1));
+	}
+
+	if (m_token == DescriptionToken && m_currentBookmark)
+	{
+		m_currentBookmark->setItemData(decodeEntities(m_text).simplified(), BookmarksModel::DescriptionRole);
+	}
 
 	BookmarksManager::getModel()->endImport();
 
-	emit importFinished(BookmarksImport, SuccessfullImport, m_totalAmount);
+	emit importFinished(BookmarksImport, SuccessfullImport, m_currentAmount);
 
 	file.close();
 
 	return true;
-#else
-	return false;
-#endif
 }
 
 }
@@ -23,10 +23,6 @@
 
 #include "../../../core/BookmarksImporter.h"
 
-#ifdef OTTER_ENABLE_QTWEBKIT
-#include <QtWebKit/QWebElement>
-#endif
-
 namespace Otter
 {
 
@@ -51,14 +47,30 @@ public:
 public slots:
 	bool import(const QString &path) override;
 
-#ifdef OTTER_ENABLE_QTWEBKIT
 protected:
-	void processElement(const QWebElement &element);
-	static QDateTime getDateTime(const QWebElement &element, const QString &attribute);
-#endif
+	enum TokenType
+	{
+		NoToken = 0,
+		AnchorToken,
+		DescriptionToken,
+		HeadingToken
+	};
+
+	void processTag(const QString &tag);
+	void processText(const QString &text);
+	void addEntry();
+	static QString decodeEntities(const QString &text);
+	static QMap<QString, QString> getAttributes(const QString &tag);
+	static QDateTime getDateTime(const QMap<QString, QString> &attributes, const QString &attribute);
 
 private:
 	BookmarksImporterWidget *m_optionsWidget;
+	BookmarksModel::Bookmark *m_currentBookmark;
+	BookmarksModel::Bookmark *m_pendingFolder;
+	QString m_text;
+	QMap<QString, QString> m_attributes;
+	QVector<bool> m_folders;
+	TokenType m_token;
 	int m_currentAmount;
 	int m_totalAmount;
 };
@@ -163,6 +163,16 @@ void ProgressInformationWidget::updateStatus(WebWidget::PageInformation key, con
 	}
 }
 
+void ProgressInformationWidget::handlePageInformationChanged(const QMap<WebWidget::PageInformation, QVariant> &information)
+{
+	QMap<WebWidget::PageInformation, QVariant>::const_iterator iterator;
+
+	for (iterator = information.constBegin(); iterator != information.constEnd(); ++iterator)
+	{
+		updateStatus(iterator.key(), iterator.value());
+	}
+}
+
 void ProgressInformationWidget::setWindow(Window *window)
 {
 	WebWidget::PageInformation type(WebWidget::UnknownInformation);
@@ -203,7 +213,7 @@ void ProgressInformationWidget::setWindow(Window *window)
 
 	if (m_window && !m_window->isAboutToClose())
 	{
-		disconnect(m_window, &Window::pageInformationChanged, this, &ProgressInformationWidget::updateStatus);
+		disconnect(m_window, &Window::pageInformationChanged, this, &ProgressInformationWidget::handlePageInformationChanged);
 
 		updateStatus(type);
 	}
@@ -214,7 +224,7 @@ void ProgressInformationWidget::setWindow(Window *window)
 	{
 		updateStatus(type, window->getWebWidget()->getPageInformation(type));
 
-		connect(m_window, &Window::pageInformationChanged, this, &ProgressInformationWidget::updateStatus);
+		connect(m_window, &Window::pageInformationChanged, this, &ProgressInformationWidget::handlePageInformationChanged);
 	}
 	else
 	{
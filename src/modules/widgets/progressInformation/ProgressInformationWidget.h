@@ -54,6 +54,7 @@ public:
 
 protected slots:
 	void updateStatus(WebWidget::PageInformation key, const QVariant &value = {});
+	void handlePageInformationChanged(const QMap<WebWidget::PageInformation, QVariant> &information);
 	void setWindow(Window *window);
 
 private:
@@ -125,6 +125,14 @@ void TransfersWidget::populateMenu()
 
 void TransfersWidget::updateState()
 {
+// transfers restored from history are never running, so avoid loading it while the first window is being created
+	if (!TransfersManager::hasRunningTransfers())
+	{
+		setIcon(getIcon());
+
+		return;
+	}
+
 	const QVector<Transfer*> transfers(TransfersManager::getInstance()->getTransfers());
 	qint64 bytesTotal(0);
 	qint64 bytesReceived(0);
@@ -0,0 +1,357 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2018 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "PerformanceContentsWidget.h"
+#include "../../../core/Application.h"
+#include "../../../core/ContentFiltersManager.h"
+#include "../../../core/MemoryPressureManager.h"
+#include "../../../core/PerformanceMonitor.h"
+#include "../../../core/ThemesManager.h"
+#include "../../../core/Utils.h"
+#include "../../../ui/MainWindow.h"
+#include "../../../ui/Window.h"
+
+#include "ui_PerformanceContentsWidget.h"
+
+#include <QtCore/QTimerEvent>
+
+#include <algorithm>
+
+namespace Otter
+{
+
+PerformanceContentsWidget::PerformanceContentsWidget(const QVariantMap &parameters, Window *window, QWidget *parent) : ContentsWidget(parameters, window, parent),
+	m_model(new QStandardItemModel(this)),
+	m_entriesAmounts((SavingGroup + 1), 0),
+	m_settingsLookups(PerformanceMonitor::getSettingsLookups()),
+	m_updateTimer(0),
+	m_ui(new Ui::PerformanceContentsWidget)
+{
+	m_ui->setupUi(this);
+	m_ui->filterLineEditWidget->setClearOnEscape(true);
+
+	for (int i = ContentFiltersGroup; i <= SavingGroup; ++i)
+	{
+		QStandardItem *item(new QStandardItem());
+		item->setFlags(Qt::ItemIsEnabled);
+
+		m_model->appendRow(item);
+	}
+
+	const QVector<PerformanceMonitor::ContentFiltersStatistics> statistics(PerformanceMonitor::getContentFiltersStatistics());
+
+	for (int i = 0; i < statistics.count(); ++i)
+	{
+		m_contentFiltersChecks[statistics.at(i).profile] = statistics.at(i).checks;
+	}
+
+	m_ui->performanceViewWidget->setViewMode(ItemViewWidget::TreeView);
+	m_ui->performanceViewWidget->setModel(m_model);
+
+	m_intervalTimer.start();
+
+	updateTitles();
+	updateStatistics();
+
+	m_ui->performanceViewWidget->expandAll();
+
+	m_updateTimer = startTimer(1000);
+
+	connect(m_ui->filterLineEditWidget, &LineEditWidget::textChanged, m_ui->performanceViewWidget, &ItemViewWidget::setFilterString);
+}
+
+PerformanceContentsWidget::~PerformanceContentsWidget()
+{
+	delete m_ui;
+}
+
+void PerformanceContentsWidget::changeEvent(QEvent *event)
+{
+	ContentsWidget::changeEvent(event);
+
+	if (event->type() == QEvent::LanguageChange)
+	{
+		m_ui->retranslateUi(this);
+
+		updateTitles();
+		updateStatistics();
+	}
+}
+
+void PerformanceContentsWidget::timerEvent(QTimerEvent *event)
+{
+	if (event->timerId() == m_updateTimer)
+	{
+		updateStatistics();
+	}
+	else
+	{
+		ContentsWidget::timerEvent(event);
+	}
+}
+
+void PerformanceContentsWidget::print(QPrinter *printer)
+{
+	m_ui->performanceViewWidget->render(printer);
+}
+
+void PerformanceContentsWidget::triggerAction(int identifier, const QVariantMap &parameters, ActionsManager::TriggerType trigger)
+{
+	switch (identifier)
+	{
+		case ActionsManager::SelectAllAction:
+			m_ui->performanceViewWidget->selectAll();
+
+			break;
+		case ActionsManager::ActivateContentAction:
+			m_ui->performanceViewWidget->setFocus();
+
+			break;
+		default:
+			ContentsWidget::triggerAction(identifier, parameters, trigger);
+
+			break;
+	}
+}
+
+void PerformanceContentsWidget::updateStatistics()
+{
+	const qreal interval(m_intervalTimer.restart() / 1000.0);
+
+	m_entriesAmounts.fill(0);
+
+	updateContentFilters(interval);
+	updateSettings(interval);
+	updateTabs();
+	updateSaving();
+
+// rows are updated in place to keep selection and scroll position, only the ones no longer needed are removed
+	for (int i = ContentFiltersGroup; i <= SavingGroup; ++i)
+	{
+		QStandardItem *groupItem(m_model->item(i));
+
+		if (groupItem->rowCount() > m_entriesAmounts.at(i))
+		{
+			groupItem->removeRows(m_entriesAmounts.at(i), (groupItem->rowCount() - m_entriesAmounts.at(i)));
+		}
+	}
+}
+
+void PerformanceContentsWidget::updateTitles()
+{
+	m_model->setHorizontalHeaderLabels({tr("Name"), tr("Value"), tr("Details")});
+	m_model->item(ContentFiltersGroup)->setText(tr("Content Filters"));
+	m_model->item(SettingsGroup)->setText(tr("Settings"));
+	m_model->item(TabsGroup)->setText(tr("Tabs"));
+	m_model->item(SavingGroup)->setText(tr("Saving"));
+}
+
+void PerformanceContentsWidget::updateContentFilters(qreal interval)
+{
+	QVector<PerformanceMonitor::ContentFiltersStatistics> statistics(PerformanceMonitor::getContentFiltersStatistics());
+
+	std::sort(statistics.begin(), statistics.end(), [&](const PerformanceMonitor::ContentFiltersStatistics &first, const PerformanceMonitor::ContentFiltersStatistics &second)
+	{
+		return (first.profile < second.profile);
+	});
+
+	for (int i = 0; i < statistics.count(); ++i)
+	{
+		const PerformanceMonitor::ContentFiltersStatistics &profileStatistics(statistics.at(i));
+		const quint64 checks(profileStatistics.checks - m_contentFiltersChecks.value(profileStatistics.profile));
+		const QStringList names(profileStatistics.profile.split(QLatin1Char('+')));
+		QStringList titles;
+		titles.reserve(names.count());
+
+		for (int j = 0; j < names.count(); ++j)
+		{
+			const ContentFiltersProfile *profile(ContentFiltersManager::getProfile(names.at(j)));
+
+			titles.append(profile ? profile->getTitle() : names.at(j));
+		}
+
+		QStringList latencies;
+		latencies.reserve(PerformanceMonitor::LatencyBucketsAmount);
+
+		for (int j = 0; j < PerformanceMonitor::LatencyBucketsAmount; ++j)
+		{
+			if (j < (PerformanceMonitor::LatencyBucketsAmount - 1))
+			{
+				latencies.append(tr("<%1: %2").arg(formatDuration(PerformanceMonitor::getLatencyBucketLimit(j))).arg(profileStatistics.latencies[j]));
+			}
+			else
+			{
+				latencies.append(tr(">=%1: %2").arg(formatDuration(PerformanceMonitor::getLatencyBucketLimit(j - 1))).arg(profileStatistics.latencies[j]));
+			}
+		}
+
+		m_contentFiltersChecks[profileStatistics.profile] = profileStatistics.checks;
+
+		addEntry(ContentFiltersGroup, titles.join(QLatin1String(", ")), tr("%1 checks/s").arg(((interval > 0) ? (checks / interval) : 0), 0, 'f', 1), tr("Total: %1, average: %2, latency: %3").arg(profileStatistics.checks).arg(formatDuration(profileStatistics.totalDuration / static_cast<qint64>(qMax(quint64(1), profileStatistics.checks)))).arg(latencies.join(QLatin1String(", "))));
+	}
+}
+
+void PerformanceContentsWidget::updateSettings(qreal interval)
+{
+	const quint32 lookups(PerformanceMonitor::getSettingsLookups());
+
+	addEntry(SettingsGroup, tr("Lookups"), tr("%1/s").arg(((interval > 0) ? ((lookups - m_settingsLookups) / interval) : 0), 0, 'f', 1), tr("Total: %1").arg(lookups));
+
+	m_settingsLookups = lookups;
+}
+
+void PerformanceContentsWidget::updateTabs()
+{
+	const QVector<MainWindow*> mainWindows(Application::getWindows());
+	const qint64 memoryUsage(MemoryPressureManager::getMemoryUsage());
+	int loadedTabs(0);
+
+	for (int i = 0; i < mainWindows.count(); ++i)
+	{
+		for (int j = 0; j < mainWindows.at(i)->getWindowCount(); ++j)
+		{
+			const Window *window(mainWindows.at(i)->getWindowByIndex(j));
+
+			if (window && window->getLoadingState() != WebWidget::DeferredLoadingState)
+			{
+				++loadedTabs;
+			}
+		}
+	}
+
+	const qint64 tabMemoryUsage((memoryUsage >= 0 && loadedTabs > 0) ? (memoryUsage / loadedTabs) : -1);
+
+	addEntry(TabsGroup, tr("Process"), Utils::formatUnit(memoryUsage), tr("Loaded tabs: %1").arg(loadedTabs));
+
+	for (int i = 0; i < mainWindows.count(); ++i)
+	{
+		for (int j = 0; j < mainWindows.at(i)->getWindowCount(); ++j)
+		{
+			Window *window(mainWindows.at(i)->getWindowByIndex(j));
+
+			if (!window)
+			{
+				continue;
+			}
+
+			if (window->getLoadingState() == WebWidget::DeferredLoadingState)
+			{
+				addEntry(TabsGroup, window->getTitle(), tr("Suspended"));
+
+				continue;
+			}
+
+			const WebWidget *webWidget(window->getWebWidget());
+
+			if (webWidget)
+			{
+				addEntry(TabsGroup, window->getTitle(), Utils::formatUnit(webWidget->getPageInformation(WebWidget::TotalBytesReceivedInformation).toLongLong()), tr("Requests: %1 started, %2 finished, %3 blocked; estimated memory usage: %4").arg(webWidget->getPageInformation(WebWidget::RequestsStartedInformation).toInt()).arg(webWidget->getPageInformation(WebWidget::RequestsFinishedInformation).toInt()).arg(webWidget->getPageInformation(WebWidget::RequestsBlockedInformation).toInt()).arg(Utils::formatUnit(tabMemoryUsage)));
+			}
+			else
+			{
+				addEntry(TabsGroup, window->getTitle(), Utils::formatUnit(0), tr("Estimated memory usage: %1").arg(Utils::formatUnit(tabMemoryUsage)));
+			}
+		}
+	}
+}
+
+void PerformanceContentsWidget::updateSaving()
+{
+	const QVector<QPair<PerformanceMonitor::FlushType, QString> > types({{PerformanceMonitor::BookmarksFlush, tr("Bookmarks")}, {PerformanceMonitor::CookiesFlush, tr("Cookies")}, {PerformanceMonitor::HistoryFlush, tr("History")}, {PerformanceMonitor::SessionFlush, tr("Session")}});
+
+	for (int i = 0; i < types.count(); ++i)
+	{
+		const PerformanceMonitor::FlushStatistics statistics(PerformanceMonitor::getFlushStatistics(types.at(i).first));
+
+		if (statistics.amount == 0)
+		{
+			addEntry(SavingGroup, types.at(i).second, tr("Not saved yet"));
+		}
+		else
+		{
+			addEntry(SavingGroup, types.at(i).second, formatDuration(statistics.lastDuration), tr("Saves: %1, average: %2, maximum: %3").arg(statistics.amount).arg(formatDuration(statistics.totalDuration / static_cast<qint64>(statistics.amount))).arg(formatDuration(statistics.maximumDuration)));
+		}
+	}
+}
+
+void PerformanceContentsWidget::addEntry(GroupType group, const QString &name, const QString &value, const QString &details)
+{
+	QStandardItem *groupItem(m_model->item(group));
+
+	if (!groupItem)
+	{
+		return;
+	}
+
+	const QStringList texts({name, value, details});
+	const int row(m_entriesAmounts.at(group));
+
+	++m_entriesAmounts[group];
+
+	if (row < groupItem->rowCount())
+	{
+		for (int i = 0; i < texts.count(); ++i)
+		{
+			QStandardItem *item(groupItem->child(row, i));
+
+			if (item && item->text() != texts.at(i))
+			{
+				item->setText(texts.at(i));
+			}
+		}
+
+		return;
+	}
+
+	QList<QStandardItem*> items({new QStandardItem(name), new QStandardItem(value), new QStandardItem(details)});
+
+	for (int i = 0; i < items.count(); ++i)
+	{
+		items[i]->setFlags(Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemNeverHasChildren);
+	}
+
+	groupItem->appendRow(items);
+}
+
+QString PerformanceContentsWidget::formatDuration(qint64 duration)
+{
+	return tr("%1 ms").arg((duration / 1000000.0), 0, 'f', 3);
+}
+
+QString PerformanceContentsWidget::getTitle() const
+{
+	return tr("Performance");
+}
+
+QLatin1String PerformanceContentsWidget::getType() const
+{
+	return QLatin1String("performance");
+}
+
+QUrl PerformanceContentsWidget::getUrl() const
+{
+	return QUrl(QLatin1String("about:performance"));
+}
+
+QIcon PerformanceContentsWidget::getIcon() const
+{
+	return ThemesManager::createIcon(QLatin1String("task-ongoing"), false);
+}
+
+}
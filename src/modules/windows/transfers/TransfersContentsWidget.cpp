@@ -310,7 +310,14 @@ void TransfersContentsWidget::handleTransferChanged(Transfer *transfer)
 
 				break;
 			case 5:
-				m_model->setData(index, ((transfer->getState() == Transfer::RunningState) ? Utils::formatUnit(transfer->getSpeed(), true, 1) : QString()), Qt::DisplayRole);
+				if (transfer->isQueued())
+				{
+					m_model->setData(index, tr("Queued"), Qt::DisplayRole);
+				}
+				else
+				{
+					m_model->setData(index, ((transfer->getState() == Transfer::RunningState) ? Utils::formatUnit(transfer->getSpeed(), true, 1) : QString()), Qt::DisplayRole);
+				}
 
 				break;
 			case 6:
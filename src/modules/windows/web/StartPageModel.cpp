@@ -24,8 +24,12 @@
 #include "../../../core/SettingsManager.h"
 #include "../../../core/WebBackend.h"
 
+#include <QtConcurrent/QtConcurrentRun>
+#include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QFutureWatcher>
 #include <QtCore/QMimeData>
 #include <QtGui/QPainter>
 
@@ -33,7 +37,8 @@ namespace Otter
 {
 
 StartPageModel::StartPageModel(QObject *parent) : QStandardItemModel(parent),
-	m_bookmark(nullptr)
+	m_bookmark(nullptr),
+	m_thumbnails(65536)
 {
 	handleOptionChanged(SettingsManager::Backends_WebOption);
 	reloadModel();
@@ -53,6 +58,10 @@ void StartPageModel::reloadModel()
 
 	clear();
 
+	const int refreshPeriod(SessionsManager::isReadOnly() ? 0 : SettingsManager::getOption(SettingsManager::StartPage_ThumbnailsRefreshPeriodOption).toInt());
+	const QDateTime refreshTime(QDateTime::currentDateTime().addDays(-refreshPeriod));
+	QSet<QUrl> urls;
+
 	if (m_bookmark)
 	{
 		for (int i = 0; i < m_bookmark->rowCount(); ++i)
@@ -70,6 +79,7 @@ void StartPageModel::reloadModel()
 
 				const quint64 identifier(bookmark->getIdentifier());
 				const QUrl url(bookmark->getUrl());
+				const QFileInfo thumbnailInformation(getThumbnailPath(identifier));
 				QStandardItem *item(bookmark->clone());
 				item->setData(identifier, BookmarksModel::IdentifierRole);
 				item->setData(bookmark->getTitle(), Qt::ToolTipRole);
@@ -79,7 +89,7 @@ void StartPageModel::reloadModel()
 				{
 					item->setEnabled(false);
 				}
-				else if (url.isValid() && SettingsManager::getOption(SettingsManager::StartPage_TileBackgroundModeOption) == QLatin1String("thumbnail") && !QFile::exists(getThumbnailPath(identifier)))
+				else if (url.isValid() && SettingsManager::getOption(SettingsManager::StartPage_TileBackgroundModeOption) == QLatin1String("thumbnail") && (!thumbnailInformation.exists() || (refreshPeriod > 0 && thumbnailInformation.lastModified() < refreshTime)))
 				{
 					ThumbnailRequestInformation thumbnailRequestInformation;
 					thumbnailRequestInformation.bookmarkIdentifier = identifier;
@@ -89,11 +99,29 @@ void StartPageModel::reloadModel()
 					AddonsManager::getWebBackend()->requestThumbnail(url, QSize(SettingsManager::getOption(SettingsManager::StartPage_TileWidthOption).toInt(), SettingsManager::getOption(SettingsManager::StartPage_TileHeightOption).toInt()));
 				}
 
+				urls.insert(url);
+
 				appendRow(item);
 			}
 		}
 	}
 
+	QHash<QUrl, ThumbnailRequestInformation>::iterator iterator(m_reloads.begin());
+
+	while (iterator != m_reloads.end())
+	{
+		if (urls.contains(iterator.key()))
+		{
+			++iterator;
+		}
+		else
+		{
+			AddonsManager::getWebBackend()->cancelThumbnail(iterator.key());
+
+			iterator = m_reloads.erase(iterator);
+		}
+	}
+
 	if (SettingsManager::getOption(SettingsManager::StartPage_ShowAddTileOption).toBool())
 	{
 		QStandardItem *item(new QStandardItem());
@@ -312,6 +340,8 @@ void StartPageModel::handleThumbnailCreated(const QUrl &url, const QPixmap &thum
 		QDir().mkpath(SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")));
 
 		thumbnail.save(getThumbnailPath(information.bookmarkIdentifier), "png");
+
+		++m_thumbnailRevisions[information.bookmarkIdentifier];
 	}
 
 	if (bookmark)
@@ -358,6 +388,72 @@ QMimeData* StartPageModel::mimeData(const QModelIndexList &indexes) const
 	return mimeData;
 }
 
+QPixmap StartPageModel::getThumbnail(const QModelIndex &index, int width, qreal devicePixelRatio)
+{
+	const quint64 identifier(index.data(BookmarksModel::IdentifierRole).toULongLong());
+	const QString path(getThumbnailPath(identifier));
+	const QFileInfo thumbnailInformation(path);
+
+	if (!thumbnailInformation.exists())
+	{
+		return {};
+	}
+
+// file can be replaced or removed outside of this model, so modification time is part of the key too
+	const QString key(QString::number(identifier) + QLatin1Char('/') + QString::number(m_thumbnailRevisions.value(identifier)) + QLatin1Char('/') + QString::number(thumbnailInformation.lastModified().toMSecsSinceEpoch()) + QLatin1Char('/') + QString::number(width) + QLatin1Char('/') + QString::number(devicePixelRatio));
+	const QPixmap *cachedThumbnail(m_thumbnails.object(key));
+
+	if (cachedThumbnail)
+	{
+		return *cachedThumbnail;
+	}
+
+	if (m_thumbnailLoads.contains(key))
+	{
+		return {};
+	}
+
+	m_thumbnailLoads.insert(key);
+
+	const int pixelWidth(qRound(width * devicePixelRatio));
+	QFutureWatcher<QImage> *watcher(new QFutureWatcher<QImage>(this));
+
+	connect(watcher, &QFutureWatcher<QImage>::finished, this, [=]()
+	{
+		const QImage image(watcher->result());
+
+		watcher->deleteLater();
+
+		m_thumbnailLoads.remove(key);
+
+		if (image.isNull())
+		{
+			return;
+		}
+
+		QPixmap *thumbnail(new QPixmap(QPixmap::fromImage(image)));
+		thumbnail->setDevicePixelRatio(devicePixelRatio);
+
+		m_thumbnails.insert(key, thumbnail, qMax(1, ((image.width() * image.height() * 4) / 1024)));
+
+		const QModelIndexList indexes(match(this->index(0, 0), BookmarksModel::IdentifierRole, identifier, 1, Qt::MatchExactly));
+
+		if (!indexes.isEmpty())
+		{
+			emit dataChanged(indexes.first(), indexes.first());
+		}
+	});
+
+	watcher->setFuture(QtConcurrent::run([=]()
+	{
+		const QImage image(path);
+
+		return ((image.isNull() || image.width() == pixelWidth) ? image : image.scaledToWidth(pixelWidth, Qt::SmoothTransformation));
+	}));
+
+	return {};
+}
+
 QString StartPageModel::getThumbnailPath(quint64 identifier)
 {
 	return SessionsManager::getWritableDataPath(QLatin1String("thumbnails/")) + QString::number(identifier) + QLatin1String(".png");
@@ -22,6 +22,8 @@
 
 #include "../../../core/BookmarksModel.h"
 
+#include <QtCore/QCache>
+
 namespace Otter
 {
 
@@ -39,6 +41,7 @@ public:
 	explicit StartPageModel(QObject *parent = nullptr);
 
 	QMimeData* mimeData(const QModelIndexList &indexes) const override;
+	QPixmap getThumbnail(const QModelIndex &index, int width, qreal devicePixelRatio);
 	static QString getThumbnailPath(quint64 identifier);
 	QVariant data(const QModelIndex &index, int role) const override;
 	QStringList mimeTypes() const override;
@@ -67,7 +70,10 @@ protected slots:
 
 private:
 	BookmarksModel::Bookmark *m_bookmark;
+	QCache<QString, QPixmap> m_thumbnails;
 	QHash<QUrl, ThumbnailRequestInformation> m_reloads;
+	QHash<quint64, int> m_thumbnailRevisions;
+	QSet<QString> m_thumbnailLoads;
 
 signals:
 	void modelModified();
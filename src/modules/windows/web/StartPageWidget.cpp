@@ -133,10 +133,19 @@ void TileDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option,
 
 				break;
 			case ThumbnailBackground:
-				painter->setBrush(Qt::white);
-				painter->setPen(Qt::transparent);
-				painter->drawRect(rectangle);
-				painter->drawPixmap(rectangle, QPixmap(StartPageModel::getThumbnailPath(index.data(BookmarksModel::IdentifierRole).toULongLong())), QRect(0, 0, rectangle.width(), rectangle.height()));
+				{
+					painter->setBrush(Qt::white);
+					painter->setPen(Qt::transparent);
+					painter->drawRect(rectangle);
+
+					const qreal devicePixelRatio(painter->device()->devicePixelRatioF());
+					const QPixmap thumbnail(StartPageWidget::getModel()->getThumbnail(index, rectangle.width(), devicePixelRatio));
+
+					if (!thumbnail.isNull())
+					{
+						painter->drawPixmap(rectangle, thumbnail, QRect(0, 0, qRound(rectangle.width() * devicePixelRatio), qRound(rectangle.height() * devicePixelRatio)));
+					}
+				}
 
 				break;
 			default:
@@ -862,6 +871,11 @@ void StartPageWidget::showContextMenu(const QPoint &position)
 	menu.exec(hitPosition);
 }
 
+StartPageModel* StartPageWidget::getModel()
+{
+	return m_model;
+}
+
 Animation* StartPageWidget::getLoadingAnimation()
 {
 	return m_spinnerAnimation;
@@ -97,6 +97,7 @@ public:
 	void triggerAction(int identifier, const QVariantMap &parameters = {}, ActionsManager::TriggerType trigger = ActionsManager::UnknownTrigger);
 	void scrollContents(const QPoint &delta);
 	void markForDeletion();
+	static StartPageModel* getModel();
 	static Animation* getLoadingAnimation();
 	QPixmap createThumbnail();
 	bool event(QEvent *event) override;
@@ -55,27 +55,12 @@ Action::Action(int identifier, const QVariantMap &parameters, const QVariantMap
 
 	if (options.contains(QLatin1String("icon")))
 	{
-		const QVariant data(options[QLatin1String("icon")]);
-
-		if (data.type() == QVariant::Icon)
-		{
-			setIcon(data.value<QIcon>());
-		}
-		else
-		{
-			setIcon(ThemesManager::createIcon(data.toString()));
-		}
-
-		m_flags |= IsOverridingIconFlag;
+		setOverrideIcon(options[QLatin1String("icon")]);
 	}
 
 	if (options.contains(QLatin1String("text")))
 	{
-		m_overrideText = options[QLatin1String("text")].toString();
-
-		m_flags |= IsOverridingTextFlag;
-
-		setState(getState());
+		setOverrideText(options[QLatin1String("text")].toString());
 	}
 }
 
@@ -224,6 +209,29 @@ void Action::updateState()
 	setState(state);
 }
 
+void Action::setOverrideText(const QString &text)
+{
+	m_overrideText = text;
+
+	m_flags |= IsOverridingTextFlag;
+
+	setState(getState());
+}
+
+void Action::setOverrideIcon(const QVariant &data)
+{
+	if (data.type() == QVariant::Icon)
+	{
+		setIcon(data.value<QIcon>());
+	}
+	else
+	{
+		setIcon(ThemesManager::createIcon(data.toString()));
+	}
+
+	m_flags |= IsOverridingIconFlag;
+}
+
 void Action::setExecutor(ActionExecutor::Object executor)
 {
 	const ActionsManager::ActionDefinition definition(getDefinition());
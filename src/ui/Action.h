@@ -46,6 +46,8 @@ public:
 	explicit Action(int identifier, const QVariantMap &parameters, const QVariantMap &options, ActionExecutor::Object executor, QObject *parent);
 
 	void setExecutor(ActionExecutor::Object executor);
+	void setOverrideText(const QString &text);
+	void setOverrideIcon(const QVariant &data);
 	ActionsManager::ActionDefinition getDefinition() const;
 	QVariantMap getParameters() const;
 	int getIdentifier() const;
@@ -101,12 +101,13 @@ signals:
 	void titleChanged(const QString &title);
 	void urlChanged(const QUrl &url);
 	void iconChanged(const QIcon &icon);
+	void thumbnailChanged();
 	void requestBlocked(const NetworkManager::ResourceInformation &request);
 	void arbitraryActionsStateChanged(const QVector<int> &identifiers);
 	void categorizedActionsStateChanged(const QVector<int> &categories);
 	void contentStateChanged(WebWidget::ContentStates state);
 	void loadingStateChanged(WebWidget::LoadingState state);
-	void pageInformationChanged(WebWidget::PageInformation, const QVariant &value);
+	void pageInformationChanged(const QMap<WebWidget::PageInformation, QVariant> &information);
 	void optionChanged(int identifier, const QVariant &value);
 	void zoomChanged(int zoom);
 	void canZoomChanged(bool isAllowed);
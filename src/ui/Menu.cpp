@@ -1176,29 +1176,20 @@ void Menu::populateSessionsMenu()
 	m_actionGroup = new QActionGroup(this);
 	m_actionGroup->setExclusive(true);
 
-	const QStringList sessions(SessionsManager::getSessions());
-	QMultiHash<QString, SessionInformation> information;
+	const QVector<SessionMetaData> sessions(SessionsManager::getSessionsMetaData());
+	QMultiHash<QString, SessionMetaData> information;
 
 	for (int i = 0; i < sessions.count(); ++i)
 	{
-		const SessionInformation session(SessionsManager::getSession(sessions.at(i)));
-
-		information.insert((session.title.isEmpty() ? tr("(Untitled)") : session.title), session);
+		information.insert((sessions.at(i).title.isEmpty() ? tr("(Untitled)") : sessions.at(i).title), sessions.at(i));
 	}
 
-	const QList<SessionInformation> sorted(information.values());
+	const QList<SessionMetaData> sorted(information.values());
 	const QString currentSession(SessionsManager::getCurrentSession());
 
 	for (int i = 0; i < sorted.count(); ++i)
 	{
-		int windows(0);
-
-		for (int j = 0; j < sorted.at(i).windows.count(); ++j)
-		{
-			windows += sorted.at(i).windows.at(j).windows.count();
-		}
-
-		QAction *action(addAction(tr("%1 (%n tab(s))", "", windows).arg(sorted.at(i).title.isEmpty() ? tr("(Untitled)") : QString(sorted.at(i).title).replace(QLatin1Char('&'), QLatin1String("&&")))));
+		QAction *action(addAction(tr("%1 (%n tab(s))", "", sorted.at(i).tabs).arg(sorted.at(i).title.isEmpty() ? tr("(Untitled)") : QString(sorted.at(i).title).replace(QLatin1Char('&'), QLatin1String("&&")))));
 		action->setData(sorted.at(i).path);
 		action->setCheckable(true);
 		action->setChecked(sorted.at(i).path == currentSession);
@@ -1366,40 +1357,25 @@ void Menu::populateUserAgentMenu()
 
 void Menu::populateWindowsMenu()
 {
-	if (actions().isEmpty())
-	{
-		const MainWindow *mainWindow(MainWindow::findMainWindow(this));
-
-		if (mainWindow)
-		{
-			connect(mainWindow, &MainWindow::titleChanged, this, &Menu::populateWindowsMenu);
-			connect(mainWindow, &MainWindow::windowAdded, this, &Menu::populateWindowsMenu);
-			connect(mainWindow, &MainWindow::windowRemoved, this, &Menu::populateWindowsMenu);
-		}
+	const SessionModel *model(SessionsManager::getModel());
 
-		disconnect(this, &Menu::aboutToShow, this, &Menu::populateWindowsMenu);
-	}
+	connect(model, &SessionModel::rowsInserted, this, &Menu::handleWindowsMenuRowsInserted);
+	connect(model, &SessionModel::rowsRemoved, this, &Menu::handleWindowsMenuRowsRemoved);
+	connect(model, &SessionModel::dataChanged, this, &Menu::handleWindowsMenuDataChanged);
+	disconnect(this, &Menu::aboutToShow, this, &Menu::populateWindowsMenu);
 
 	clear();
 
-	MainWindow *mainWindow(MainWindow::findMainWindow(this));
-	const MainWindowSessionItem *mainWindowItem(SessionsManager::getModel()->getMainWindowItem(mainWindow));
+	const QModelIndex rootIndex(getWindowsMenuRootIndex());
 
-	if (mainWindowItem)
+	if (!rootIndex.isValid())
 	{
-		ActionExecutor::Object executor(mainWindow, mainWindow);
-
-		for (int i = 0; i < mainWindowItem->rowCount(); ++i)
-		{
-			const WindowSessionItem *windowItem(static_cast<WindowSessionItem*>(mainWindowItem->child(i, 0)));
-
-			if (windowItem)
-			{
-				const Window *window(windowItem->getActiveWindow());
+		return;
+	}
 
-				addAction(new Action(ActionsManager::ActivateTabAction, {{QLatin1String("tab"), window->getIdentifier()}}, {{QLatin1String("icon"), window->getIcon()}, {QLatin1String("text"), Utils::elideText((window->getTitle().isEmpty() ? QT_TRANSLATE_NOOP("actions", "(Untitled)") : window->getTitle()), fontMetrics(), this)}}, executor, this));
-			}
-		}
+	for (int i = 0; i < model->rowCount(rootIndex); ++i)
+	{
+		addAction(createWindowsMenuAction(model->index(i, 0, rootIndex)));
 	}
 }
 
@@ -1460,6 +1436,63 @@ void Menu::updateClosedWindowsMenu()
 	setEnabled((mainWindow && mainWindow->getClosedWindows().count() > 0) || SessionsManager::getClosedWindows().count() > 0);
 }
 
+void Menu::handleWindowsMenuRowsInserted(const QModelIndex &parent, int first, int last)
+{
+	const QModelIndex rootIndex(getWindowsMenuRootIndex());
+
+	if (!rootIndex.isValid() || parent != rootIndex)
+	{
+		return;
+	}
+
+	for (int i = first; i <= last; ++i)
+	{
+		insertAction(actions().value(i), createWindowsMenuAction(SessionsManager::getModel()->index(i, 0, rootIndex)));
+	}
+}
+
+void Menu::handleWindowsMenuRowsRemoved(const QModelIndex &parent, int first, int last)
+{
+	const QModelIndex rootIndex(getWindowsMenuRootIndex());
+
+	if (!rootIndex.isValid() || parent != rootIndex)
+	{
+		return;
+	}
+
+	for (int i = qMin(last, (actions().count() - 1)); i >= first; --i)
+	{
+		QAction *action(actions().at(i));
+
+		removeAction(action);
+
+		action->deleteLater();
+	}
+}
+
+void Menu::handleWindowsMenuDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
+{
+	const QModelIndex rootIndex(getWindowsMenuRootIndex());
+
+	if (!rootIndex.isValid() || topLeft.parent() != rootIndex)
+	{
+		return;
+	}
+
+	for (int i = topLeft.row(); i <= qMin(bottomRight.row(), (actions().count() - 1)); ++i)
+	{
+		Action *action(qobject_cast<Action*>(actions().at(i)));
+
+		if (action)
+		{
+			const QModelIndex index(SessionsManager::getModel()->index(i, 0, rootIndex));
+
+			action->setOverrideIcon(index.data(SessionModel::IconRole));
+			action->setOverrideText(getWindowsMenuActionText(index));
+		}
+	}
+}
+
 void Menu::setTitle(const QString &title)
 {
 	m_title = title;
@@ -1555,4 +1588,25 @@ bool Menu::hasIncludeMatch(const QJsonObject &definition, const QString &key, co
 	return false;
 }
 
+QAction* Menu::createWindowsMenuAction(const QModelIndex &index)
+{
+	MainWindow *mainWindow(MainWindow::findMainWindow(this));
+
+	return new Action(ActionsManager::ActivateTabAction, {{QLatin1String("tab"), index.data(SessionModel::IdentifierRole).toULongLong()}}, {{QLatin1String("icon"), index.data(SessionModel::IconRole)}, {QLatin1String("text"), getWindowsMenuActionText(index)}}, ActionExecutor::Object(mainWindow, mainWindow), this);
+}
+
+QString Menu::getWindowsMenuActionText(const QModelIndex &index)
+{
+	const QString title(index.data(SessionModel::TitleRole).toString());
+
+	return Utils::elideText((title.isEmpty() ? QT_TRANSLATE_NOOP("actions", "(Untitled)") : title), fontMetrics(), this);
+}
+
+QModelIndex Menu::getWindowsMenuRootIndex() const
+{
+	const MainWindowSessionItem *mainWindowItem(SessionsManager::getModel()->getMainWindowItem(MainWindow::findMainWindow(parent())));
+
+	return (mainWindowItem ? mainWindowItem->index() : QModelIndex());
+}
+
 }
@@ -77,6 +77,9 @@ protected:
 	ActionExecutor::Object getExecutor() const;
 	bool canInclude(const QJsonObject &definition, const QStringList &sections);
 	bool hasIncludeMatch(const QJsonObject &definition, const QString &key, const QStringList &sections);
+	QAction* createWindowsMenuAction(const QModelIndex &index);
+	QString getWindowsMenuActionText(const QModelIndex &index);
+	QModelIndex getWindowsMenuRootIndex() const;
 
 protected slots:
 	void hideMenu();
@@ -100,6 +103,9 @@ protected slots:
 	void clearNotesMenu();
 	void selectOption(QAction *action);
 	void updateClosedWindowsMenu();
+	void handleWindowsMenuRowsInserted(const QModelIndex &parent, int first, int last);
+	void handleWindowsMenuRowsRemoved(const QModelIndex &parent, int first, int last);
+	void handleWindowsMenuDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
 
 private:
 	QActionGroup *m_actionGroup;
@@ -35,38 +35,29 @@ SessionsManagerDialog::SessionsManagerDialog(QWidget *parent) : Dialog(parent),
 	m_ui->setupUi(this);
 	m_ui->openInExistingWindowCheckBox->setChecked(SettingsManager::getOption(SettingsManager::Sessions_OpenInExistingWindowOption).toBool());
 
-	const QStringList sessions(SessionsManager::getSessions());
-	QMultiHash<QString, SessionInformation> information;
+	const QVector<SessionMetaData> sessions(SessionsManager::getSessionsMetaData());
+	QMultiHash<QString, SessionMetaData> information;
 
 	for (int i = 0; i < sessions.count(); ++i)
 	{
-		const SessionInformation session(SessionsManager::getSession(sessions.at(i)));
-
-		information.insert((session.title.isEmpty() ? tr("(Untitled)") : session.title), session);
+		information.insert((sessions.at(i).title.isEmpty() ? tr("(Untitled)") : sessions.at(i).title), sessions.at(i));
 	}
 
 	QStandardItemModel *model(new QStandardItemModel(this));
 	model->setHorizontalHeaderLabels({tr("Title"), tr("Identifier"), tr("Windows")});
 
-	const QList<SessionInformation> sorted(information.values());
+	const QList<SessionMetaData> sorted(information.values());
 	const QString currentSession(SessionsManager::getCurrentSession());
 	int row(0);
 
 	for (int i = 0; i < sorted.count(); ++i)
 	{
-		int windows(0);
-
-		for (int j = 0; j < sorted.at(i).windows.count(); ++j)
-		{
-			windows += sorted.at(i).windows.at(j).windows.count();
-		}
-
 		if (sorted.at(i).path == currentSession)
 		{
 			row = i;
 		}
 
-		QList<QStandardItem*> items({new QStandardItem(sorted.at(i).title.isEmpty() ? tr("(Untitled)") : sorted.at(i).title), new QStandardItem(sorted.at(i).path), new QStandardItem(tr("%n window(s) (%1)", "", sorted.at(i).windows.count()).arg(tr("%n tab(s)", "", windows)))});
+		QList<QStandardItem*> items({new QStandardItem(sorted.at(i).title.isEmpty() ? tr("(Untitled)") : sorted.at(i).title), new QStandardItem(sorted.at(i).path), new QStandardItem(tr("%n window(s) (%1)", "", sorted.at(i).windows).arg(tr("%n tab(s)", "", sorted.at(i).tabs)))});
 		items[0]->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren);
 		items[1]->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren);
 		items[2]->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled | Qt::ItemNeverHasChildren);
@@ -45,17 +45,15 @@ StartupDialog::StartupDialog(const QString &sessionName, QWidget *parent) : Dial
 		m_ui->enablePluginsCheckBox->setCheckState(Qt::PartiallyChecked);
 	}
 
-	const QStringList sessionNames(SessionsManager::getSessions());
-	QMultiHash<QString, SessionInformation> information;
+	const QVector<SessionMetaData> sessionsMetaData(SessionsManager::getSessionsMetaData());
+	QMultiHash<QString, SessionMetaData> information;
 
-	for (int i = 0; i < sessionNames.count(); ++i)
+	for (int i = 0; i < sessionsMetaData.count(); ++i)
 	{
-		const SessionInformation session(SessionsManager::getSession(sessionNames.at(i)));
-
-		information.insert((session.title.isEmpty() ? tr("(Untitled)") : session.title), session);
+		information.insert((sessionsMetaData.at(i).title.isEmpty() ? tr("(Untitled)") : sessionsMetaData.at(i).title), sessionsMetaData.at(i));
 	}
 
-	const QList<SessionInformation> sessions(information.values());
+	const QList<SessionMetaData> sessions(information.values());
 
 	for (int i = 0; i < sessions.count(); ++i)
 	{
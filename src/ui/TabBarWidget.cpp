@@ -73,6 +73,13 @@ TabHandleWidget::TabHandleWidget(Window *window, TabBarWidget *parent) : QWidget
 	connect(window, &Window::needsAttention, this, &TabHandleWidget::markAsNeedingAttention);
 	connect(window, &Window::titleChanged, this, &TabHandleWidget::updateTitle);
 	connect(window, &Window::iconChanged, this, static_cast<void(TabHandleWidget::*)()>(&TabHandleWidget::update));
+	connect(window, &Window::thumbnailChanged, this, [&]()
+	{
+		if (m_thumbnailRectangle.isValid())
+		{
+			update();
+		}
+	});
 	connect(window, &Window::loadingStateChanged, this, &TabHandleWidget::handleLoadingStateChanged);
 	connect(parent, &TabBarWidget::currentChanged, this, &TabHandleWidget::updateGeometries);
 	connect(parent, &TabBarWidget::tabsAmountChanged, this, &TabHandleWidget::updateGeometries);
@@ -585,10 +592,12 @@ TabBarWidget::TabBarWidget(QWidget *parent) : QTabBar(parent),
 	m_hoveredTab(-1),
 	m_pinnedTabsAmount(0),
 	m_previewTimer(0),
+	m_tabHandlesTimer(0),
 	m_arePreviewsEnabled(SettingsManager::getOption(SettingsManager::TabBar_EnablePreviewsOption).toBool()),
 	m_isDraggingTab(false),
 	m_isDetachingTab(false),
 	m_isIgnoringTabDrag(false),
+	m_isUpdatingTabHandles(false),
 	m_needsUpdateOnLeave(false)
 {
 	m_areThumbnailsEnabled = SettingsManager::getOption(SettingsManager::TabBar_EnableThumbnailsOption).toBool();
@@ -669,6 +678,14 @@ void TabBarWidget::timerEvent(QTimerEvent *event)
 
 		showPreview(tabAt(mapFromGlobal(QCursor::pos())));
 	}
+	else if (event->timerId() == m_tabHandlesTimer)
+	{
+		killTimer(m_tabHandlesTimer);
+
+		m_tabHandlesTimer = 0;
+
+		updateTabHandles();
+	}
 }
 
 void TabBarWidget::paintEvent(QPaintEvent *event)
@@ -680,11 +697,16 @@ void TabBarWidget::paintEvent(QPaintEvent *event)
 
 	for (int i = 0; i < count(); ++i)
 	{
-		if (i == selectedIndex)
+		if (i == selectedIndex || !rect().intersects(tabRect(i)))
 		{
 			continue;
 		}
 
+		if (!tabButton(i, QTabBar::LeftSide))
+		{
+			scheduleTabHandlesUpdate();
+		}
+
 		const QStyleOptionTab tabOption(createStyleOptionTab(i));
 
 		if (rect().intersects(tabOption.rect))
@@ -1147,6 +1169,11 @@ void TabBarWidget::tabLayoutChange()
 		}
 	}
 
+	if (!m_isUpdatingTabHandles)
+	{
+		scheduleTabHandlesUpdate();
+	}
+
 	tabHovered(tabAt(mapFromGlobal(QCursor::pos())));
 }
 
@@ -1207,15 +1234,70 @@ void TabBarWidget::tabHovered(int index)
 	}
 }
 
+void TabBarWidget::scheduleTabHandlesUpdate()
+{
+	if (m_tabHandlesTimer == 0)
+	{
+		m_tabHandlesTimer = startTimer(0);
+	}
+}
+
+void TabBarWidget::updateTabHandles()
+{
+	if (m_isDraggingTab)
+	{
+		return;
+	}
+
+	const QRect visibleRectangle(rect().adjusted(-200, -200, 200, 200));
+	const int selectedIndex(currentIndex());
+
+	m_isUpdatingTabHandles = true;
+
+	for (int i = 0; i < count(); ++i)
+	{
+		QWidget *widget(tabButton(i, QTabBar::LeftSide));
+		const bool isVisible(i == selectedIndex || visibleRectangle.intersects(tabRect(i)));
+
+		if (isVisible && !widget)
+		{
+			Window *window(getWindow(i));
+
+			if (window)
+			{
+				TabHandleWidget *tabHandleWidget(new TabHandleWidget(window, this));
+
+				setTabButton(i, QTabBar::LeftSide, tabHandleWidget);
+
+				if (i == selectedIndex)
+				{
+					tabHandleWidget->setIsActiveWindow(true);
+
+					m_activeTabHandleWidget = tabHandleWidget;
+				}
+			}
+		}
+		else if (!isVisible && widget)
+		{
+			setTabButton(i, QTabBar::LeftSide, nullptr);
+
+			widget->deleteLater();
+		}
+	}
+
+	m_isUpdatingTabHandles = false;
+}
+
 void TabBarWidget::addTab(int index, Window *window)
 {
 	const int selectedIndex(currentIndex());
 
 	blockSignals(true);
 	insertTab(index, {});
+	setTabData(index, QVariant::fromValue(static_cast<QObject*>(window)));
 	blockSignals(false);
-	setTabButton(index, QTabBar::LeftSide, new TabHandleWidget(window, this));
 	setTabButton(index, QTabBar::RightSide, nullptr);
+	scheduleTabHandlesUpdate();
 
 	if (selectedIndex != currentIndex() || count() == 1)
 	{
@@ -1509,6 +1591,13 @@ void TabBarWidget::handleCurrentChanged(int index)
 
 	TabHandleWidget *tabHandleWidget(qobject_cast<TabHandleWidget*>(tabButton(index, QTabBar::LeftSide)));
 
+	if (!tabHandleWidget && getWindow(index))
+	{
+		tabHandleWidget = new TabHandleWidget(getWindow(index), this);
+
+		setTabButton(index, QTabBar::LeftSide, tabHandleWidget);
+	}
+
 	if (tabHandleWidget)
 	{
 		tabHandleWidget->setIsActiveWindow(true);
@@ -1594,12 +1683,7 @@ Window* TabBarWidget::getWindow(int index) const
 {
 	if (index >= 0 && index < count())
 	{
-		const TabHandleWidget *widget(qobject_cast<TabHandleWidget*>(tabButton(index, QTabBar::LeftSide)));
-
-		if (widget)
-		{
-			return widget->getWindow();
-		}
+		return qobject_cast<Window*>(tabData(index).value<QObject*>());
 	}
 
 	return nullptr;
@@ -1662,14 +1746,7 @@ QSize TabBarWidget::sizeHint() const
 {
 	if (shape() == QTabBar::RoundedNorth || shape() == QTabBar::RoundedSouth)
 	{
-		int size(0);
-
-		for (int i = 0; i < count(); ++i)
-		{
-			const Window *window(getWindow(i));
-
-			size += ((window && window->isPinned()) ? m_minimumTabSize.width() : m_maximumTabSize.width());
-		}
+		int size((m_pinnedTabsAmount * m_minimumTabSize.width()) + ((count() - m_pinnedTabsAmount) * m_maximumTabSize.width()));
 
 		if (parentWidget() && size > parentWidget()->width())
 		{
@@ -120,6 +120,8 @@ protected:
 	void tabInserted(int index) override;
 	void tabRemoved(int index) override;
 	void tabHovered(int index);
+	void scheduleTabHandlesUpdate();
+	void updateTabHandles();
 	QStyleOptionTab createStyleOptionTab(int index) const;
 	QSize tabSizeHint(int index) const override;
 	int getDropIndex() const;
@@ -146,10 +148,12 @@ private:
 	int m_hoveredTab;
 	int m_pinnedTabsAmount;
 	int m_previewTimer;
+	int m_tabHandlesTimer;
 	bool m_arePreviewsEnabled;
 	bool m_isDraggingTab;
 	bool m_isDetachingTab;
 	bool m_isIgnoringTabDrag;
+	bool m_isUpdatingTabHandles;
 	bool m_needsUpdateOnLeave;
 
 	static bool m_areThumbnailsEnabled;
@@ -25,6 +25,7 @@
 #include "../core/SessionModel.h"
 #include "../core/ThemesManager.h"
 
+#include <QtGui/QGuiApplication>
 #include <QtGui/QKeyEvent>
 #include <QtWidgets/QFrame>
 #include <QtWidgets/QHBoxLayout>
@@ -33,14 +34,52 @@
 namespace Otter
 {
 
+TabSwitcherProxyModel::TabSwitcherProxyModel(bool isIgnoringMinimizedTabs, QObject *parent) : QSortFilterProxyModel(parent),
+	m_isIgnoringMinimizedTabs(isIgnoringMinimizedTabs)
+{
+}
+
+QVariant TabSwitcherProxyModel::data(const QModelIndex &index, int role) const
+{
+	if (role == Qt::TextColorRole && index.data(SessionModel::IsDeferredRole).toBool())
+	{
+		QColor color(QGuiApplication::palette().color(QPalette::Text));
+		color.setAlpha(150);
+
+		return color;
+	}
+
+	return QSortFilterProxyModel::data(index, role);
+}
+
+bool TabSwitcherProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
+{
+	if (!m_isIgnoringMinimizedTabs)
+	{
+		return true;
+	}
+
+	const QModelIndex index(sourceModel()->index(sourceRow, 0, sourceParent));
+
+	if (static_cast<SessionModel::EntityType>(index.data(SessionModel::TypeRole).toInt()) != SessionModel::WindowEntity)
+	{
+		return true;
+	}
+
+	const SessionModel *model(qobject_cast<SessionModel*>(sourceModel()));
+	const SessionItem *item(model ? static_cast<SessionItem*>(model->itemFromIndex(index)) : nullptr);
+	const Window *window(item ? item->getActiveWindow() : nullptr);
+
+	return (!window || window->getWindowState().state != Qt::WindowMinimized);
+}
+
 TabSwitcherWidget::TabSwitcherWidget(MainWindow *parent) : QWidget(parent),
 	m_mainWindow(parent),
-	m_model(new QStandardItemModel(this)),
+	m_model(new TabSwitcherProxyModel(SettingsManager::getOption(SettingsManager::TabSwitcher_IgnoreMinimizedTabsOption).toBool(), this)),
 	m_tabsView(new ItemViewWidget(this)),
 	m_previewLabel(new QLabel(this)),
 	m_spinnerAnimation(nullptr),
-	m_reason(KeyboardReason),
-	m_isIgnoringMinimizedTabs(SettingsManager::getOption(SettingsManager::TabSwitcher_IgnoreMinimizedTabsOption).toBool())
+	m_reason(KeyboardReason)
 {
 	QFrame *frame(new QFrame(this));
 	QHBoxLayout *mainLayout(new QHBoxLayout(this));
@@ -53,7 +92,7 @@ TabSwitcherWidget::TabSwitcherWidget(MainWindow *parent) : QWidget(parent),
 	frameLayout->addWidget(m_tabsView, 1);
 	frameLayout->addWidget(m_previewLabel, 0, Qt::AlignCenter);
 
-	m_model->setSortRole(OrderRole);
+	m_model->setSortRole(SessionModel::LastActivityRole);
 
 	frame->setLayout(frameLayout);
 	frame->setAutoFillBackground(true);
@@ -72,7 +111,8 @@ TabSwitcherWidget::TabSwitcherWidget(MainWindow *parent) : QWidget(parent),
 	m_previewLabel->setStyleSheet(QLatin1String("border:1px solid gray;"));
 
 	connect(m_tabsView, &ItemViewWidget::clicked, this, &TabSwitcherWidget::handleIndexClicked);
-	connect(m_tabsView->selectionModel(), &QItemSelectionModel::currentChanged, this, &TabSwitcherWidget::handleCurrentTabChanged);
+	connect(m_tabsView->selectionModel(), &QItemSelectionModel::currentChanged, this, &TabSwitcherWidget::updatePreview);
+	connect(m_model, &TabSwitcherProxyModel::dataChanged, this, &TabSwitcherWidget::handleDataChanged);
 }
 
 void TabSwitcherWidget::showEvent(QShowEvent *event)
@@ -81,43 +121,25 @@ void TabSwitcherWidget::showEvent(QShowEvent *event)
 
 	const MainWindowSessionItem *mainWindowItem(SessionsManager::getModel()->getMainWindowItem(m_mainWindow));
 
-	if (mainWindowItem)
-	{
-		const bool useSorting(SettingsManager::getOption(SettingsManager::TabSwitcher_OrderByLastActivityOption).toBool());
+	m_model->setSourceModel(SessionsManager::getModel());
+	m_model->sort((SettingsManager::getOption(SettingsManager::TabSwitcher_OrderByLastActivityOption).toBool() ? 0 : -1), Qt::DescendingOrder);
 
-		for (int i = 0; i < mainWindowItem->rowCount(); ++i)
-		{
-			const WindowSessionItem *windowItem(static_cast<WindowSessionItem*>(mainWindowItem->child(i, 0)));
-
-			if (windowItem && (!m_isIgnoringMinimizedTabs || (windowItem->getActiveWindow() && windowItem->getActiveWindow()->getWindowState().state != Qt::WindowMinimized)))
-			{
-				m_model->appendRow(createRow(windowItem->getActiveWindow(), (useSorting ? QVariant(windowItem->getActiveWindow()->getLastActivity()) : QVariant(i))));
-			}
-		}
-	}
-
-	m_model->sort(0, (SettingsManager::getOption(SettingsManager::TabSwitcher_OrderByLastActivityOption).toBool() ? Qt::DescendingOrder : Qt::AscendingOrder));
+	m_tabsView->setRootIndex(mainWindowItem ? m_model->mapFromSource(mainWindowItem->index()) : QModelIndex());
 
 	const Window *activeWindow(m_mainWindow->getActiveWindow());
-	const int contentsHeight(m_model->rowCount() * 22);
+	const int contentsHeight(m_model->rowCount(m_tabsView->rootIndex()) * 22);
 
-	m_tabsView->setCurrentIndex(m_model->index((activeWindow ? findRow(activeWindow->getIdentifier()) : 0), 0));
+	m_tabsView->setCurrentIndex(m_model->index((activeWindow ? findRow(activeWindow->getIdentifier()) : 0), 0, m_tabsView->rootIndex()));
 	m_tabsView->setMinimumHeight(qMin(contentsHeight, int(height() * 0.9)));
 
 	QWidget::showEvent(event);
-
-	connect(m_mainWindow, &MainWindow::windowAdded, this, &TabSwitcherWidget::handleWindowAdded);
-	connect(m_mainWindow, &MainWindow::windowRemoved, this, &TabSwitcherWidget::handleWindowRemoved);
 }
 
 void TabSwitcherWidget::hideEvent(QHideEvent *event)
 {
 	QWidget::hideEvent(event);
 
-	disconnect(m_mainWindow, &MainWindow::windowAdded, this, &TabSwitcherWidget::handleWindowAdded);
-	disconnect(m_mainWindow, &MainWindow::windowRemoved, this, &TabSwitcherWidget::handleWindowRemoved);
-
-	m_model->clear();
+	m_model->setSourceModel(nullptr);
 }
 
 void TabSwitcherWidget::keyPressEvent(QKeyEvent *event)
@@ -167,31 +189,44 @@ void TabSwitcherWidget::show(SwitcherReason reason)
 
 void TabSwitcherWidget::accept()
 {
-	m_mainWindow->setActiveWindowByIdentifier(m_tabsView->currentIndex().data(IdentifierRole).toULongLong());
+	m_mainWindow->setActiveWindowByIdentifier(m_tabsView->currentIndex().data(SessionModel::IdentifierRole).toULongLong());
 
 	hide();
 }
 
 void TabSwitcherWidget::selectTab(bool next)
 {
+	const QModelIndex rootIndex(m_tabsView->rootIndex());
+	const int rowCount(m_model->rowCount(rootIndex));
 	const int currentRow(m_tabsView->currentIndex().row());
 
-	m_tabsView->setCurrentIndex(m_model->index((next ? ((currentRow == (m_model->rowCount() - 1)) ? 0 : (currentRow + 1)) : ((currentRow == 0) ? (m_model->rowCount() - 1) : (currentRow - 1))), 0));
+	m_tabsView->setCurrentIndex(m_model->index((next ? ((currentRow == (rowCount - 1)) ? 0 : (currentRow + 1)) : ((currentRow == 0) ? (rowCount - 1) : (currentRow - 1))), 0, rootIndex));
 }
 
 void TabSwitcherWidget::handleIndexClicked(const QModelIndex &index)
 {
 	if (index.isValid())
 	{
-		m_mainWindow->setActiveWindowByIdentifier(index.data(IdentifierRole).toULongLong());
+		m_mainWindow->setActiveWindowByIdentifier(index.data(SessionModel::IdentifierRole).toULongLong());
 
 		hide();
 	}
 }
 
-void TabSwitcherWidget::handleCurrentTabChanged(const QModelIndex &index)
+void TabSwitcherWidget::handleDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight)
 {
-	const Window *window(m_mainWindow->getWindowByIdentifier(index.data(IdentifierRole).toULongLong()));
+	const QModelIndex index(m_tabsView->currentIndex());
+
+	if (index.isValid() && index.parent() == topLeft.parent() && index.row() >= topLeft.row() && index.row() <= bottomRight.row())
+	{
+		updatePreview();
+	}
+}
+
+void TabSwitcherWidget::updatePreview()
+{
+	const QModelIndex index(m_tabsView->currentIndex());
+	const Window *window(m_mainWindow->getWindowByIdentifier(index.data(SessionModel::IdentifierRole).toULongLong()));
 
 	m_previewLabel->setMovie(nullptr);
 	m_previewLabel->setPixmap({});
@@ -222,7 +257,10 @@ void TabSwitcherWidget::handleCurrentTabChanged(const QModelIndex &index)
 			});
 		}
 
-		m_spinnerAnimation->start();
+		if (!m_spinnerAnimation->isRunning())
+		{
+			m_spinnerAnimation->start();
+		}
 
 		m_previewLabel->setPixmap(m_spinnerAnimation->getCurrentPixmap());
 	}
@@ -233,104 +271,25 @@ void TabSwitcherWidget::handleCurrentTabChanged(const QModelIndex &index)
 			m_spinnerAnimation->stop();
 		}
 
-		m_previewLabel->setPixmap((window->getLoadingState() == WebWidget::CrashedLoadingState) ? ThemesManager::createIcon(QLatin1String("tab-crashed")).pixmap(32, 32) : window->createThumbnail());
-	}
-}
-
-void TabSwitcherWidget::handleWindowAdded(quint64 identifier)
-{
-	Window *window(m_mainWindow->getWindowByIdentifier(identifier));
-
-	if (window && (!m_isIgnoringMinimizedTabs || window->getWindowState().state != Qt::WindowMinimized))
-	{
-		m_model->insertRow(0, createRow(window, (SettingsManager::getOption(SettingsManager::TabSwitcher_OrderByLastActivityOption).toBool() ? QVariant(window->getLastActivity()) : QVariant(-1))));
-	}
-}
-
-void TabSwitcherWidget::handleWindowRemoved(quint64 identifier)
-{
-	const int row(findRow(identifier));
-
-	if (row >= 0)
-	{
-		m_model->removeRow(row);
-	}
-}
-
-void TabSwitcherWidget::setTitle(const QString &title)
-{
-	const Window *window(qobject_cast<Window*>(sender()));
-
-	if (window)
-	{
-		const int row(findRow(window->getIdentifier()));
-
-		if (row >= 0)
-		{
-			m_model->setData(m_model->index(row, 0), title, Qt::DisplayRole);
-		}
-	}
-}
-
-void TabSwitcherWidget::setIcon(const QIcon &icon)
-{
-	const Window *window(qobject_cast<Window*>(sender()));
-
-	if (window)
-	{
-		const int row(findRow(window->getIdentifier()));
-
-		if (row >= 0)
+		if (window->getLoadingState() == WebWidget::CrashedLoadingState)
 		{
-			m_model->setData(m_model->index(row, 0), icon, Qt::DecorationRole);
+			m_previewLabel->setPixmap(ThemesManager::createIcon(QLatin1String("tab-crashed")).pixmap(32, 32));
 		}
-	}
-}
-
-void TabSwitcherWidget::setLoadingState(WebWidget::LoadingState state)
-{
-	const Window *window(qobject_cast<Window*>(sender()));
-
-	if (window)
-	{
-		const int row(findRow(window->getIdentifier()));
-
-		if (row >= 0)
+		else
 		{
-			QColor color(palette().color(QPalette::Text));
+			QPixmap thumbnail(index.data(SessionModel::ThumbnailRole).value<QPixmap>());
 
-			if (state == WebWidget::DeferredLoadingState)
+// not every backend reports thumbnail changes
+			if (thumbnail.isNull())
 			{
-				color.setAlpha(150);
+				thumbnail = window->createThumbnail();
 			}
 
-			m_model->setData(m_model->index(row, 0), color, Qt::TextColorRole);
+			m_previewLabel->setPixmap(thumbnail.isNull() ? window->getIcon().pixmap(32, 32) : thumbnail);
 		}
 	}
 }
 
-QStandardItem* TabSwitcherWidget::createRow(Window *window, const QVariant &index) const
-{
-	QColor color(palette().color(QPalette::Text));
-
-	if (window->getLoadingState() == WebWidget::DeferredLoadingState)
-	{
-		color.setAlpha(150);
-	}
-
-	QStandardItem *item(new QStandardItem(window->getIcon(), window->getTitle()));
-	item->setData(color, Qt::TextColorRole);
-	item->setData(window->getIdentifier(), IdentifierRole);
-	item->setData(index, OrderRole);
-	item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsEnabled);
-
-	connect(window, &Window::titleChanged, this, &TabSwitcherWidget::setTitle);
-	connect(window, &Window::iconChanged, this, &TabSwitcherWidget::setIcon);
-	connect(window, &Window::loadingStateChanged, this, &TabSwitcherWidget::setLoadingState);
-
-	return item;
-}
-
 TabSwitcherWidget::SwitcherReason TabSwitcherWidget::getReason() const
 {
 	return m_reason;
@@ -338,9 +297,11 @@ TabSwitcherWidget::SwitcherReason TabSwitcherWidget::getReason() const
 
 int TabSwitcherWidget::findRow(quint64 identifier) const
 {
-	for (int i = 0; i < m_model->rowCount(); ++i)
+	const QModelIndex rootIndex(m_tabsView->rootIndex());
+
+	for (int i = 0; i < m_model->rowCount(rootIndex); ++i)
 	{
-		if (m_model->index(i, 0).data(IdentifierRole).toULongLong() == identifier)
+		if (m_model->index(i, 0, rootIndex).data(SessionModel::IdentifierRole).toULongLong() == identifier)
 		{
 			return i;
 		}
@@ -361,7 +322,7 @@ bool TabSwitcherWidget::eventFilter(QObject *object, QEvent *event)
 
 			if (index.isValid())
 			{
-				Application::triggerAction(ActionsManager::CloseTabAction, {{QLatin1String("tab"), index.data(IdentifierRole).toULongLong()}}, parentWidget());
+				Application::triggerAction(ActionsManager::CloseTabAction, {{QLatin1String("tab"), index.data(SessionModel::IdentifierRole).toULongLong()}}, parentWidget());
 			}
 
 			return true;
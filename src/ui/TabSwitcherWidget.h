@@ -23,25 +23,35 @@
 #include "ItemViewWidget.h"
 #include "WebWidget.h"
 
+#include <QtCore/QSortFilterProxyModel>
 #include <QtWidgets/QLabel>
 
 namespace Otter
 {
 
 class Animation;
-class Window;
 
-class TabSwitcherWidget final : public QWidget
+class TabSwitcherProxyModel final : public QSortFilterProxyModel
 {
 	Q_OBJECT
 
 public:
-	enum DataRole
-	{
-		IdentifierRole = Qt::UserRole,
-		OrderRole
-	};
+	explicit TabSwitcherProxyModel(bool isIgnoringMinimizedTabs, QObject *parent = nullptr);
+
+	QVariant data(const QModelIndex &index, int role) const override;
+
+protected:
+	bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+	bool m_isIgnoringMinimizedTabs;
+};
+
+class TabSwitcherWidget final : public QWidget
+{
+	Q_OBJECT
 
+public:
 	enum SwitcherReason
 	{
 		ActionReason = 0,
@@ -62,26 +72,20 @@ protected:
 	void hideEvent(QHideEvent *event) override;
 	void keyPressEvent(QKeyEvent *event) override;
 	void keyReleaseEvent(QKeyEvent *event) override;
-	QStandardItem* createRow(Window *window, const QVariant &index) const;
 	int findRow(quint64 identifier) const;
 
 protected slots:
 	void handleIndexClicked(const QModelIndex &index);
-	void handleCurrentTabChanged(const QModelIndex &index);
-	void handleWindowAdded(quint64 identifier);
-	void handleWindowRemoved(quint64 identifier);
-	void setTitle(const QString &title);
-	void setIcon(const QIcon &icon);
-	void setLoadingState(WebWidget::LoadingState state);
+	void handleDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight);
+	void updatePreview();
 
 private:
 	MainWindow *m_mainWindow;
-	QStandardItemModel *m_model;
+	TabSwitcherProxyModel *m_model;
 	ItemViewWidget *m_tabsView;
 	QLabel *m_previewLabel;
 	Animation *m_spinnerAnimation;
 	SwitcherReason m_reason;
-	bool m_isIgnoringMinimizedTabs;
 };
 
 }
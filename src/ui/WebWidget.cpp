@@ -76,7 +76,7 @@ void WebWidget::timerEvent(QTimerEvent *event)
 	{
 		++m_loadingTime;
 
-		emit pageInformationChanged(LoadingTimeInformation, m_loadingTime);
+		emit pageInformationChanged({{LoadingTimeInformation, m_loadingTime}});
 	}
 	else if (event->timerId() == m_reloadTimer)
 	{
@@ -276,7 +276,7 @@ void WebWidget::handleLoadingStateChange(LoadingState state)
 		m_loadingTime = 0;
 		m_loadingTimer = startTimer(1000);
 
-		emit pageInformationChanged(LoadingTimeInformation, 0);
+		emit pageInformationChanged({{LoadingTimeInformation, 0}});
 	}
 }
 
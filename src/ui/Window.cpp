@@ -161,6 +161,8 @@ void Window::triggerAction(int identifier, const QVariantMap &parameters, Action
 			{
 				m_session = getSession();
 
+				SessionsManager::compactHistory(&m_session);
+
 				setContentsWidget(nullptr);
 			}
 
@@ -316,6 +318,8 @@ void Window::setSession(const SessionWindow &session, bool deferLoading)
 
 	if (deferLoading)
 	{
+		SessionsManager::compactHistory(&m_session);
+
 		setWindowTitle(session.getTitle());
 	}
 	else
@@ -413,6 +417,8 @@ void Window::setZoom(int zoom)
 	else if (m_session.historyIndex >= 0 && m_session.historyIndex < m_session.history.count())
 	{
 		m_session.history[m_session.historyIndex].zoom = zoom;
+
+		SessionsManager::compactHistory(&m_session);
 	}
 }
 
@@ -468,15 +474,7 @@ void Window::setContentsWidget(ContentsWidget *widget)
 
 	if (m_session.historyIndex >= 0 || !m_contentsWidget->getWebWidget() || m_contentsWidget->getWebWidget()->getRequestedUrl().isEmpty())
 	{
-		WindowHistoryInformation history;
-
-		if (m_session.historyIndex >= 0)
-		{
-			history.index = m_session.historyIndex;
-			history.entries = m_session.history;
-		}
-
-		m_contentsWidget->setHistory(history);
+		m_contentsWidget->setHistory((m_session.historyIndex >= 0) ? SessionsManager::getHistory(m_session) : WindowHistoryInformation());
 		m_contentsWidget->setZoom(m_session.getZoom());
 	}
 
@@ -520,6 +518,7 @@ void Window::setContentsWidget(ContentsWidget *widget)
 		emit urlChanged(url, false);
 	});
 	connect(m_contentsWidget, &ContentsWidget::iconChanged, this, &Window::iconChanged);
+	connect(m_contentsWidget, &ContentsWidget::thumbnailChanged, this, &Window::thumbnailChanged);
 	connect(m_contentsWidget, &ContentsWidget::requestBlocked, this, &Window::requestBlocked);
 	connect(m_contentsWidget, &ContentsWidget::arbitraryActionsStateChanged, this, &Window::arbitraryActionsStateChanged);
 	connect(m_contentsWidget, &ContentsWidget::categorizedActionsStateChanged, this, &Window::categorizedActionsStateChanged);
@@ -680,11 +679,7 @@ WindowHistoryInformation Window::getHistory() const
 		return m_contentsWidget->getHistory();
 	}
 
-	WindowHistoryInformation history;
-	history.entries = m_session.history;
-	history.index = m_session.historyIndex;
-
-	return history;
+	return SessionsManager::getHistory(m_session);
 }
 
 SessionWindow Window::getSession() const
@@ -787,6 +782,11 @@ bool Window::isActive() const
 	return (isActiveWindow() && isAncestorOf(QApplication::focusWidget()));
 }
 
+bool Window::isAudible() const
+{
+	return (m_contentsWidget && !m_isAboutToClose && m_contentsWidget->getWebWidget() && m_contentsWidget->getWebWidget()->isAudible());
+}
+
 bool Window::isPinned() const
 {
 	return m_isPinned;
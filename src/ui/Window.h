@@ -79,6 +79,7 @@ public:
 	bool canZoom() const;
 	bool isAboutToClose() const override;
 	bool isActive() const;
+	bool isAudible() const;
 	bool isPinned() const;
 	bool isPrivate() const;
 
@@ -129,13 +130,14 @@ signals:
 	void titleChanged(const QString &title);
 	void urlChanged(const QUrl &url, bool force);
 	void iconChanged(const QIcon &icon);
+	void thumbnailChanged();
 	void requestBlocked(const NetworkManager::ResourceInformation &request);
 	void actionsStateChanged();
 	void arbitraryActionsStateChanged(const QVector<int> &identifiers);
 	void categorizedActionsStateChanged(const QVector<int> &categories);
 	void contentStateChanged(WebWidget::ContentStates state);
 	void loadingStateChanged(WebWidget::LoadingState state);
-	void pageInformationChanged(WebWidget::PageInformation, const QVariant &value);
+	void pageInformationChanged(const QMap<WebWidget::PageInformation, QVariant> &information);
 	void optionChanged(int identifier, const QVariant &value);
 	void zoomChanged(int zoom);
 	void canZoomChanged(bool isAllowed);
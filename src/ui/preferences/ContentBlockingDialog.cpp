@@ -504,6 +504,8 @@ void ContentBlockingDialog::save()
 			if (profile)
 			{
 				profile->clear();
+
+				emit profile->profileModified(profile->getName());
 			}
 			else
 			{
@@ -0,0 +1,511 @@
+/**************************************************************************
+* Otter Browser: Web browser controlled by the user, not vice-versa.
+* Copyright (C) 2018 Michal Dutkiewicz aka Emdek <michal@emdek.pl>
+*
+* This program is free software: you can redistribute it and/or modify
+* it under the terms of the GNU General Public License as published by
+* the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* This program is distributed in the hope that it will be useful,
+* but WITHOUT ANY WARRANTY; without even the implied warranty of
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+* GNU General Public License for more details.
+*
+* You should have received a copy of the GNU General Public License
+* along with this program. If not, see <http://www.gnu.org/licenses/>.
+*
+**************************************************************************/
+
+#include "../../src/core/AdblockContentFiltersProfile.h"
+#include "../../src/core/BookmarksModel.h"
+#include "../../src/core/Console.h"
+#include "../../src/core/FeedParser.h"
+#include "../../src/core/HistoryModel.h"
+#include "../../src/core/SessionsManager.h"
+#include "../../src/core/SettingsManager.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTextStream>
+#include <QtTest/QtTest>
+#include <QtWidgets/QApplication>
+
+namespace Otter
+{
+
+class CoreBenchmarks final : public QObject
+{
+	Q_OBJECT
+
+public:
+	enum
+	{
+		RulesAmount = 50000,
+		UrlsAmount = 2000,
+		HistoryEntriesAmount = 100000,
+		BookmarksAmount = 100000,
+		SessionTabsAmount = 1000,
+		FeedEntriesAmount = 10000
+	};
+
+	struct UrlCorpusEntry final
+	{
+		QUrl baseUrl;
+		QUrl requestUrl;
+		NetworkManager::ResourceType resourceType = NetworkManager::OtherType;
+	};
+
+protected:
+	void writeContentFiltersProfile();
+	void loadUrlCorpus();
+	static QByteArray createAtomFeed();
+	static QByteArray createRssFeed();
+	static SessionInformation createSession(const QString &path);
+
+private:
+	QTemporaryDir m_profileDirectory;
+	QVector<UrlCorpusEntry> m_urls;
+	int m_expectedBlockedAmount = -1;
+
+private slots:
+	void initTestCase();
+	void benchmarkContentFiltersLoading();
+	void benchmarkContentFiltersCheckUrl();
+	void benchmarkHistoryFindEntries_data();
+	void benchmarkHistoryFindEntries();
+	void benchmarkBookmarksFindBookmarks_data();
+	void benchmarkBookmarksFindBookmarks();
+	void benchmarkSettingsGetOption_data();
+	void benchmarkSettingsGetOption();
+	void benchmarkSessionSave();
+	void benchmarkSessionLoad();
+	void benchmarkFeedParser_data();
+	void benchmarkFeedParser();
+};
+
+void CoreBenchmarks::initTestCase()
+{
+	QVERIFY(m_profileDirectory.isValid());
+
+	const QString profilePath(m_profileDirectory.path());
+
+	QDir().mkpath(profilePath + QLatin1String("/cache"));
+	QDir().mkpath(profilePath + QLatin1String("/contentBlocking"));
+
+	Console::createInstance();
+	SettingsManager::createInstance(profilePath);
+	SessionsManager::createInstance(profilePath, profilePath + QLatin1String("/cache"), false, false);
+
+	writeContentFiltersProfile();
+	loadUrlCorpus();
+}
+
+void CoreBenchmarks::writeContentFiltersProfile()
+{
+	const QString path(SessionsManager::getWritableDataPath(QLatin1String("contentBlocking/benchmark.txt")));
+	const QByteArray snapshotPath(qgetenv("OTTER_BENCHMARK_EASYLIST"));
+
+	if (!snapshotPath.isEmpty())
+	{
+		QFile::remove(path);
+
+		QVERIFY2(QFile::copy(QString::fromLocal8Bit(snapshotPath), path), "Failed to copy EasyList snapshot");
+
+		return;
+	}
+
+	QFile file(path);
+
+	QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+
+	QTextStream stream(&file);
+	stream << QLatin1String("[Adblock Plus 2.0]\n! Title: Benchmark\n");
+
+	for (int i = 0; i < RulesAmount; ++i)
+	{
+		switch (i % 8)
+		{
+			case 0:
+				stream << QStringLiteral("||ads%1.example.com^\n").arg(i);
+
+				break;
+			case 1:
+				stream << QStringLiteral("||tracker%1.example.net^$third-party\n").arg(i);
+
+				break;
+			case 2:
+				stream << QStringLiteral("/banner/%1/*\n").arg(i);
+
+				break;
+			case 3:
+				stream << QStringLiteral("-advert-%1.\n").arg(i);
+
+				break;
+			case 4:
+				stream << QStringLiteral("||cdn%1.example.org/ads/*$script,image\n").arg(i);
+
+				break;
+			case 5:
+				stream << QStringLiteral("@@||cdn%1.example.org/ads/allowed.js$script\n").arg(i - 1);
+
+				break;
+			case 6:
+				stream << QStringLiteral("example%1.com##.sponsored-%1\n").arg(i);
+
+				break;
+			default:
+				stream << QStringLiteral("##.ad-slot-%1\n").arg(i);
+
+				break;
+		}
+	}
+}
+
+void CoreBenchmarks::loadUrlCorpus()
+{
+	const QByteArray corpusPath(qgetenv("OTTER_BENCHMARK_URLS"));
+
+	if (!corpusPath.isEmpty())
+	{
+		QFile file(QString::fromLocal8Bit(corpusPath));
+
+		QVERIFY2(file.open(QIODevice::ReadOnly | QIODevice::Text), "Failed to open URL corpus");
+
+		QTextStream stream(&file);
+
+		while (!stream.atEnd())
+		{
+			const QStringList fields(stream.readLine().split(QLatin1Char(' '), QString::SkipEmptyParts));
+
+			if (fields.isEmpty())
+			{
+				continue;
+			}
+
+			UrlCorpusEntry entry;
+			entry.requestUrl = QUrl(fields.last());
+			entry.baseUrl = ((fields.count() > 1) ? QUrl(fields.first()) : entry.requestUrl);
+
+			m_urls.append(entry);
+		}
+
+		return;
+	}
+
+	const QVector<NetworkManager::ResourceType> resourceTypes({NetworkManager::ScriptType, NetworkManager::ImageType, NetworkManager::StyleSheetType, NetworkManager::SubFrameType, NetworkManager::OtherType});
+
+	m_urls.reserve(UrlsAmount);
+
+	m_expectedBlockedAmount = 0;
+
+	for (int i = 0; i < UrlsAmount; ++i)
+	{
+		UrlCorpusEntry entry;
+		entry.baseUrl = QUrl(QStringLiteral("https://www.site%1.com/articles/%2.html").arg(i % 100).arg(i));
+		entry.resourceType = resourceTypes.at(i % resourceTypes.count());
+
+		switch (i % 5)
+		{
+			case 0:
+				entry.requestUrl = QUrl(QStringLiteral("https://ads%1.example.com/serve?slot=%2").arg((i * 8) % RulesAmount).arg(i));
+
+				++m_expectedBlockedAmount;
+
+				break;
+			case 1:
+				entry.requestUrl = QUrl(QStringLiteral("https://cdn%1.example.org/ads/allowed.js").arg(((i * 8) + 4) % RulesAmount));
+
+// requested as image, so the exception limited to scripts does not apply
+				++m_expectedBlockedAmount;
+
+				break;
+			case 2:
+				entry.requestUrl = QUrl(QStringLiteral("https://static.site%1.com/banner/%2/image.png").arg(i % 100).arg(((i * 8) + 2) % RulesAmount));
+
+				++m_expectedBlockedAmount;
+
+				break;
+			default:
+				entry.requestUrl = QUrl(QStringLiteral("https://static.site%1.com/assets/main-%2.js?v=%3").arg(i % 100).arg(i).arg(i * 7));
+
+				break;
+		}
+
+		m_urls.append(entry);
+	}
+}
+
+QByteArray CoreBenchmarks::createAtomFeed()
+{
+	QByteArray data;
+	QTextStream stream(&data);
+	stream << QLatin1String("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<feed xmlns=\"http://www.w3.org/2005/Atom\">\n<title>Benchmark</title>\n<subtitle>Synthetic feed</subtitle>\n<updated>2018-01-01T00:00:00Z</updated>\n<id>urn:uuid:benchmark</id>\n");
+
+	for (int i = 0; i < FeedEntriesAmount; ++i)
+	{
+		stream << QStringLiteral("<entry>\n<title>Entry %1</title>\n<link href=\"https://www.example.com/entries/%1\"/>\n<id>urn:uuid:entry-%1</id>\n<updated>2018-01-01T00:00:00Z</updated>\n<author><name>Author %2</name><email>author%2@example.com</email></author>\n<category term=\"category%3\" label=\"Category %3\"/>\n<summary>Summary of entry %1</summary>\n<content type=\"html\">&lt;p&gt;Content of entry %1 with some &lt;b&gt;markup&lt;/b&gt; inside.&lt;/p&gt;</content>\n</entry>\n").arg(i).arg(i % 50).arg(i % 20);
+	}
+
+	stream << QLatin1String("</feed>\n");
+	stream.flush();
+
+	return data;
+}
+
+QByteArray CoreBenchmarks::createRssFeed()
+{
+	QByteArray data;
+	QTextStream stream(&data);
+	stream << QLatin1String("<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<rss version=\"2.0\">\n<channel>\n<title>Benchmark</title>\n<description>Synthetic feed</description>\n<link>https://www.example.com/</link>\n<lastBuildDate>Mon, 01 Jan 2018 00:00:00 +0000</lastBuildDate>\n");
+
+	for (int i = 0; i < FeedEntriesAmount; ++i)
+	{
+		stream << QStringLiteral("<item>\n<title>Entry %1</title>\n<link>https://www.example.com/entries/%1</link>\n<guid>https://www.example.com/entries/%1</guid>\n<pubDate>Mon, 01 Jan 2018 00:00:00 +0000</pubDate>\n<author>author%2@example.com (Author %2)</author>\n<category>Category %3</category>\n<description>&lt;p&gt;Content of entry %1 with some &lt;b&gt;markup&lt;/b&gt; inside.&lt;/p&gt;</description>\n</item>\n").arg(i).arg(i % 50).arg(i % 20);
+	}
+
+	stream << QLatin1String("</channel>\n</rss>\n");
+	stream.flush();
+
+	return data;
+}
+
+SessionInformation CoreBenchmarks::createSession(const QString &path)
+{
+	SessionMainWindow mainWindow;
+	mainWindow.index = 0;
+	mainWindow.windows.reserve(SessionTabsAmount);
+
+	for (int i = 0; i < SessionTabsAmount; ++i)
+	{
+		SessionWindow window;
+		window.historyIndex = 2;
+		window.isPinned = (i < 5);
+
+		for (int j = 0; j < 3; ++j)
+		{
+			WindowHistoryEntry entry;
+			entry.url = QStringLiteral("https://www.site%1.com/pages/%2.html").arg(i).arg(j);
+			entry.title = QStringLiteral("Page %1 of site %2").arg(j).arg(i);
+			entry.time = QDateTime(QDate(2018, 1, 1), QTime(0, 0), Qt::UTC).addSecs((i * 3) + j);
+			entry.position = QPoint(0, (j * 100));
+
+			window.history.append(entry);
+		}
+
+		mainWindow.windows.append(window);
+	}
+
+	SessionInformation session;
+	session.path = path;
+	session.title = QLatin1String("Benchmark");
+	session.index = 0;
+	session.windows = {mainWindow};
+
+	return session;
+}
+
+void CoreBenchmarks::benchmarkContentFiltersLoading()
+{
+	AdblockContentFiltersProfile profile(QLatin1String("benchmark"), QLatin1String("Benchmark"), {}, {}, {}, 0, ContentFiltersProfile::OtherCategory, ContentFiltersProfile::NoFlags);
+	const QUrl url(QLatin1String("https://www.example.com/"));
+
+	QBENCHMARK
+	{
+		profile.clear();
+		profile.checkUrl(url, url, NetworkManager::MainFrameType);
+	}
+}
+
+void CoreBenchmarks::benchmarkContentFiltersCheckUrl()
+{
+	AdblockContentFiltersProfile profile(QLatin1String("benchmark"), QLatin1String("Benchmark"), {}, {}, {}, 0, ContentFiltersProfile::OtherCategory, ContentFiltersProfile::NoFlags);
+	profile.checkUrl(QUrl(QLatin1String("https://www.example.com/")), QUrl(QLatin1String("https://www.example.com/")), NetworkManager::MainFrameType);
+
+	int blockedAmount(0);
+
+	QBENCHMARK
+	{
+		blockedAmount = 0;
+
+		for (int i = 0; i < m_urls.count(); ++i)
+		{
+			if (profile.checkUrl(m_urls.at(i).baseUrl, m_urls.at(i).requestUrl, m_urls.at(i).resourceType).isBlocked)
+			{
+				++blockedAmount;
+			}
+		}
+	}
+
+	if (m_expectedBlockedAmount >= 0)
+	{
+		QCOMPARE(blockedAmount, m_expectedBlockedAmount);
+	}
+}
+
+void CoreBenchmarks::benchmarkHistoryFindEntries_data()
+{
+	QTest::addColumn<QString>("prefix");
+
+	QTest::newRow("broad") << QStringLiteral("site12");
+	QTest::newRow("narrow") << QStringLiteral("www.site12345.com/");
+	QTest::newRow("none") << QStringLiteral("nonexistent");
+}
+
+void CoreBenchmarks::benchmarkHistoryFindEntries()
+{
+	QFETCH(QString, prefix);
+
+	HistoryModel model(SessionsManager::getWritableDataPath(QLatin1String("browsingHistory.json")), HistoryModel::BrowsingHistory);
+	const QDateTime dateTime(QDate(2018, 1, 1), QTime(0, 0), Qt::UTC);
+
+	for (int i = 0; i < HistoryEntriesAmount; ++i)
+	{
+		model.addEntry(QUrl(QStringLiteral("https://www.site%1.com/pages/%2.html").arg(i).arg(i % 10)), QStringLiteral("Page %1").arg(i), {}, dateTime.addSecs(i));
+	}
+
+	QBENCHMARK
+	{
+		model.findEntries(prefix);
+	}
+}
+
+void CoreBenchmarks::benchmarkBookmarksFindBookmarks_data()
+{
+	QTest::addColumn<QString>("prefix");
+
+	QTest::newRow("broad") << QStringLiteral("k12");
+	QTest::newRow("narrow") << QStringLiteral("www.site12345.com/");
+	QTest::newRow("none") << QStringLiteral("nonexistent");
+}
+
+void CoreBenchmarks::benchmarkBookmarksFindBookmarks()
+{
+	QFETCH(QString, prefix);
+
+	BookmarksModel model(SessionsManager::getWritableDataPath(QLatin1String("bookmarks.xbel")), BookmarksModel::BookmarksMode);
+	const QDateTime dateTime(QDate(2018, 1, 1), QTime(0, 0), Qt::UTC);
+
+	for (int i = 0; i < BookmarksAmount; ++i)
+	{
+		QMap<int, QVariant> metaData({{BookmarksModel::TitleRole, QStringLiteral("Bookmark %1").arg(i)}, {BookmarksModel::UrlRole, QUrl(QStringLiteral("https://www.site%1.com/").arg(i))}, {BookmarksModel::TimeAddedRole, dateTime}, {BookmarksModel::TimeModifiedRole, dateTime}, {BookmarksModel::TimeVisitedRole, dateTime.addSecs(i)}});
+
+		if (i % 10 == 0)
+		{
+			metaData[BookmarksModel::KeywordRole] = QStringLiteral("k%1").arg(i);
+		}
+
+		model.addBookmark(BookmarksModel::UrlBookmark, metaData, model.getRootItem());
+	}
+
+	QBENCHMARK
+	{
+		model.findBookmarks(prefix);
+	}
+}
+
+void CoreBenchmarks::benchmarkSettingsGetOption_data()
+{
+	QTest::addColumn<QString>("host");
+
+	QTest::newRow("global") << QString();
+	QTest::newRow("host with override") << QStringLiteral("www.override.com");
+	QTest::newRow("host without override") << QStringLiteral("www.example.com");
+}
+
+void CoreBenchmarks::benchmarkSettingsGetOption()
+{
+	QFETCH(QString, host);
+
+	for (int i = 0; i < 100; ++i)
+	{
+		SettingsManager::setOption(SettingsManager::Content_DefaultZoomOption, 110, QStringLiteral("www.override%1.com").arg(i));
+	}
+
+	SettingsManager::setOption(SettingsManager::Content_DefaultZoomOption, 120, QLatin1String("www.override.com"));
+	SettingsManager::setOption(SettingsManager::Permissions_EnableJavaScriptOption, false, QLatin1String("www.override.com"));
+
+	QBENCHMARK
+	{
+		SettingsManager::getOption(SettingsManager::Content_DefaultZoomOption, host);
+		SettingsManager::getOption(SettingsManager::Network_UserAgentOption, host);
+		SettingsManager::getOption(SettingsManager::Permissions_EnableJavaScriptOption, host);
+	}
+}
+
+void CoreBenchmarks::benchmarkSessionSave()
+{
+	const SessionInformation session(createSession(SessionsManager::getSessionPath(QLatin1String("benchmark"))));
+
+	QBENCHMARK
+	{
+		QVERIFY(SessionsManager::saveSession(session));
+	}
+}
+
+void CoreBenchmarks::benchmarkSessionLoad()
+{
+	const QString path(SessionsManager::getSessionPath(QLatin1String("benchmark")));
+
+	QVERIFY(SessionsManager::saveSession(createSession(path)));
+
+	QBENCHMARK
+	{
+		const SessionInformation session(SessionsManager::getSession(path));
+
+		QCOMPARE(session.windows.value(0).windows.count(), static_cast<int>(SessionTabsAmount));
+	}
+}
+
+void CoreBenchmarks::benchmarkFeedParser_data()
+{
+	QTest::addColumn<int>("type");
+	QTest::addColumn<QByteArray>("data");
+
+	QTest::newRow("atom") << static_cast<int>(FeedParser::AtomParser) << createAtomFeed();
+	QTest::newRow("rss") << static_cast<int>(FeedParser::RssParser) << createRssFeed();
+}
+
+void CoreBenchmarks::benchmarkFeedParser()
+{
+	QFETCH(int, type);
+	QFETCH(QByteArray, data);
+
+	QBENCHMARK
+	{
+		if (type == FeedParser::AtomParser)
+		{
+			AtomFeedParser parser;
+
+			QVERIFY(parser.parse(data));
+			QCOMPARE(parser.getInformation().entries.count(), static_cast<int>(FeedEntriesAmount));
+		}
+		else
+		{
+			RssFeedParser parser;
+
+			QVERIFY(parser.parse(data));
+			QCOMPARE(parser.getInformation().entries.count(), static_cast<int>(FeedEntriesAmount));
+		}
+	}
+}
+
+}
+
+int main(int argc, char *argv[])
+{
+	if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+	{
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+	}
+
+	QApplication application(argc, argv);
+	application.setApplicationName(QLatin1String("otter-benchmarks"));
+
+	Otter::CoreBenchmarks benchmarks;
+
+	return QTest::qExec(&benchmarks, argc, argv);
+}
+
+#include "CoreBenchmarks.moc"